@@ -0,0 +1,249 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace coco {
+
+/// @brief Fixed size set of bits, e.g. for resource allocators (DMA channels, USB endpoint buffers, flash pages). The
+/// operations work on whole words using std::countr_zero (CLZ on Cortex-M) and std::popcount, all methods are
+/// constexpr.
+///
+/// Use like this:
+/// Bitset<64> free;
+/// free.setRange(0, 64);
+/// int page = free.findFirstSet(); // -1 if none is free
+/// free.clear(page);
+///
+/// @tparam N number of bits
+template <int N>
+class Bitset {
+    static_assert(N > 0, "Bitset: size must be positive");
+public:
+    // word type, uses the native word size
+    using Word = std::conditional_t<sizeof(void *) >= 8, uint64_t, uint32_t>;
+    static constexpr int WORD_BITS = sizeof(Word) * 8;
+    static constexpr int WORD_COUNT = (N + WORD_BITS - 1) / WORD_BITS;
+
+    /// @brief Construct with all bits cleared
+    ///
+    constexpr Bitset() = default;
+
+    /// @brief Get the number of bits
+    ///
+    static constexpr int size() {return N;}
+
+    constexpr bool get(int index) const {
+        return (this->words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+
+    constexpr bool operator [](int index) const {return get(index);}
+
+    constexpr void set(int index) {
+        this->words[index / WORD_BITS] |= Word(1) << (index % WORD_BITS);
+    }
+
+    constexpr void set(int index, bool value) {
+        if (value)
+            set(index);
+        else
+            clear(index);
+    }
+
+    constexpr void clear(int index) {
+        this->words[index / WORD_BITS] &= ~(Word(1) << (index % WORD_BITS));
+    }
+
+    constexpr void flip(int index) {
+        this->words[index / WORD_BITS] ^= Word(1) << (index % WORD_BITS);
+    }
+
+    /// @brief Set a range of bits
+    /// @param begin index of first bit
+    /// @param end index after the last bit
+    constexpr void setRange(int begin, int end) {
+        forRange(begin, end, [](Word &word, Word mask) {word |= mask;});
+    }
+
+    /// @brief Clear a range of bits
+    /// @param begin index of first bit
+    /// @param end index after the last bit
+    constexpr void clearRange(int begin, int end) {
+        forRange(begin, end, [](Word &word, Word mask) {word &= ~mask;});
+    }
+
+    constexpr void setAll() {setRange(0, N);}
+
+    constexpr void clearAll() {
+        for (auto &word : this->words)
+            word = 0;
+    }
+
+    /// @brief Count the number of set bits
+    ///
+    constexpr int count() const {
+        int count = 0;
+        for (auto word : this->words)
+            count += std::popcount(word);
+        return count;
+    }
+
+    constexpr bool any() const {
+        for (auto word : this->words) {
+            if (word != 0)
+                return true;
+        }
+        return false;
+    }
+
+    constexpr bool none() const {return !any();}
+
+    constexpr bool all() const {return findFirstClear() == -1;}
+
+    /// @brief Find the first set bit
+    /// @return index of the first set bit or -1 if no bit is set
+    constexpr int findFirstSet() const {
+        return findNextSet(0);
+    }
+
+    /// @brief Find the next set bit, e.g. for (int i = b.findFirstSet(); i != -1; i = b.findNextSet(i + 1))
+    /// @param index index where to start searching
+    /// @return index of the first set bit at or after index or -1 if there is none
+    constexpr int findNextSet(int index) const {
+        return findNext(index, 0);
+    }
+
+    /// @brief Find the first cleared bit
+    /// @return index of the first cleared bit or -1 if all bits are set
+    constexpr int findFirstClear() const {
+        return findNextClear(0);
+    }
+
+    /// @brief Find the next cleared bit
+    /// @param index index where to start searching
+    /// @return index of the first cleared bit at or after index or -1 if there is none
+    constexpr int findNextClear(int index) const {
+        return findNext(index, ~Word(0));
+    }
+
+    /// @brief Count the set bits before a given bit (rank)
+    /// @param index index of the bit, can be N to count all bits
+    /// @return number of set bits before index
+    constexpr int rank(int index) const {
+        int count = 0;
+        int w = index / WORD_BITS;
+        for (int i = 0; i < w; ++i)
+            count += std::popcount(this->words[i]);
+        int bit = index % WORD_BITS;
+        if (bit != 0)
+            count += std::popcount(this->words[w] & ((Word(1) << bit) - 1));
+        return count;
+    }
+
+    /// @brief Find the n-th set bit (select), inverse of rank()
+    /// @param n number of set bits to skip
+    /// @return index of the n-th set bit or -1 if there are not enough set bits
+    constexpr int select(int n) const {
+        for (int i = 0; i < WORD_COUNT; ++i) {
+            Word word = this->words[i];
+            int c = std::popcount(word);
+            if (n < c) {
+                // clear the n lowest set bits
+                for (; n > 0; --n)
+                    word &= word - 1;
+                return i * WORD_BITS + std::countr_zero(word);
+            }
+            n -= c;
+        }
+        return -1;
+    }
+
+    constexpr Bitset &operator &=(const Bitset &b) {
+        for (int i = 0; i < WORD_COUNT; ++i)
+            this->words[i] &= b.words[i];
+        return *this;
+    }
+
+    constexpr Bitset &operator |=(const Bitset &b) {
+        for (int i = 0; i < WORD_COUNT; ++i)
+            this->words[i] |= b.words[i];
+        return *this;
+    }
+
+    constexpr Bitset &operator ^=(const Bitset &b) {
+        for (int i = 0; i < WORD_COUNT; ++i)
+            this->words[i] ^= b.words[i];
+        return *this;
+    }
+
+    constexpr Bitset operator ~() const {
+        Bitset b;
+        for (int i = 0; i < WORD_COUNT; ++i)
+            b.words[i] = ~this->words[i];
+        b.words[WORD_COUNT - 1] &= LAST_MASK;
+        return b;
+    }
+
+    friend constexpr Bitset operator &(Bitset a, const Bitset &b) {return a &= b;}
+    friend constexpr Bitset operator |(Bitset a, const Bitset &b) {return a |= b;}
+    friend constexpr Bitset operator ^(Bitset a, const Bitset &b) {return a ^= b;}
+
+    friend constexpr bool operator ==(const Bitset &a, const Bitset &b) {
+        for (int i = 0; i < WORD_COUNT; ++i) {
+            if (a.words[i] != b.words[i])
+                return false;
+        }
+        return true;
+    }
+
+    /// @brief Access the words, e.g. to copy to or from hardware registers
+    ///
+    constexpr Word *data() {return this->words;}
+    constexpr const Word *data() const {return this->words;}
+
+protected:
+    // valid bits of the last word
+    static constexpr Word LAST_MASK = N % WORD_BITS == 0 ? ~Word(0) : (Word(1) << (N % WORD_BITS)) - 1;
+
+    // call a function for each word in a range with a mask of the bits in the range
+    template <typename F>
+    constexpr void forRange(int begin, int end, F function) {
+        if (begin >= end)
+            return;
+        int first = begin / WORD_BITS;
+        int last = (end - 1) / WORD_BITS;
+        Word firstMask = ~Word(0) << (begin % WORD_BITS);
+        Word lastMask = ~Word(0) >> (WORD_BITS - 1 - (end - 1) % WORD_BITS);
+        if (first == last) {
+            function(this->words[first], firstMask & lastMask);
+            return;
+        }
+        function(this->words[first], firstMask);
+        for (int i = first + 1; i < last; ++i)
+            function(this->words[i], ~Word(0));
+        function(this->words[last], lastMask);
+    }
+
+    // find the next bit that differs from invert (0 to find set bits, all ones to find cleared bits)
+    constexpr int findNext(int index, Word invert) const {
+        if (index >= N)
+            return -1;
+        int i = index / WORD_BITS;
+        Word word = (this->words[i] ^ invert) & (~Word(0) << (index % WORD_BITS));
+        while (true) {
+            if (i == WORD_COUNT - 1)
+                word &= LAST_MASK;
+            if (word != 0)
+                return i * WORD_BITS + std::countr_zero(word);
+            if (++i == WORD_COUNT)
+                return -1;
+            word = this->words[i] ^ invert;
+        }
+    }
+
+    Word words[WORD_COUNT] = {};
+};
+
+} // namespace coco
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IsSubclass.hpp"
+#include "KeyedTask.hpp"
+#include "MonotonicArena.hpp"
 #include "Task.hpp"
 #include "TimedTask.hpp"
 
@@ -25,6 +27,10 @@ namespace coco {
 
 using CoroutineTask = Task<std::coroutine_handle<>>;
 using CoroutineTimedTask = TimedTask<std::coroutine_handle<>>;
+template <typename K>
+using CoroutineKeyedTask = KeyedTask<std::coroutine_handle<>, K>;
+template <typename K, typename P>
+using CoroutineKeyedTaskWithParameters = KeyedTaskWithParameters<std::coroutine_handle<>, K, P>;
 
 
 template <typename P, int>
@@ -38,9 +44,24 @@ struct CoroutineTaskSelector<T, 1> {
     using Task = T;
 };
 
+template <typename T, int>
+struct CoroutineTaskListSelector {
+    using List = TaskList<T>;
+};
+
+// specialization for T being derived from IntrusiveTreeNode (e.g. CoroutineKeyedTask)
+template <typename T>
+struct CoroutineTaskListSelector<T, 1> {
+    using List = KeyedTaskList<T>;
+};
+
 template <typename T = CoroutineTask>
-using CoroutineTaskList = TaskList<typename CoroutineTaskSelector<T, IsSubclass<T, CoroutineTask>::value>::Task>;
+using CoroutineTaskList = typename CoroutineTaskListSelector<
+    typename CoroutineTaskSelector<T, IsSubclass<T, CoroutineTask>::value>::Task,
+    IsSubclass<T, IntrusiveTreeNode>::value>::List;
 using CoroutineTimedTaskList = TimedTaskList<std::coroutine_handle<>>;
+template <typename K>
+using CoroutineKeyedTaskList = KeyedTaskList<CoroutineKeyedTask<K>>;
 
 
 
@@ -112,6 +133,8 @@ struct Awaitable {
 #endif
         // set the coroutine handle
         this->task.task = handle;
+        if (handle)
+            trace::suspend(handle.address());
     }
 
     /**
@@ -142,9 +165,10 @@ struct Awaitable {
 
 
     /**
-        An awaitable function or method can also be a coroutine, therefore define a promise_type
+        An awaitable function or method can also be a coroutine, therefore define a promise_type. The frame gets
+        allocated from a MonotonicArena if one is passed as parameter
     */
-    struct promise_type {
+    struct promise_type : public ArenaPromise {
         // the task list is part of the coroutine promise
         TaskList<T> list;
 
@@ -161,6 +185,11 @@ struct Awaitable {
             return {this->list, handle};
         }
 
+        // the frame could not be allocated from the arena, return an awaitable that is already finished
+        static Awaitable get_return_object_on_allocation_failure() noexcept {
+            return {};
+        }
+
         std::suspend_never initial_suspend() noexcept {
             return {};
         }
@@ -264,13 +293,15 @@ using AwaitableCoroutine = Awaitable<AwaitableCoroutineTask>;
 ///     c.destroy();
 /// }
 struct Coroutine {
-    struct promise_type {
+    // the frame gets allocated from a MonotonicArena if one is passed as parameter
+    struct promise_type : public ArenaPromise {
         Coroutine get_return_object() noexcept {
 #ifdef COROUTINE_DEBUG_PRINT
             std::cout << "Coroutine get_return_object" << std::endl;
 #endif
             return {std::coroutine_handle<promise_type>::from_promise(*this)};
         }
+        static Coroutine get_return_object_on_allocation_failure() noexcept {return {};}
         std::suspend_never initial_suspend() noexcept {
 #ifdef COROUTINE_DEBUG_PRINT
             std::cout << "Coroutine initial_suspend" << std::endl;
@@ -499,6 +530,8 @@ template <typename A1, typename A2, typename A3, typename A4, typename A5>
 
 /// @brief Simple barrier on which a data consumer coroutine can wait until it gets resumed by a data producer.
 /// If a resume method gets called by a data producer while no consumer is waiting, the event/data gets lost.
+/// When T is a keyed task (e.g. CoroutineKeyedTask<int>), the first argument of untilResumed() is the key and
+/// doFirst(key) or doAll(key) only visit the consumers waiting for this key.
 /// @tparam T task type
 template <typename T = CoroutineTask>
 class Barrier : public CoroutineTaskList<T> {
@@ -0,0 +1,435 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace coco {
+
+/// @brief Node of a balanced binary search tree (AVL tree) for tree elements to be inherited from,
+/// e.g. class Foo : public IntrusiveTreeNode {};
+/// A node can remove itself from the tree without knowing the tree, therefore the root of the tree is the left child of
+/// a header node (the tree itself) which is the only node in the "chain" of parents that has no parent.
+class IntrusiveTreeNode {
+public:
+    /// @brief Construct a node that is "not in tree" or an empty tree (header node)
+    ///
+    IntrusiveTreeNode() noexcept : parent(nullptr), left(nullptr), right(nullptr), balance(0) {}
+
+    /// @brief Delete copy constructor
+    ///
+    IntrusiveTreeNode(IntrusiveTreeNode const &) = delete;
+
+    /// @brief Move constructor replaces the given node in the tree
+    ///
+    IntrusiveTreeNode(IntrusiveTreeNode &&node) noexcept : parent(nullptr), left(nullptr), right(nullptr), balance(0) {
+        if (node.inTree())
+            replace(node);
+    }
+
+    /// @brief Destructor removes the node from the tree
+    ///
+    ~IntrusiveTreeNode() {
+        removeFromTree();
+    }
+
+    /// @brief Move assignment removes itself and then replaces the given node in the tree
+    ///
+    IntrusiveTreeNode &operator =(IntrusiveTreeNode &&node) noexcept {
+        removeFromTree();
+        if (node.inTree())
+            replace(node);
+        return *this;
+    }
+
+    /// @brief Return true if the node is part of a tree
+    ///
+    bool inTree() const {
+        return this->parent != nullptr;
+    }
+
+    /// @brief Remove this node from the tree and rebalance the tree, which is O(log n)
+    ///
+    void removeFromTree() noexcept {
+        if (this->parent == nullptr)
+            return;
+
+        auto p = this->parent;
+        auto l = this->left;
+        auto r = this->right;
+        if (l != nullptr && r != nullptr) {
+            // two children: the successor (leftmost node of right subtree) takes the place of this node
+            auto s = r;
+            while (s->left != nullptr)
+                s = s->left;
+
+            IntrusiveTreeNode *x;
+            bool fromLeft;
+            if (s == r) {
+                // successor is the right child: its right subtree moves up by one level
+                x = s;
+                fromLeft = false;
+            } else {
+                // unlink successor from its parent
+                x = s->parent;
+                fromLeft = true;
+                x->left = s->right;
+                if (s->right != nullptr)
+                    s->right->parent = x;
+                s->right = r;
+                r->parent = s;
+            }
+            s->left = l;
+            l->parent = s;
+            s->balance = this->balance;
+            s->parent = p;
+            replaceChild(p, this, s);
+            retraceRemove(x, fromLeft);
+        } else {
+            // zero or one child: replace by child
+            auto c = l != nullptr ? l : r;
+            bool fromLeft = p->left == this;
+            replaceChild(p, this, c);
+            if (c != nullptr)
+                c->parent = p;
+            retraceRemove(p, fromLeft);
+        }
+
+        // set to "not in tree"
+        this->parent = nullptr;
+        this->left = nullptr;
+        this->right = nullptr;
+        this->balance = 0;
+    }
+
+    /// @brief Get the in-order successor of this node
+    /// @return successor or the header node if this node is the last node
+    IntrusiveTreeNode *successor() const {
+        if (this->right != nullptr) {
+            auto node = this->right;
+            while (node->left != nullptr)
+                node = node->left;
+            return node;
+        }
+        auto node = this;
+        auto p = node->parent;
+        while (p->parent != nullptr && p->right == node) {
+            node = p;
+            p = p->parent;
+        }
+        return p;
+    }
+
+    /// @brief Link this node as child of a parent node and rebalance the tree, mainly for internal use
+    /// @param parent parent node, the header node if the tree is empty
+    /// @param left true to link as left child, false to link as right child
+    void link(IntrusiveTreeNode *parent, bool left) noexcept {
+        assert(!inTree());
+        this->parent = parent;
+        if (left)
+            parent->left = this;
+        else
+            parent->right = this;
+        retraceInsert(this);
+    }
+
+    /// @brief Take the place of a node in the tree, the given node is "not in tree" afterwards, mainly for internal use
+    /// @param node node to replace, must be in a tree
+    void replace(IntrusiveTreeNode &node) noexcept {
+        assert(!inTree() && node.inTree());
+        this->parent = node.parent;
+        this->left = node.left;
+        this->right = node.right;
+        this->balance = node.balance;
+        replaceChild(this->parent, &node, this);
+        if (this->left != nullptr)
+            this->left->parent = this;
+        if (this->right != nullptr)
+            this->right->parent = this;
+
+        node.parent = nullptr;
+        node.left = nullptr;
+        node.right = nullptr;
+        node.balance = 0;
+    }
+
+    IntrusiveTreeNode *parent;
+    IntrusiveTreeNode *left;
+    IntrusiveTreeNode *right;
+
+    // height of right subtree minus height of left subtree (-1, 0 or 1)
+    int8_t balance;
+
+protected:
+    static void replaceChild(IntrusiveTreeNode *parent, IntrusiveTreeNode *child, IntrusiveTreeNode *node) {
+        if (parent->left == child)
+            parent->left = node;
+        else
+            parent->right = node;
+    }
+
+    // rotate left around x where z is the right child of x, return new subtree root
+    static IntrusiveTreeNode *rotateLeft(IntrusiveTreeNode *x, IntrusiveTreeNode *z) {
+        auto t = z->left;
+        x->right = t;
+        if (t != nullptr)
+            t->parent = x;
+        z->left = x;
+        x->parent = z;
+        if (z->balance == 0) {
+            // only happens on removal
+            x->balance = 1;
+            z->balance = -1;
+        } else {
+            x->balance = 0;
+            z->balance = 0;
+        }
+        return z;
+    }
+
+    // rotate right around x where z is the left child of x, return new subtree root
+    static IntrusiveTreeNode *rotateRight(IntrusiveTreeNode *x, IntrusiveTreeNode *z) {
+        auto t = z->right;
+        x->left = t;
+        if (t != nullptr)
+            t->parent = x;
+        z->right = x;
+        x->parent = z;
+        if (z->balance == 0) {
+            // only happens on removal
+            x->balance = -1;
+            z->balance = 1;
+        } else {
+            x->balance = 0;
+            z->balance = 0;
+        }
+        return z;
+    }
+
+    // rotate right around z and then left around x where z is the right child of x, return new subtree root
+    static IntrusiveTreeNode *rotateRightLeft(IntrusiveTreeNode *x, IntrusiveTreeNode *z) {
+        auto y = z->left;
+        auto t3 = y->right;
+        z->left = t3;
+        if (t3 != nullptr)
+            t3->parent = z;
+        y->right = z;
+        z->parent = y;
+        auto t2 = y->left;
+        x->right = t2;
+        if (t2 != nullptr)
+            t2->parent = x;
+        y->left = x;
+        x->parent = y;
+        x->balance = y->balance > 0 ? -1 : 0;
+        z->balance = y->balance < 0 ? 1 : 0;
+        y->balance = 0;
+        return y;
+    }
+
+    // rotate left around z and then right around x where z is the left child of x, return new subtree root
+    static IntrusiveTreeNode *rotateLeftRight(IntrusiveTreeNode *x, IntrusiveTreeNode *z) {
+        auto y = z->right;
+        auto t2 = y->left;
+        z->right = t2;
+        if (t2 != nullptr)
+            t2->parent = z;
+        y->left = z;
+        z->parent = y;
+        auto t3 = y->right;
+        x->left = t3;
+        if (t3 != nullptr)
+            t3->parent = x;
+        y->right = x;
+        x->parent = y;
+        x->balance = y->balance < 0 ? 1 : 0;
+        z->balance = y->balance > 0 ? -1 : 0;
+        y->balance = 0;
+        return y;
+    }
+
+    // update balance factors from a newly linked node up to the header
+    static void retraceInsert(IntrusiveTreeNode *z) {
+        for (auto x = z->parent; x->parent != nullptr; x = z->parent) {
+            auto g = x->parent;
+            IntrusiveTreeNode *n;
+            if (z == x->right) {
+                // right subtree has grown
+                if (x->balance > 0) {
+                    n = z->balance < 0 ? rotateRightLeft(x, z) : rotateLeft(x, z);
+                } else {
+                    if (x->balance < 0) {
+                        // height of x does not change
+                        x->balance = 0;
+                        return;
+                    }
+                    x->balance = 1;
+                    z = x;
+                    continue;
+                }
+            } else {
+                // left subtree has grown
+                if (x->balance < 0) {
+                    n = z->balance > 0 ? rotateLeftRight(x, z) : rotateRight(x, z);
+                } else {
+                    if (x->balance > 0) {
+                        // height of x does not change
+                        x->balance = 0;
+                        return;
+                    }
+                    x->balance = -1;
+                    z = x;
+                    continue;
+                }
+            }
+
+            // link rotated subtree to parent, height of subtree is the same as before insertion
+            n->parent = g;
+            replaceChild(g, x, n);
+            return;
+        }
+    }
+
+    // update balance factors from the parent of a removed node up to the header
+    static void retraceRemove(IntrusiveTreeNode *x, bool fromLeft) {
+        while (x->parent != nullptr) {
+            auto g = x->parent;
+            bool xLeft = g->left == x;
+            IntrusiveTreeNode *n;
+            int b;
+            if (fromLeft) {
+                // left subtree has shrunk
+                if (x->balance > 0) {
+                    auto z = x->right;
+                    b = z->balance;
+                    n = b < 0 ? rotateRightLeft(x, z) : rotateLeft(x, z);
+                } else {
+                    if (x->balance == 0) {
+                        // height of x does not change
+                        x->balance = 1;
+                        return;
+                    }
+                    x->balance = 0;
+                    x = g;
+                    fromLeft = xLeft;
+                    continue;
+                }
+            } else {
+                // right subtree has shrunk
+                if (x->balance < 0) {
+                    auto z = x->left;
+                    b = z->balance;
+                    n = b > 0 ? rotateLeftRight(x, z) : rotateRight(x, z);
+                } else {
+                    if (x->balance == 0) {
+                        // height of x does not change
+                        x->balance = -1;
+                        return;
+                    }
+                    x->balance = 0;
+                    x = g;
+                    fromLeft = xLeft;
+                    continue;
+                }
+            }
+
+            // link rotated subtree to parent
+            n->parent = g;
+            if (xLeft)
+                g->left = n;
+            else
+                g->right = n;
+
+            // height of subtree did not change
+            if (b == 0)
+                return;
+            x = g;
+            fromLeft = xLeft;
+        }
+    }
+};
+
+
+/// @brief Intrusive balanced binary search tree. Elements with equal keys are allowed and keep their insertion order.
+/// @tparam T tree element type that inherits IntrusiveTreeNode and has a member named key that supports operator <,
+/// e.g class Element : public IntrusiveTreeNode {int key;};
+template <typename T>
+class IntrusiveTree : public IntrusiveTreeNode {
+public:
+    using Node = IntrusiveTreeNode;
+
+    /// @brief Return true if the tree is empty
+    ///
+    bool empty() const {
+        return this->left == nullptr;
+    }
+
+    /// @brief Count the number of elements in the tree which is O(n)
+    /// @return number of elements
+    int count() const {
+        int count = 0;
+        for (auto node = first(); node != this; node = node->successor())
+            ++count;
+        return count;
+    }
+
+    /// @brief Add an element to the tree which is O(log n). Must not already be in a tree
+    /// @param element element to add
+    void add(T &element) {
+        Node *parent = this;
+        Node *node = this->left;
+        bool left = true;
+        while (node != nullptr) {
+            parent = node;
+            left = element.key < static_cast<T &>(*node).key;
+            node = left ? node->left : node->right;
+        }
+        static_cast<Node &>(element).link(parent, left);
+    }
+
+    /// @brief Find the first element with the given key which is O(log n)
+    /// @param key key to search
+    /// @return element or nullptr if no element with the key is in the tree
+    template <typename K>
+    T *find(const K &key) {
+        Node *node = this->left;
+        Node *found = nullptr;
+        while (node != nullptr) {
+            auto &element = static_cast<T &>(*node);
+            if (element.key < key) {
+                node = node->right;
+            } else {
+                if (!(key < element.key))
+                    found = node;
+                node = node->left;
+            }
+        }
+        return found == nullptr ? nullptr : &static_cast<T &>(*found);
+    }
+
+    /// @brief Iterator (in-order traversal). Do not remove an element that an iterator points to
+    ///
+    struct Iterator {
+        Node *node;
+        T &operator *() {return static_cast<T &>(*this->node);}
+        T *operator ->() {return &static_cast<T &>(*this->node);}
+        Iterator &operator ++() {this->node = this->node->successor(); return *this;}
+        bool operator ==(Iterator it) const {return this->node == it.node;}
+        bool operator !=(Iterator it) const {return this->node != it.node;}
+    };
+
+    Iterator begin() {return {first()};}
+    Iterator end() {return {this};}
+
+protected:
+    Node *first() const {
+        auto node = this->left;
+        if (node == nullptr)
+            return const_cast<IntrusiveTree *>(this);
+        while (node->left != nullptr)
+            node = node->left;
+        return node;
+    }
+};
+
+} // namespace coco
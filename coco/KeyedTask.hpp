@@ -0,0 +1,296 @@
+#pragma once
+
+#include "IntrusiveTree.hpp"
+#include "Task.hpp"
+#include <cassert>
+#include <utility>
+
+
+namespace coco {
+
+/// @brief Task with a key, e.g. the address of an I2C device or the ID of a CAN frame.
+/// The first waiting task of each key is a node in the tree of a KeyedTaskList, further tasks with the same key are
+/// linked to the first task using the list node of Task.
+/// @tparam F task function, e.g. Callback, std::coroutine_handle<> or std::function
+/// @tparam K key type, must support operator <
+template <typename F, typename K>
+class KeyedTask : public Task<F>, public IntrusiveTreeNode {
+public:
+    using Key = K;
+
+    KeyedTask(const F &task) : Task<F>(task), key() {}
+    KeyedTask(const F &task, const K &key) : Task<F>(task), key(key) {}
+
+    /// @brief Move constructor replaces the given task in the list and in the tree
+    ///
+    KeyedTask(KeyedTask &&task) noexcept
+        : Task<F>(std::move(task)), IntrusiveTreeNode(std::move(task)), key(std::move(task.key)) {}
+
+    /// @brief Destructor removes the task from the list and the tree
+    ///
+    ~KeyedTask() {
+        remove();
+    }
+
+    /// @brief Move assignment removes itself and then replaces the given task in the list and in the tree
+    ///
+    KeyedTask &operator =(KeyedTask &&task) noexcept {
+        remove();
+        Task<F>::operator =(std::move(task));
+        IntrusiveTreeNode::operator =(std::move(task));
+        this->key = std::move(task.key);
+        return *this;
+    }
+
+    /// @brief Return true if the task is waiting in a KeyedTaskList
+    ///
+    bool inList() const {
+        return IntrusiveListNode::inList() || inTree();
+    }
+
+    /// @brief Remove the task from the KeyedTaskList, the next task with equal key takes its place in the tree
+    ///
+    void remove() noexcept {
+        if (inTree()) {
+            if (this->next != this) {
+                // the next task with equal key takes the place in the tree
+                static_cast<KeyedTask &>(*this->next).replace(*this);
+            } else {
+                removeFromTree();
+            }
+        }
+        IntrusiveListNode::remove();
+    }
+
+    void cancel() noexcept {remove();}
+
+    K key;
+};
+
+/// @brief Task with key and parameters (mainly for parameters of awaitable functions/methods)
+/// @tparam F task function
+/// @tparam K key type
+/// @tparam P parameters
+template <typename F, typename K, typename P>
+class KeyedTaskWithParameters : public KeyedTask<F, K> {
+public:
+    template <typename ...Args>
+    explicit KeyedTaskWithParameters(const F &task, const K &key, Args &&...args)
+        : KeyedTask<F, K>(task, key), parameters{std::forward<Args>(args)...} {}
+
+    P parameters;
+};
+
+template <typename F, typename K, typename P>
+P &getParameters(KeyedTaskWithParameters<F, K, P> &task) {
+    return task.parameters;
+}
+
+
+
+/// @brief List of tasks (e.g. waiting coroutines) that are sorted by key in a balanced tree, so that only the tasks
+/// waiting for a given key get visited when resuming, which is O(log n + k) for k tasks with matching key
+/// @tparam T task type, must derive from KeyedTask
+template <typename T>
+class KeyedTaskList : public IntrusiveTree<T> {
+public:
+    using Task = T;
+    using Key = typename T::Key;
+
+    /// @brief Check if a task with given key is in the list
+    /// @param key key
+    /// @return true if at least one task waits for the key
+    bool contains(const Key &key) {
+        return this->find(key) != nullptr;
+    }
+
+    /// @brief Add a task. Must not already be in a list
+    /// @param task task to add
+    void add(Task &task) {
+        assert(!task.inList());
+        trace::add(task);
+
+        IntrusiveTreeNode *parent = this;
+        IntrusiveTreeNode *node = this->left;
+        bool left = true;
+        while (node != nullptr) {
+            auto &current = static_cast<Task &>(*node);
+            if (task.key < current.key) {
+                left = true;
+            } else if (current.key < task.key) {
+                left = false;
+            } else {
+                // append to the tasks with equal key
+                task.prev = current.prev;
+                task.next = &current;
+                current.prev->next = &task;
+                current.prev = &task;
+                return;
+            }
+            parent = node;
+            node = left ? node->left : node->right;
+        }
+
+        // first task with this key
+        static_cast<IntrusiveTreeNode &>(task).link(parent, left);
+    }
+
+    /// @brief Visit all tasks, ordered by key
+    /// @tparam V visitor type, e.g. a lambda function
+    /// @param visitor visitor
+    template <typename V>
+    void visitAll(const V &visitor) {
+        for (auto &first : *this) {
+            IntrusiveListNode *current = &first;
+            do {
+                auto next = current->next;
+                visitor(static_cast<Task &>(*current));
+                current = next;
+            } while (current != &first);
+        }
+    }
+
+    /// @brief Remove and execute the first task with the given key
+    /// @param key key
+    /// @return true when a task was executed, false when no task waits for the key
+    bool doFirst(const Key &key) {
+        auto first = this->find(key);
+        if (first != nullptr) {
+            // remove task from list
+            first->remove();
+
+            // execute task
+            trace::resume(*first);
+            first->task();
+            trace::end();
+
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Remove and execute the first task with the given key when its predicate is true
+    /// @param key key
+    /// @param predicate boolean predicate function that determines if the first task should be executed
+    /// @return true when a task was executed
+    template <typename P>
+    bool doFirst(const Key &key, const P &predicate) {
+        auto first = this->find(key);
+        if (first != nullptr && predicate(getParameters(*first))) {
+            // remove task from list
+            first->remove();
+
+            // execute task
+            trace::resume(*first);
+            first->task();
+            trace::end();
+
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Remove and execute all tasks with the given key that are in the list on entry of doAll()
+    /// @param key key
+    void doAll(const Key &key) {
+        auto first = this->find(key);
+        if (first == nullptr)
+            return;
+
+        // remove first task from tree, the other tasks with equal key stay linked to it
+        first->removeFromTree();
+
+        // temporary head for tasks to execute
+        IntrusiveListNode head(first, first->prev);
+        head.prev->next = &head;
+        first->prev = &head;
+
+        execute(head);
+    }
+
+    /// @brief Remove and execute all tasks with the given key that are in the list on entry of doAll() and for which
+    /// the predicate returns true
+    /// @param key key
+    /// @param predicate boolean predicate function that selects the tasks to execute
+    template <typename P>
+    void doAll(const Key &key, P const &predicate) {
+        auto first = this->find(key);
+        if (first == nullptr)
+            return;
+
+        // temporary head for tasks to execute
+        IntrusiveListNode head;
+
+        // check the tasks that are linked to the first task
+        IntrusiveListNode *next = first->next;
+        while (next != first) {
+            auto current = next;
+            next = next->next;
+
+            if (predicate(getParameters(static_cast<Task &>(*current)))) {
+                current->remove();
+
+                // add to temporary head
+                current->prev = head.prev;
+                current->next = &head;
+                head.prev->next = current;
+                head.prev = current;
+            }
+        }
+
+        // check the first task last as the next task with equal key takes its place in the tree when it gets removed
+        if (predicate(getParameters(*first))) {
+            first->remove();
+
+            // add at the front of temporary head
+            first->next = head.next;
+            first->prev = &head;
+            head.next->prev = first;
+            head.next = first;
+        }
+
+        execute(head);
+    }
+
+    /// @brief Remove and execute all tasks that are in the list on entry of doAll()
+    ///
+    void doAll() {
+        if (this->empty())
+            return;
+
+        // temporary head for tasks to execute
+        IntrusiveListNode head;
+
+        // move all tasks to the temporary head, ordered by key
+        while (!this->empty()) {
+            Task &first = *this->begin();
+            first.removeFromTree();
+
+            // append first task and the tasks with equal key
+            auto last = first.prev;
+            head.prev->next = &first;
+            first.prev = head.prev;
+            last->next = &head;
+            head.prev = last;
+        }
+
+        execute(head);
+    }
+
+protected:
+    static void execute(IntrusiveListNode &head) {
+        while (head.next != &head) {
+            auto &first = static_cast<Task &>(*head.next);
+
+            // remove task from list
+            first.remove();
+
+            // execute task
+            trace::resume(first);
+            first.task();
+            trace::end();
+        }
+    }
+};
+
+} // namespace coco
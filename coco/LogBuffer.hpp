@@ -0,0 +1,89 @@
+#pragma once
+
+#include "String.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+
+namespace coco {
+
+/// @brief Lock-free single producer single consumer byte ring buffer for log messages. The producer (a thread or an
+/// interrupt priority level) appends whole messages at the cost of a memcpy, the consumer (e.g. a background thread or
+/// low priority coroutine) writes the contents to the output in batches. Messages that do not fit are dropped and
+/// counted, so memory is bounded and the producer never blocks.
+/// @tparam N size of the buffer, must be a power of two
+template <int N>
+class LogBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "LogBuffer: size must be a power of two");
+public:
+    /// @brief Append a message (producer side). The message is dropped if there is not enough space
+    /// @param data message data
+    /// @param length message length
+    /// @return true if the message was appended, false if it was dropped
+    bool write(const char *data, int length) {
+        uint32_t head = this->head.load(std::memory_order_relaxed);
+        uint32_t tail = this->tail.load(std::memory_order_acquire);
+        if (uint32_t(length) > N - (head - tail)) {
+            // only the producer modifies the counter
+            this->dropped.store(this->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // copy in one part or two parts on wrap-around
+        int offset = head & (N - 1);
+        if (length <= N - offset) {
+            std::memcpy(this->buffer + offset, data, length);
+        } else {
+            int length1 = N - offset;
+            std::memcpy(this->buffer + offset, data, length1);
+            std::memcpy(this->buffer, data + length1, length - length1);
+        }
+        this->head.store(head + length, std::memory_order_release);
+        return true;
+    }
+
+    bool write(const String &message) {return write(message.data(), message.size());}
+
+    /// @brief Get the data that can be read in one piece (consumer side), call again after consume() to get the rest
+    /// after a wrap-around
+    /// @return contiguous data at the front of the buffer
+    String read() const {
+        uint32_t tail = this->tail.load(std::memory_order_relaxed);
+        uint32_t head = this->head.load(std::memory_order_acquire);
+        int offset = tail & (N - 1);
+        return {this->buffer + offset, std::min(int(head - tail), N - offset)};
+    }
+
+    /// @brief Remove data from the front of the buffer (consumer side)
+    /// @param length number of characters to remove, at most the size of the data returned by read()
+    void consume(int length) {
+        this->tail.store(this->tail.load(std::memory_order_relaxed) + length, std::memory_order_release);
+    }
+
+    /// @brief Get the number of characters in the buffer
+    ///
+    int size() const {
+        return int(this->head.load(std::memory_order_acquire) - this->tail.load(std::memory_order_acquire));
+    }
+
+    bool empty() const {return size() == 0;}
+
+    static constexpr int capacity() {return N;}
+
+    /// @brief Get the number of dropped messages since construction, the consumer can report the difference to the
+    /// last value it has seen
+    uint32_t droppedCount() const {return this->dropped.load(std::memory_order_relaxed);}
+
+protected:
+    // producer and consumer indices on separate cache lines on multicore systems, they wrap around at 2^32
+    static constexpr int ALIGNMENT = sizeof(void *) >= 8 ? 64 : alignof(uint32_t);
+    alignas(ALIGNMENT) std::atomic<uint32_t> head = 0;
+    std::atomic<uint32_t> dropped = 0;
+    alignas(ALIGNMENT) std::atomic<uint32_t> tail = 0;
+
+    char buffer[N];
+};
+
+} // namespace coco
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Array.hpp"
+#include "ArrayBuffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace coco {
+
+/// @brief Monotonic allocator on a caller-supplied buffer for objects and coroutine frames that all die together,
+/// e.g. when a request has been handled. Allocation only advances an offset and everything gets released at once by
+/// reset(). When the buffer is exhausted, the overflow policy decides if the memory comes from the heap (freed by
+/// reset()) or if the allocation fails after calling the failure hook.
+/// Coroutines (Coroutine, AwaitableCoroutine) get their frame from an arena that is passed as parameter, a coroutine
+/// that fails to allocate its frame does not run and returns an empty Coroutine or a completed AwaitableCoroutine.
+///
+/// Use like this:
+/// Coroutine handle(MonotonicArena &arena, Request &request) {
+///     auto *response = arena.create<Response>(request);
+///     co_await process(arena, request, *response);
+/// }
+/// uint8_t buffer[4096];
+/// MonotonicArena arena(buffer);
+/// handle(arena, request);
+/// // after the request has completed
+/// arena.reset();
+class MonotonicArena {
+public:
+    enum class Overflow {
+        // allocate from the heap, the memory gets freed by reset()
+        HEAP,
+
+        // call the failure hook and return nullptr
+        FAIL
+    };
+
+    // hook that gets called when an allocation fails
+    using FailureHook = void (*)(MonotonicArena &arena, int size);
+
+    /// @brief Constructor
+    /// @param buffer buffer to allocate from, must remain valid as long as the arena is used
+    /// @param overflow overflow policy
+    /// @param failed hook that gets called when an allocation fails (only for Overflow::FAIL)
+    explicit MonotonicArena(Array<uint8_t> buffer, Overflow overflow = Overflow::HEAP, FailureHook failed = nullptr)
+        : buffer(buffer.data()), bufferSize(buffer.size()), overflow(overflow), failed(failed) {}
+
+    /// @brief Constructor using the whole capacity of an ArrayBuffer
+    /// @param buffer buffer to allocate from, must remain valid as long as the arena is used
+    /// @param overflow overflow policy
+    /// @param failed hook that gets called when an allocation fails (only for Overflow::FAIL)
+    template <int N>
+    explicit MonotonicArena(ArrayBuffer<uint8_t, N> &buffer, Overflow overflow = Overflow::HEAP,
+        FailureHook failed = nullptr)
+        : buffer(buffer.data()), bufferSize(N), overflow(overflow), failed(failed) {}
+
+    MonotonicArena(const MonotonicArena &) = delete;
+
+    ~MonotonicArena() {
+        freeHeap();
+    }
+
+    /// @brief Allocate memory
+    /// @param size size in bytes
+    /// @param alignment alignment, must be a power of two
+    /// @return memory or nullptr if the buffer is exhausted and the overflow policy is Overflow::FAIL
+    void *allocate(int size, int alignment = alignof(std::max_align_t)) {
+        ++this->allocations;
+        uintptr_t address = reinterpret_cast<uintptr_t>(this->buffer + this->offset);
+        int offset = this->offset + int(((address + alignment - 1) & ~uintptr_t(alignment - 1)) - address);
+        if (offset + size <= this->bufferSize) {
+            this->offset = offset + size;
+            if (this->offset > this->highWater)
+                this->highWater = this->offset;
+            return this->buffer + offset;
+        }
+        return allocateOverflow(size, alignment);
+    }
+
+    /// @brief Deallocate memory, only has an effect if it was the last allocation in the buffer
+    /// @param memory memory returned by allocate()
+    /// @param size size of the memory
+    void deallocate(void *memory, int size) {
+        auto m = static_cast<uint8_t *>(memory);
+        if (m >= this->buffer && m + size == this->buffer + this->offset)
+            this->offset -= size;
+    }
+
+    /// @brief Allocate and construct an object. The destructor does not get called by reset(), therefore use for
+    /// trivially destructible objects or call it manually
+    /// @param args constructor arguments
+    /// @return object or nullptr if the buffer is exhausted and the overflow policy is Overflow::FAIL
+    template <typename T, typename ...Args>
+    T *create(Args &&...args) {
+        void *memory = allocate(sizeof(T), alignof(T));
+        if (memory == nullptr)
+            return nullptr;
+        return new (memory) T(std::forward<Args>(args)...);
+    }
+
+    /// @brief Release all memory at once, including memory allocated from the heap on overflow. No object or
+    /// coroutine frame allocated from the arena may be in use anymore
+    void reset() {
+        freeHeap();
+        this->offset = 0;
+    }
+
+    /// @brief Get the number of bytes used in the buffer
+    ///
+    int size() const {return this->offset;}
+
+    /// @brief Get the size of the buffer
+    ///
+    int capacity() const {return this->bufferSize;}
+
+    /// @brief Get the maximum number of bytes that were used in the buffer, to find out how large the buffer has to be
+    ///
+    int highWaterMark() const {return this->highWater;}
+
+    /// @brief Get the number of allocations since construction
+    ///
+    int allocationCount() const {return this->allocations;}
+
+    /// @brief Get the number of allocations that did not fit into the buffer since construction
+    ///
+    int overflowCount() const {return this->overflows;}
+
+    /// @brief Get the number of bytes currently allocated from the heap
+    ///
+    int heapSize() const {return this->heapBytes;}
+
+
+    /// @brief Allocate a coroutine frame, used by the promise types of Coroutine and AwaitableCoroutine. The frame
+    /// gets a header that stores the arena (nullptr for the heap) so that deallocateFrame() knows where it came from
+    /// @param arena arena or nullptr to allocate from the heap
+    /// @param size size of the frame
+    /// @return frame or nullptr if the allocation failed
+    static void *allocateFrame(MonotonicArena *arena, std::size_t size) noexcept {
+        std::size_t s = size + FRAME_HEADER;
+        void *memory = arena != nullptr ? arena->allocate(int(s), FRAME_HEADER) : ::operator new(s);
+        if (memory == nullptr)
+            return nullptr;
+        *static_cast<MonotonicArena **>(memory) = arena;
+        return static_cast<uint8_t *>(memory) + FRAME_HEADER;
+    }
+
+    /// @brief Deallocate a coroutine frame
+    /// @param frame frame returned by allocateFrame()
+    /// @param size size of the frame
+    static void deallocateFrame(void *frame, std::size_t size) noexcept {
+        uint8_t *memory = static_cast<uint8_t *>(frame) - FRAME_HEADER;
+        auto arena = *reinterpret_cast<MonotonicArena **>(memory);
+        if (arena != nullptr)
+            arena->deallocate(memory, int(size + FRAME_HEADER));
+        else
+            ::operator delete(memory);
+    }
+
+protected:
+    static constexpr int FRAME_HEADER = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    // block allocated from the heap on overflow
+    struct HeapBlock {
+        HeapBlock *next;
+        int size;
+    };
+    static constexpr int HEAP_HEADER = (sizeof(HeapBlock) + alignof(std::max_align_t) - 1)
+        & ~(alignof(std::max_align_t) - 1);
+
+    void *allocateOverflow(int size, int alignment) {
+        ++this->overflows;
+        if (this->overflow == Overflow::FAIL || alignment > int(alignof(std::max_align_t))) {
+            if (this->failed != nullptr)
+                this->failed(*this, size);
+            return nullptr;
+        }
+        auto block = static_cast<HeapBlock *>(::operator new(HEAP_HEADER + size));
+        block->next = this->heap;
+        block->size = size;
+        this->heap = block;
+        this->heapBytes += size;
+        return reinterpret_cast<uint8_t *>(block) + HEAP_HEADER;
+    }
+
+    void freeHeap() {
+        while (this->heap != nullptr) {
+            auto next = this->heap->next;
+            ::operator delete(this->heap);
+            this->heap = next;
+        }
+        this->heapBytes = 0;
+    }
+
+    uint8_t *buffer;
+    int bufferSize;
+    int offset = 0;
+    Overflow overflow;
+    FailureHook failed;
+
+    // memory allocated from the heap on overflow
+    HeapBlock *heap = nullptr;
+
+    // statistics
+    int highWater = 0;
+    int allocations = 0;
+    int overflows = 0;
+    int heapBytes = 0;
+};
+
+
+// get the arena from the parameters of a coroutine
+inline MonotonicArena *getArena(MonotonicArena &arena) {return &arena;}
+template <typename T>
+MonotonicArena *getArena(T &) {return nullptr;}
+
+// parameter of a coroutine as seen by the operator new of ArenaPromise, converts from any parameter. This keeps
+// operator new a non-template so that it matches the usual operator delete
+struct ArenaArg {
+    ArenaArg() = default;
+    template <typename T> requires (!std::is_same_v<std::remove_cv_t<T>, ArenaArg>)
+    ArenaArg(T &arg) : arena(getArena(arg)) {}
+
+    MonotonicArena *arena = nullptr;
+};
+
+/// @brief Base class for promise types that allocates the coroutine frame from the first MonotonicArena in the
+/// parameter list of the coroutine (up to 8 parameters), or from the heap if there is none
+struct ArenaPromise {
+    static void *operator new(std::size_t size) noexcept {
+        return MonotonicArena::allocateFrame(nullptr, size);
+    }
+
+    static void *operator new(std::size_t size, ArenaArg a0, ArenaArg a1 = {}, ArenaArg a2 = {}, ArenaArg a3 = {},
+        ArenaArg a4 = {}, ArenaArg a5 = {}, ArenaArg a6 = {}, ArenaArg a7 = {}) noexcept
+    {
+        MonotonicArena *arena = nullptr;
+        for (auto a : {a0, a1, a2, a3, a4, a5, a6, a7}) {
+            if (arena == nullptr)
+                arena = a.arena;
+        }
+        return MonotonicArena::allocateFrame(arena, size);
+    }
+
+    static void operator delete(void *frame, std::size_t size) noexcept {
+        MonotonicArena::deallocateFrame(frame, size);
+    }
+};
+
+} // namespace coco
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+
+namespace coco {
+
+/// @brief Lock-free pool of N objects of type T with inline storage, e.g. for transfer nodes of an InterruptQueue.
+/// The free slots form a Treiber stack whose head contains a tag that gets incremented on each change to avoid the ABA
+/// problem, therefore allocate() and release() can be called from threads and interrupt handlers of any priority
+/// (requires compare-and-swap, i.e. not on Cortex-M0). Also counts the objects in use and the high-water mark.
+///
+/// Use like this:
+/// ObjectPool<Transfer, 16> pool;
+/// Transfer *transfer = pool.create(buffer, length); // nullptr if the pool is exhausted
+/// pool.destroy(transfer);
+///
+/// @tparam T object type
+/// @tparam N number of objects, at most 65534
+template <typename T, int N>
+class ObjectPool {
+    static_assert(N > 0 && N < 0xffff, "ObjectPool: size must be in the range 1 to 65534");
+public:
+    ObjectPool() {
+        for (int i = 0; i < N; ++i)
+            this->next[i].store(i + 1 < N ? i + 1 : NONE, std::memory_order_relaxed);
+        this->head.store(0, std::memory_order_relaxed);
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+
+    /// @brief Allocate storage for an object without constructing it
+    /// @return pointer to uninitialized storage or nullptr if the pool is exhausted
+    void *allocate() {
+        uint32_t head = this->head.load(std::memory_order_acquire);
+        uint32_t index;
+        do {
+            index = head & 0xffff;
+            if (index == NONE) {
+                this->failed.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            // next may already be modified by another thread that got the same slot, then the tag has changed and
+            // the exchange fails
+            uint32_t next = this->next[index].load(std::memory_order_relaxed);
+            if (this->head.compare_exchange_weak(head, tagged(head, next), std::memory_order_acquire,
+                std::memory_order_acquire))
+            {
+                break;
+            }
+        } while (true);
+
+        // update statistics
+        int used = this->used.fetch_add(1, std::memory_order_relaxed) + 1;
+        int highWater = this->highWater.load(std::memory_order_relaxed);
+        while (used > highWater && !this->highWater.compare_exchange_weak(highWater, used, std::memory_order_relaxed))
+            ;
+
+        return this->storage[index].data;
+    }
+
+    /// @brief Return storage to the pool without destroying the object
+    /// @param object pointer returned by allocate(), nullptr is ignored
+    void release(void *object) {
+        if (object == nullptr)
+            return;
+        uint32_t index = reinterpret_cast<Slot *>(object) - this->storage;
+
+        // decrement before the slot becomes available so that size() never exceeds N
+        this->used.fetch_sub(1, std::memory_order_relaxed);
+
+        uint32_t head = this->head.load(std::memory_order_relaxed);
+        do {
+            this->next[index].store(head & 0xffff, std::memory_order_relaxed);
+        } while (!this->head.compare_exchange_weak(head, tagged(head, index), std::memory_order_release,
+            std::memory_order_relaxed));
+    }
+
+    /// @brief Allocate and construct an object
+    /// @param args constructor arguments
+    /// @return pointer to the object or nullptr if the pool is exhausted
+    template <typename ...Args>
+    T *create(Args &&...args) {
+        void *storage = allocate();
+        if (storage == nullptr)
+            return nullptr;
+        return new (storage) T(std::forward<Args>(args)...);
+    }
+
+    /// @brief Destroy an object and return it to the pool
+    /// @param object object created by create(), nullptr is ignored
+    void destroy(T *object) {
+        if (object == nullptr)
+            return;
+        object->~T();
+        release(object);
+    }
+
+    /// @brief Check if an object belongs to this pool
+    ///
+    bool contains(const void *object) const {
+        auto slot = reinterpret_cast<const Slot *>(object);
+        return slot >= this->storage && slot < this->storage + N;
+    }
+
+    static constexpr int capacity() {return N;}
+
+    /// @brief Get the number of objects in use
+    ///
+    int size() const {return this->used.load(std::memory_order_relaxed);}
+
+    /// @brief Get the maximum number of objects that were in use at the same time
+    ///
+    int highWaterMark() const {return this->highWater.load(std::memory_order_relaxed);}
+
+    /// @brief Get the number of failed allocations because the pool was exhausted
+    ///
+    uint32_t failedCount() const {return this->failed.load(std::memory_order_relaxed);}
+
+protected:
+    static constexpr uint32_t NONE = 0xffff;
+
+    // replace the index of the head and increment the tag in the upper 16 bits
+    static uint32_t tagged(uint32_t head, uint32_t index) {
+        return ((head + 0x10000) & 0xffff0000) | index;
+    }
+
+    struct Slot {
+        alignas(T) uint8_t data[sizeof(T)];
+    };
+
+    Slot storage[N];
+
+    // index of the next free slot for each slot in the free list
+    std::atomic<uint16_t> next[N];
+
+    // tag in the upper 16 bits and index of the first free slot in the lower 16 bits
+    std::atomic<uint32_t> head;
+
+    // statistics
+    std::atomic<int> used = 0;
+    std::atomic<int> highWater = 0;
+    std::atomic<uint32_t> failed = 0;
+};
+
+} // namespace coco
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "CStringConcept.hpp"
+#include "String.hpp"
+#include "hash.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace coco {
+
+/// @brief Minimal perfect hash table for a fixed set of strings that is built at compile time (hash and displace).
+/// A lookup costs one string hash, two multiplications and one final string comparison. Use for example to parse
+/// commands of a serial command shell:
+///
+/// enum class Command {START, STOP, STATUS};
+/// constexpr PerfectHash commands("start", "stop", "status");
+/// switch (commands.find(str, Command(-1))) {case Command::START: ...}
+///
+/// @tparam N number of strings
+template <int N>
+class PerfectHash {
+    static_assert(N > 0, "PerfectHash needs at least one string");
+public:
+    // number of buckets, each bucket has its own displacement
+    static constexpr int BUCKET_COUNT = N / 2 + 1;
+
+    using Index = std::conditional_t<(N <= 256), uint8_t, uint16_t>;
+
+    /// @brief Construct from string literals, e.g. PerfectHash("foo", "bar")
+    ///
+    template <typename ...T> requires (sizeof...(T) == N && (CStringConcept<T> && ...))
+    consteval PerfectHash(const T &...strings) : strings{String(strings)...} {
+        build();
+    }
+
+    /// @brief Construct from an array of strings, e.g. PerfectHash(strings) where strings is constexpr String[N]
+    ///
+    consteval PerfectHash(const String (&strings)[N]) {
+        std::copy(std::begin(strings), std::end(strings), this->strings);
+        build();
+    }
+
+    /// @brief Get number of strings
+    ///
+    static constexpr int size() {return N;}
+
+    /// @brief Get a string by index
+    ///
+    constexpr String operator [](int index) const {return this->strings[index];}
+
+    /// @brief Find a string
+    /// @param str string to find
+    /// @param defaultValue value to return when the string is not found
+    /// @return index of the string in the list of strings passed to the constructor
+    int find(String str, int defaultValue = -1) const {
+        uint32_t h = hash(str.data(), str.size(), this->seed);
+        int index = this->indices[slot(h, this->displacements[bucket(h)])];
+        return this->strings[index] == str ? index : defaultValue;
+    }
+
+    /// @brief Find a string and return an enum value whose enumerators have the same order as the strings
+    /// @param str string to find
+    /// @param defaultValue value to return when the string is not found
+    /// @return enum value
+    template <typename E> requires (std::is_enum_v<E>)
+    E find(String str, E defaultValue) const {
+        int index = find(str);
+        return index >= 0 ? E(index) : defaultValue;
+    }
+
+protected:
+    static constexpr int bucket(uint32_t h) {
+        return int((uint64_t(h) * BUCKET_COUNT) >> 32);
+    }
+
+    static constexpr int slot(uint32_t h, uint32_t displacement) {
+        // finalizer of MurmurHash3
+        uint32_t x = h + displacement * 0x9e3779b9u;
+        x ^= x >> 16;
+        x *= 0x85ebca6bu;
+        x ^= x >> 13;
+        x *= 0xc2b2ae35u;
+        x ^= x >> 16;
+        return int((uint64_t(x) * N) >> 32);
+    }
+
+    static constexpr bool equal(String a, String b) {
+        if (a.size() != b.size())
+            return false;
+        for (int i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i])
+                return false;
+        }
+        return true;
+    }
+
+    consteval void build() {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < i; ++j) {
+                if (equal(this->strings[i], this->strings[j]))
+                    throw "PerfectHash: duplicate string";
+            }
+        }
+        for (uint32_t seed = 0; seed < 256; ++seed) {
+            if (build(seed)) {
+                this->seed = seed;
+                return;
+            }
+        }
+        throw "PerfectHash: no perfect hash found";
+    }
+
+    consteval bool build(uint32_t seed) {
+        // hash all strings and sort them by bucket
+        uint32_t hashes[N];
+        int order[N];
+        for (int i = 0; i < N; ++i) {
+            hashes[i] = hash(this->strings[i].data(), this->strings[i].size(), seed);
+            order[i] = i;
+        }
+        std::sort(order, order + N, [&hashes](int a, int b) {return bucket(hashes[a]) < bucket(hashes[b]);});
+
+        // determine range of each bucket in order
+        int starts[BUCKET_COUNT + 1] = {};
+        for (int i = 0; i < N; ++i)
+            ++starts[bucket(hashes[i]) + 1];
+        for (int b = 0; b < BUCKET_COUNT; ++b)
+            starts[b + 1] += starts[b];
+
+        // place large buckets first
+        int buckets[BUCKET_COUNT];
+        for (int b = 0; b < BUCKET_COUNT; ++b)
+            buckets[b] = b;
+        std::sort(buckets, buckets + BUCKET_COUNT, [&starts](int a, int b) {
+            return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+        });
+
+        // find a displacement for each bucket so that its strings get placed in free slots
+        bool used[N] = {};
+        for (int b : buckets) {
+            int start = starts[b];
+            int end = starts[b + 1];
+            uint32_t displacement = 0;
+            for (; displacement < 65536; ++displacement) {
+                int slots[N];
+                bool free = true;
+                for (int i = start; i < end && free; ++i) {
+                    int s = slot(hashes[order[i]], displacement);
+                    free = !used[s];
+                    for (int j = start; j < i; ++j)
+                        free &= slots[j - start] != s;
+                    slots[i - start] = s;
+                }
+                if (free) {
+                    for (int i = start; i < end; ++i) {
+                        used[slots[i - start]] = true;
+                        this->indices[slots[i - start]] = Index(order[i]);
+                    }
+                    break;
+                }
+            }
+            if (displacement == 65536)
+                return false;
+            this->displacements[b] = uint16_t(displacement);
+        }
+        return true;
+    }
+
+    uint32_t seed = 0;
+    uint16_t displacements[BUCKET_COUNT] = {};
+    Index indices[N] = {};
+    String strings[N];
+};
+
+// deduction guide for construction from string literals
+template <typename ...T>
+PerfectHash(const T &...) -> PerfectHash<sizeof...(T)>;
+
+} // namespace coco
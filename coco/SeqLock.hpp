@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+namespace coco {
+
+/// @brief Sequence lock for multi-word state (e.g. calibration tables or a pose) that gets updated rarely by one writer
+/// (an interrupt handler or a thread) and read often by many coroutines, without disabling interrupts. The writer
+/// increments a sequence counter before and after the update, the readers copy the state optimistically and retry if
+/// the counter was odd or has changed in the meantime.
+/// The state is stored in relaxed atomic words so that concurrent access is well-defined, the ordering is done by
+/// fences. On Cortex-M the writer preempts the reader on the same core, therefore compiler fences are sufficient,
+/// otherwise (x86, ARM64) memory fences are used.
+/// The reader must not preempt the writer (e.g. read in an interrupt handler while a thread writes) as read() would
+/// retry forever, use tryRead() in this case.
+///
+/// Use like this:
+/// SeqLock<Vector4<float>> pose;
+/// // interrupt handler or thread
+/// pose.write(newPose);
+/// // coroutines
+/// auto p = pose.read();
+///
+/// @tparam T value type, must be trivially copyable
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock: type must be trivially copyable");
+public:
+    SeqLock() = default;
+
+    /// @brief Construct with an initial value
+    /// @param value initial value
+    explicit SeqLock(const T &value) {
+        store(value);
+    }
+
+    /// @brief Write a new value, only one writer at a time
+    /// @param value value
+    void write(const T &value) {
+        uint32_t sequence = this->sequence.load(std::memory_order_relaxed);
+
+        // odd sequence: write in progress
+        this->sequence.store(sequence + 1, std::memory_order_relaxed);
+        fence(std::memory_order_release);
+        store(value);
+        this->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// @brief Try to read the value once
+    /// @param value receives the value if successful
+    /// @return true if successful, false if a write was in progress
+    bool tryRead(T &value) const {
+        uint32_t sequence = this->sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+            return false;
+        load(value);
+        fence(std::memory_order_acquire);
+        return this->sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    /// @brief Read the value, retries until no write happened during the read
+    /// @return value
+    T read() const {
+        T value;
+        while (!tryRead(value))
+            ;
+        return value;
+    }
+
+    /// @brief Get the sequence counter, e.g. to detect if the value has changed since the last read. The counter is
+    /// odd while a write is in progress
+    uint32_t getSequence() const {
+        return this->sequence.load(std::memory_order_acquire);
+    }
+
+protected:
+    static constexpr int WORD_COUNT = (sizeof(T) + 3) / 4;
+
+    static void fence(std::memory_order order) {
+#if defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+        std::atomic_signal_fence(order);
+#else
+        std::atomic_thread_fence(order);
+#endif
+    }
+
+    void store(const T &value) {
+        uint32_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (int i = 0; i < WORD_COUNT; ++i)
+            this->words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    void load(T &value) const {
+        uint32_t words[WORD_COUNT];
+        for (int i = 0; i < WORD_COUNT; ++i)
+            words[i] = this->words[i].load(std::memory_order_relaxed);
+        std::memcpy(&value, words, sizeof(T));
+    }
+
+    std::atomic<uint32_t> sequence = 0;
+    std::atomic<uint32_t> words[WORD_COUNT] = {};
+};
+
+} // namespace coco
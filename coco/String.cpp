@@ -0,0 +1,217 @@
+#include "String.hpp"
+#include <bit>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+
+namespace coco {
+
+namespace {
+
+// Blocks of bytes that get compared in parallel. Each block type provides a compare function that returns a mask
+// with exactly one bit set for each equal byte at bit position (byte index << SHIFT)
+
+#if defined(__AVX2__)
+
+struct Block {
+    static constexpr int SIZE = 32;
+    static constexpr int SHIFT = 0;
+    using Mask = uint32_t;
+    static constexpr Mask ALL = 0xffffffff;
+
+    using Value = __m256i;
+    static Value splat(char ch) {return _mm256_set1_epi8(ch);}
+    static Value load(const char *p) {return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));}
+    static Mask equal(Value a, Value b) {return uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));}
+};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct Block {
+    static constexpr int SIZE = 16;
+    static constexpr int SHIFT = 0;
+    using Mask = uint32_t;
+    static constexpr Mask ALL = 0xffff;
+
+    using Value = __m128i;
+    static Value splat(char ch) {return _mm_set1_epi8(ch);}
+    static Value load(const char *p) {return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));}
+    static Mask equal(Value a, Value b) {return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));}
+};
+
+#elif defined(__ARM_NEON)
+
+struct Block {
+    static constexpr int SIZE = 16;
+    static constexpr int SHIFT = 2;
+    using Mask = uint64_t;
+    static constexpr Mask ALL = 0x8888888888888888ull;
+
+    using Value = uint8x16_t;
+    static Value splat(char ch) {return vdupq_n_u8(uint8_t(ch));}
+    static Value load(const char *p) {return vld1q_u8(reinterpret_cast<const uint8_t *>(p));}
+    static Mask equal(Value a, Value b) {
+        // narrow each byte of the comparison result to a nibble (there is no movemask on NEON)
+        uint8x8_t n = vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(a, b)), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(n), 0) & ALL;
+    }
+};
+
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && (!defined(__arm__) || defined(__ARM_FEATURE_UNALIGNED))
+
+// SWAR (SIMD within a register) fallback, e.g. for Cortex-M3/M4 which support unaligned word access
+struct Block {
+    using Value = std::conditional_t<sizeof(void *) >= 8, uint64_t, uint32_t>;
+    static constexpr int SIZE = sizeof(Value);
+    static constexpr int SHIFT = 3;
+    using Mask = Value;
+    static constexpr Mask ALL = Value(0x8080808080808080ull);
+    static constexpr Value LOW = Value(0x7f7f7f7f7f7f7f7full);
+
+    static Value splat(char ch) {return Value(0x0101010101010101ull) * uint8_t(ch);}
+    static Value load(const char *p) {
+        Value value;
+        std::memcpy(&value, p, sizeof(Value));
+        return value;
+    }
+    static Mask equal(Value a, Value b) {
+        // exact zero byte detection without false positives caused by carries
+        Value x = a ^ b;
+        return ~(((x & LOW) + LOW) | x | LOW);
+    }
+};
+
+#else
+#define COCO_STRING_SCALAR
+#endif
+
+} // namespace
+
+
+namespace detail {
+
+#ifndef COCO_STRING_SCALAR
+
+int indexOf(const char *data, int length, char ch) {
+    auto c = Block::splat(ch);
+    int i = 0;
+    for (; i + Block::SIZE <= length; i += Block::SIZE) {
+        auto mask = Block::equal(Block::load(data + i), c);
+        if (mask != 0)
+            return i + (std::countr_zero(mask) >> Block::SHIFT);
+    }
+    for (; i < length; ++i) {
+        if (data[i] == ch)
+            return i;
+    }
+    return -1;
+}
+
+int lastIndexOf(const char *data, int length, char ch) {
+    auto c = Block::splat(ch);
+    int i = length;
+    for (; i >= Block::SIZE; i -= Block::SIZE) {
+        auto mask = Block::equal(Block::load(data + i - Block::SIZE), c);
+        if (mask != 0)
+            return i - Block::SIZE + ((std::bit_width(mask) - 1) >> Block::SHIFT);
+    }
+    while (i > 0) {
+        --i;
+        if (data[i] == ch)
+            return i;
+    }
+    return -1;
+}
+
+int indexOf(const char *data, int length, const char *str, int strLength) {
+    if (strLength <= 1)
+        return strLength == 1 ? indexOf(data, length, str[0]) : (length >= 0 ? 0 : -1);
+
+    // filter candidates where first and last character match, then compare the characters in between
+    auto first = Block::splat(str[0]);
+    auto last = Block::splat(str[strLength - 1]);
+    int end = length - strLength + 1;
+    int i = 0;
+    for (; i + Block::SIZE <= end; i += Block::SIZE) {
+        auto mask = Block::equal(Block::load(data + i), first)
+            & Block::equal(Block::load(data + i + strLength - 1), last);
+        while (mask != 0) {
+            int j = i + (std::countr_zero(mask) >> Block::SHIFT);
+            if (std::memcmp(data + j + 1, str + 1, strLength - 2) == 0)
+                return j;
+            mask &= mask - 1;
+        }
+    }
+    for (; i < end; ++i) {
+        if (data[i] == str[0] && data[i + strLength - 1] == str[strLength - 1]
+            && std::memcmp(data + i + 1, str + 1, strLength - 2) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int mismatch(const char *a, const char *b, int length) {
+    int i = 0;
+    for (; i + Block::SIZE <= length; i += Block::SIZE) {
+        auto mask = ~Block::equal(Block::load(a + i), Block::load(b + i)) & Block::ALL;
+        if (mask != 0)
+            return i + (std::countr_zero(mask) >> Block::SHIFT);
+    }
+    for (; i < length; ++i) {
+        if (a[i] != b[i])
+            return i;
+    }
+    return length;
+}
+
+#else
+
+int indexOf(const char *data, int length, char ch) {
+    for (int i = 0; i < length; ++i) {
+        if (data[i] == ch)
+            return i;
+    }
+    return -1;
+}
+
+int lastIndexOf(const char *data, int length, char ch) {
+    int i = length;
+    while (i > 0) {
+        --i;
+        if (data[i] == ch)
+            return i;
+    }
+    return -1;
+}
+
+int indexOf(const char *data, int length, const char *str, int strLength) {
+    if (strLength <= 0)
+        return length >= 0 ? 0 : -1;
+    int end = length - strLength + 1;
+    for (int i = 0; i < end; ++i) {
+        if (data[i] == str[0] && std::memcmp(data + i + 1, str + 1, strLength - 1) == 0)
+            return i;
+    }
+    return -1;
+}
+
+int mismatch(const char *a, const char *b, int length) {
+    for (int i = 0; i < length; ++i) {
+        if (a[i] != b[i])
+            return i;
+    }
+    return length;
+}
+
+#endif
+
+} // namespace detail
+} // namespace coco
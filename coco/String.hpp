@@ -2,6 +2,7 @@
 
 #include "ArrayConcept.hpp"
 #include "CStringConcept.hpp"
+#include "hash.hpp"
 #include <limits>
 #include <algorithm>
 #include <cstdint>
@@ -12,6 +13,14 @@
 
 namespace coco {
 
+namespace detail {
+    // search and compare kernels, vectorized using SSE2/AVX2/NEON or SWAR (see String.cpp)
+    int indexOf(const char *data, int length, char ch);
+    int lastIndexOf(const char *data, int length, char ch);
+    int indexOf(const char *data, int length, const char *str, int strLength);
+    int mismatch(const char *a, const char *b, int length);
+} // namespace detail
+
 inline bool isWhiteSpace(char ch) {
     return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == 0;
 }
@@ -80,14 +89,7 @@ public:
     bool startsWith(String prefix) const {
         if (prefix.length > this->length)
             return false;
-        auto it = prefix.buffer;
-        auto end = it + prefix.length;
-        auto it2 = this->buffer;
-        for (; it != end; ++it, ++it2) {
-            if (*it != *it2)
-                return false;
-        }
-        return true;
+        return detail::mismatch(prefix.buffer, this->buffer, prefix.length) == prefix.length;
     }
 
     /// @brief Checks if a string ends with a prefix string.
@@ -96,14 +98,8 @@ public:
     bool endsWith(String suffix) const {
         if (suffix.length > this->length)
             return false;
-        auto it = suffix.buffer;
-        auto end = it + suffix.length;
-        auto it2 = this->buffer + this->length - suffix.length;
-        for (; it != end; ++it, ++it2) {
-            if (*it != *it2)
-                return false;
-        }
-        return true;
+        auto it = this->buffer + this->length - suffix.length;
+        return detail::mismatch(suffix.buffer, it, suffix.length) == suffix.length;
     }
 
     /// @brief Remove whitespaces at the beginning and end of the string
@@ -127,11 +123,9 @@ public:
     /// @param defaultValue value to return when the character is not found
     /// @return index of first occurrence of the character
     int indexOf(char ch, int startIndex = 0, int defaultValue = -1) const {
-        for (int i = startIndex; i < this->length; ++i) {
-            if (this->buffer[i] == ch)
-                return i;
-        }
-        return defaultValue;
+        startIndex = std::max(startIndex, 0);
+        int i = detail::indexOf(this->buffer + startIndex, this->length - startIndex, ch);
+        return i >= 0 ? startIndex + i : defaultValue;
     }
 
     /// @brief Return the index of the first occurrence of a string or a default value (-1) when not found
@@ -140,21 +134,9 @@ public:
     /// @param defaultValue value to return when the character is not found
     /// @return index of first occurrence of the character
     int indexOf(String str, int startIndex = 0, int defaultValue = -1) const {
-        char ch = str[0];
-        for (int i = startIndex; i < this->length; ++i) {
-            if (this->buffer[i] == ch) {
-                auto b = &this->buffer[i];
-                for (int j = 1; j < str.size(); ++j) {
-                    if (b[j] != str[j]) {
-                        goto skip;
-                    }
-                }
-                return i;
-            }
-    skip:
-            ;
-        }
-        return defaultValue;
+        startIndex = std::max(startIndex, 0);
+        int i = detail::indexOf(this->buffer + startIndex, this->length - startIndex, str.buffer, str.length);
+        return i >= 0 ? startIndex + i : defaultValue;
     }
 
     /// @brief Return the index of the last occurrence of a character
@@ -163,13 +145,8 @@ public:
     /// @param defaultValue value to return when the character is not found
     /// @return index of first occurrence of the character
     int lastIndexOf(char ch, int startIndex = std::numeric_limits<int>::max(), int defaultValue = -1) const {
-        int i = std::min(startIndex, this->length);
-        while (i > 0) {
-            --i;
-            if (this->buffer[i] == ch)
-                return i;
-        }
-        return defaultValue;
+        int i = detail::lastIndexOf(this->buffer, std::min(startIndex, this->length), ch);
+        return i >= 0 ? i : defaultValue;
     }
 
     /// @brief Index operator
@@ -182,26 +159,29 @@ public:
         return {this->buffer, size_t(this->length)};
     }
 
-    /// @brief Calculate a hash of the string
+    /// @brief Calculate a fast hash of the string, can be evaluated at compile time and compared against
+    /// string literals, e.g. switch (str.hash()) {case "foo"_hash: ...}
+    /// @return hash of string, see coco::hash()
+    constexpr uint32_t hash() const {
+        return coco::hash(this->buffer, this->length);
+    }
+
+    /// @brief Calculate the djb2 hash of the string (was returned by hash() in previous versions)
     /// http://www.cse.yorku.ca/~oz/hash.html
-    /// @return dj2 hash of string
-    uint32_t hash() const {
-        uint32_t h = 5381;
-        for (char c : *this) {
-            h = (h << 5) + h + uint8_t(c); // hash	33 + c
-        }
-        return h;
+    /// @return djb2 hash of string
+    constexpr uint32_t djb2() const {
+        return coco::djb2(this->buffer, this->length);
     }
 
     /// @brief Array access data() and size() which is O(1)
     ///
-    const char *data() const {return this->buffer;}
-    int size() const {return this->length;}
+    constexpr const char *data() const {return this->buffer;}
+    constexpr int size() const {return this->length;}
 
     /// @brief Iterators begin() and end()
     ///
-    const char *begin() const {return this->buffer;}
-    const char *end() const {return this->buffer + this->length;}
+    constexpr const char *begin() const {return this->buffer;}
+    constexpr const char *end() const {return this->buffer + this->length;}
 
 protected:
 
@@ -214,31 +194,16 @@ protected:
 inline bool operator ==(String a, String b) {
     if (a.length != b.length)
         return false;
-    auto it = a.buffer;
-    auto end = it + a.length;
-    auto it2 = b.buffer;
-    for (; it != end; ++it, ++it2) {
-        if (*it != *it2)
-            return false;
-    }
-    /*for (int i = 0; i < a.length; ++i) {
-        if (a.buffer[i] != b.buffer[i])
-            return false;
-    }*/
-    return true;
+    return detail::mismatch(a.buffer, b.buffer, a.length) == a.length;
 }
 
 /// @brief Spaceship operator
 ///
 inline std::strong_ordering operator <=>(String a, String b) {
     int length = std::min(a.length, b.length);
-    for (int i = 0; i < length; ++i) {
-        auto c = (unsigned char)a.buffer[i];
-        auto d = (unsigned char)b.buffer[i];
-        auto res = c <=> d;
-        if (res != 0)
-            return res;
-    }
+    int i = detail::mismatch(a.buffer, b.buffer, length);
+    if (i < length)
+        return (unsigned char)a.buffer[i] <=> (unsigned char)b.buffer[i];
     return a.length <=> b.length;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IntrusiveList.hpp"
+#include "trace.hpp"
 #include <cassert>
 #include <utility>
 
@@ -78,6 +79,7 @@ public:
         task.next = this;
         this->prev->next = &task;
         this->prev = &task;
+        trace::add(task);
     }
 
     /**
@@ -106,7 +108,9 @@ public:
             first.remove();
 
             // execute task
+            trace::resume(first);
             first.task();
+            trace::end();
 
             return true;
         }
@@ -139,7 +143,9 @@ public:
             first.remove();
 
             // execute task
+            trace::resume(first);
             first.task();
+            trace::end();
         }
     }
 
@@ -157,7 +163,9 @@ public:
                 first.remove();
 
                 // execute task
+                trace::resume(first);
                 first.task();
+                trace::end();
 
                 return true;
             }
@@ -202,7 +210,9 @@ public:
             first.remove();
 
             // execute task
+            trace::resume(first);
             first.task();
+            trace::end();
         }
 
 
@@ -86,6 +86,7 @@ public:
 		task.next = current;
 		current->prev->next = &task;
 		current->prev = &task;
+		trace::add(task);
 	}
 
 	/**
@@ -131,7 +132,9 @@ public:
 		while (head.next != &head) {
 			auto &current = static_cast<Task &>(*head.next);
 			current.remove();
+			trace::timer(current);
 			current.task();
+			trace::end();
 		}
 	}
 };
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Coroutine.hpp"
+#include <atomic>
+#include <cstdint>
+
+
+namespace coco {
+
+/// @brief Lock-free triple buffer for sharing the latest value between a writer (e.g. an interrupt handler or thread)
+/// and coroutines that only need the newest value, e.g. sensor samples. The writer writes into its own back buffer and
+/// the reader reads from its own front buffer, they only exchange buffer indices with one atomic exchange, therefore
+/// write() and read() are wait-free and torn reads are impossible without disabling interrupts. Values that get
+/// overwritten before they were read are skipped. ARMv6-M (Cortex-M0/M0+) has no atomic exchange instruction, there
+/// the exchange disables interrupts for two instructions instead.
+/// If write() gets called from an interrupt handler or another thread, call check() from the context of the coroutines
+/// (e.g. the event loop) to resume the coroutines that wait in untilUpdated(), otherwise use update().
+///
+/// Use like this:
+/// TripleBuffer<Vector3<int16_t>> imu;
+/// // interrupt handler
+/// imu.write(sample);
+/// // coroutine
+/// while (true) {
+///     co_await imu.untilUpdated();
+///     auto &sample = imu.read();
+/// }
+///
+/// @tparam T value type
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    /// @brief Construct with an initial value that read() returns until the first write()
+    /// @param value initial value
+    explicit TripleBuffer(const T &value) : buffers{value, value, value} {}
+
+    /// @brief Write a new value (writer side), can be called from an interrupt handler or another thread
+    /// @param value value
+    void write(const T &value) {
+        this->buffers[this->back] = value;
+
+        // publish the back buffer and take over the previous middle buffer
+        this->back = exchange(uint8_t(this->back | UPDATED)) & INDEX;
+    }
+
+    /// @brief Write a new value and resume the waiting coroutines (writer side), only call from the context of the
+    /// coroutines
+    /// @param value value
+    void update(const T &value) {
+        write(value);
+        this->taskList.doAll();
+    }
+
+    /// @brief Check if a new value was written since the last read() (reader side)
+    ///
+    bool updated() const {
+        return (this->middle.load(std::memory_order_relaxed) & UPDATED) != 0;
+    }
+
+    /// @brief Read the newest value (reader side). The reference stays valid until the next call of read()
+    /// @return newest value
+    const T &read() {
+        if (updated()) {
+            // take over the middle buffer that contains the newest value
+            this->front = exchange(this->front) & INDEX;
+        }
+        return this->buffers[this->front];
+    }
+
+    /// @brief Resume the coroutines that wait in untilUpdated() if a new value was written (reader side). Call from the
+    /// context of the coroutines if write() gets called from an interrupt handler or another thread
+    void check() {
+        if (updated())
+            this->taskList.doAll();
+    }
+
+    /// @brief Wait until a new value was written since the last read()
+    /// @return use co_await on return value to wait
+    [[nodiscard]] Awaitable<> untilUpdated() {
+        if (updated())
+            return {};
+        return {this->taskList};
+    }
+
+protected:
+    static constexpr uint8_t INDEX = 3;
+    static constexpr uint8_t UPDATED = 4;
+
+    // exchange the middle buffer
+    uint8_t exchange(uint8_t value) {
+#ifdef __ARM_ARCH_6M__
+        // no exclusive load/store, std::atomic would call libatomic which is not interrupt-safe: disable interrupts,
+        // on a single core this is atomic with respect to interrupt handlers
+        uint32_t primask;
+        asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+        uint8_t old = this->middle.load(std::memory_order_relaxed);
+        this->middle.store(value, std::memory_order_relaxed);
+        asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+        return old;
+#else
+        return this->middle.exchange(value, std::memory_order_acq_rel);
+#endif
+    }
+
+    T buffers[3] = {};
+
+    // index of the buffer owned by the writer
+    uint8_t back = 0;
+
+    // index of the buffer owned by the reader
+    uint8_t front = 1;
+
+    // index of the buffer in the middle and UPDATED flag if it contains a value that was not read yet
+    std::atomic<uint8_t> middle = 2;
+
+    // list of waiting coroutines
+    TaskList<CoroutineTask> taskList;
+};
+
+} // namespace coco
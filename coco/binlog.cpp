@@ -0,0 +1,326 @@
+#include "binlog.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace coco {
+namespace binlog {
+
+namespace {
+    // reads from a record, sets ok to false when reading past the end
+    struct Reader {
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (this->it >= this->end)
+                    break;
+                uint8_t b = *this->it++;
+                value |= uint64_t(b & 0x7f) << shift;
+                if ((b & 0x80) == 0)
+                    return value;
+            }
+            this->ok = false;
+            return 0;
+        }
+
+        const uint8_t *bytes(uint64_t length) {
+            if (uint64_t(this->end - this->it) < length) {
+                this->ok = false;
+                return this->end;
+            }
+            auto data = this->it;
+            this->it += length;
+            return data;
+        }
+
+        const uint8_t *it;
+        const uint8_t *end;
+        bool ok = true;
+    };
+
+    // writes the text, clips at the end of the output buffer
+    struct Writer {
+        void write(const char *data, int length) {
+            length = std::min(length, int(this->end - this->it));
+            std::memcpy(this->it, data, length);
+            this->it += length;
+        }
+
+        void pad(int count, char ch = ' ') {
+            count = std::min(count, int(this->end - this->it));
+            for (int i = 0; i < count; ++i)
+                *this->it++ = ch;
+        }
+
+        char *it;
+        char *end;
+    };
+
+    // format field {:[0][width][.precision][type]}, see coco::detail::FormatField
+    struct Field {
+        bool zero = false;
+        int width = 0;
+        int precision = -1;
+        char type = 0;
+    };
+
+    int parseNumber(const char *&it, const char *end) {
+        int value = 0;
+        while (it < end && *it >= '0' && *it <= '9') {
+            value = value * 10 + *it - '0';
+            ++it;
+        }
+        return value;
+    }
+
+    // parse a field after the opening brace, the format string was already checked at compile time
+    const char *parseField(const char *it, const char *end, Field &field) {
+        if (it < end && *it == ':') {
+            ++it;
+            if (it < end && *it == '0') {
+                field.zero = true;
+                ++it;
+            }
+            field.width = parseNumber(it, end);
+            if (it < end && *it == '.') {
+                ++it;
+                field.precision = parseNumber(it, end);
+            }
+            if (it < end && *it != '}')
+                field.type = *it++;
+        }
+        return it < end ? it + 1 : it;
+    }
+
+    void formatInteger(Writer &w, const Field &field, uint64_t value, bool negative, int size) {
+        char buffer[24];
+        char *end = std::end(buffer);
+        int n;
+        if (field.type == 'x') {
+            // hex of the unsigned value with the size of the original type
+            if (negative)
+                value = 0 - value;
+            if (size < 8)
+                value &= (uint64_t(1) << size * 8) - 1;
+            n = std::max(int(std::bit_width(value) + 3) >> 2, 1);
+            if (field.zero)
+                n = std::max(n, std::min(field.width, 16));
+            else
+                w.pad(field.width - n);
+            coco::detail::hex(end, value, n);
+        } else {
+            n = coco::detail::decimalDigitCount(value);
+            if (field.zero)
+                n = std::max(n, std::min(field.width - negative, 20));
+            else
+                w.pad(field.width - n - negative);
+            if (negative)
+                w.write("-", 1);
+            coco::detail::dec(end, value, n);
+        }
+        w.write(end - n, n);
+    }
+
+    template <typename T>
+    void formatFloat(Writer &w, const Field &field, const uint8_t *data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        char buffer[24];
+        char *end = std::end(buffer);
+        char *begin;
+        if (field.type == 'g')
+            begin = coco::detail::decShortest(end, value);
+        else
+            begin = coco::detail::dec(end, value, 1, field.precision >= 0 ? -std::min(field.precision, 11) : 3);
+        int length = end - begin;
+        w.pad(field.width - length);
+        w.write(begin, length);
+    }
+
+    // decode an argument and format it, same output as format()
+    bool formatValue(Writer &w, const Field &field, char type, Reader &r) {
+        switch (type) {
+        case 's': {
+            uint64_t length = r.varint();
+            auto data = r.bytes(length);
+            if (!r.ok)
+                return false;
+            w.pad(field.width - int(length));
+            w.write(reinterpret_cast<const char *>(data), int(length));
+            break;
+        }
+        case 'c': {
+            auto data = r.bytes(1);
+            if (!r.ok)
+                return false;
+            w.pad(field.width - 1);
+            w.write(reinterpret_cast<const char *>(data), 1);
+            break;
+        }
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l': {
+            // zigzag encoded signed integer
+            uint64_t value = r.varint();
+            bool negative = (value & 1) != 0;
+            value = negative ? (value >> 1) + 1 : value >> 1;
+            formatInteger(w, field, value, negative, type == 'b' ? 1 : type == 'h' ? 2 : type == 'i' ? 4 : 8);
+            break;
+        }
+        case 'B':
+        case 'H':
+        case 'I':
+        case 'L':
+            formatInteger(w, field, r.varint(), false, type == 'B' ? 1 : type == 'H' ? 2 : type == 'I' ? 4 : 8);
+            break;
+        case 'f': {
+            auto data = r.bytes(4);
+            if (!r.ok)
+                return false;
+            formatFloat<float>(w, field, data);
+            break;
+        }
+        case 'd': {
+            auto data = r.bytes(8);
+            if (!r.ok)
+                return false;
+            formatFloat<double>(w, field, data);
+            break;
+        }
+        default:
+            return false;
+        }
+        return r.ok;
+    }
+
+    // maximum length of a record with the given key, same as detail::print() calculates it. Returns 0 if the id does
+    // not point to the start of an entry (type codes, null, format string, null)
+    int maxRecordLength(String strings, uint64_t key) {
+        uint64_t id = key >> 1;
+        if (id >= uint64_t(strings.size()) || (id > 0 && strings[int(id) - 1] != 0))
+            return 0;
+        int length = 5 + ((key & 1) != 0 ? 5 : 0);
+        const char *it = strings.data() + id;
+        for (; it < strings.end() && *it != 0; ++it) {
+            switch (*it) {
+            case 'c':
+                length += 1;
+                break;
+            case 'f':
+                length += 4;
+                break;
+            case 'd':
+                length += 8;
+                break;
+            case 'b':
+            case 'h':
+            case 'i':
+            case 'B':
+            case 'H':
+            case 'I':
+                length += 5;
+                break;
+            case 'l':
+            case 'L':
+                length += 10;
+                break;
+            case 's':
+                length += 2 + MAX_STRING_LENGTH;
+                break;
+            default:
+                return 0;
+            }
+        }
+
+        // format string must follow
+        if (it >= strings.end() || std::memchr(it + 1, 0, strings.end() - (it + 1)) == nullptr)
+            return 0;
+        return length;
+    }
+
+    bool decodeRecord(String strings, Reader &r, Writer &w) {
+        uint64_t key = r.varint();
+        uint64_t id = key >> 1;
+        if (!r.ok || id >= uint64_t(strings.size()))
+            return false;
+        if (key & 1) {
+            // timestamp
+            uint64_t timestamp = r.varint();
+            char buffer[20];
+            char *end = std::end(buffer);
+            char *begin = coco::detail::dec(end, timestamp, 1);
+            w.write("[", 1);
+            w.write(begin, end - begin);
+            w.write("] ", 2);
+        }
+
+        // entry: type codes, null, format string, null
+        const char *types = strings.data() + id;
+        const char *stringsEnd = strings.data() + strings.size();
+        auto format = static_cast<const char *>(std::memchr(types, 0, stringsEnd - types));
+        if (format == nullptr)
+            return false;
+        ++format;
+        auto formatEnd = static_cast<const char *>(std::memchr(format, 0, stringsEnd - format));
+        if (formatEnd == nullptr)
+            return false;
+
+        const char *it = format;
+        while (it < formatEnd) {
+            char ch = *it++;
+            if ((ch == '{' || ch == '}') && it < formatEnd && *it == ch) {
+                // escaped brace
+                w.write(&ch, 1);
+                ++it;
+            } else if (ch == '{') {
+                Field field;
+                it = parseField(it, formatEnd, field);
+                if (*types == 0 || !formatValue(w, field, *types, r))
+                    return false;
+                ++types;
+            } else {
+                w.write(&ch, 1);
+            }
+        }
+
+        // all arguments must be used
+        return *types == 0 && r.it == r.end;
+    }
+} // namespace
+
+ConvertedValue<int> decode(String strings, String data, char *out, int size) {
+    auto begin = reinterpret_cast<const uint8_t *>(data.data());
+    Reader r{begin, begin + data.size()};
+    uint64_t length = r.varint();
+    if (!r.ok) {
+        // incomplete length, or skip one byte if the length is invalid
+        return {0, data.size() >= 10 ? 1 : 0};
+    }
+    if (length > uint64_t(MAX_RECORD_LENGTH)) {
+        // no record is that long: skip one byte to resynchronize
+        return {0, 1};
+    }
+    Reader key{r.it, r.it + std::min(uint64_t(r.end - r.it), length)};
+    uint64_t k = key.varint();
+    if (key.ok) {
+        // invalid id or too long for the entry of the id: skip one byte to resynchronize
+        int maxLength = maxRecordLength(strings, k);
+        if (length > uint64_t(maxLength))
+            return {0, 1};
+    }
+    if (uint64_t(r.end - r.it) < length)
+        return {0, 0};
+
+    Reader record{r.it, r.it + length};
+    Writer w{out, out + size};
+    if (!decodeRecord(strings, record, w)) {
+        w.it = out;
+        String message = "<invalid binlog record>\n";
+        w.write(message.data(), message.size());
+    }
+    return {int(w.it - out), int(record.end - begin)};
+}
+
+} // namespace binlog
+} // namespace coco
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "convert.hpp"
+#include "debug.hpp"
+#include "format.hpp"
+#include "String.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+/**
+    Deferred binary logging: The format strings are interned at compile time into the coco_binlog section and each
+    log call only writes a compact binary record to debug::write():
+        [varint length] [varint id * 2 + timed] [varint timestamp if timed] [arguments]
+    The id is the offset of the format string in the coco_binlog section. Integers are varints (signed integers zigzag
+    encoded), float and double are 4 and 8 little endian bytes, char is one byte and strings are a varint length
+    followed by the characters. The format string syntax is the same as for format() (see format.hpp), the text gets
+    rendered on the host by binlog::decode() or the binlogDecode tool which reads the section from the ELF file:
+        COCO_BINLOG("x={} y={:04x} z={:.2}\n", x, y, z);
+    On microcontrollers, keep the strings out of the flash by adding this to the linker script:
+        coco_binlog 0 (INFO) : { __start_coco_binlog = .; KEEP(*(coco_binlog)) }
+    Note that GCC ignores the section attribute in templates, therefore use COCO_BINLOG() only in non-template
+    functions. On non-ELF platforms (Windows, MacOS) the text is formatted directly.
+*/
+namespace coco {
+namespace binlog {
+
+/// @brief Maximum length of a string argument, longer strings are truncated
+///
+constexpr int MAX_STRING_LENGTH = 64;
+
+/// @brief Maximum length of a record without the length prefix. The decoder skips longer lengths to resynchronize
+/// on corrupt data
+constexpr int MAX_RECORD_LENGTH = 1024;
+
+namespace detail {
+    using coco::detail::IsFormatString;
+
+    // type code of an argument (similar to Python struct): b/h/i/l signed and B/H/I/L unsigned 8/16/32/64 bit
+    // integer, f float, d double, c char, s string
+    template <typename T>
+    consteval char typeCode() {
+        if constexpr (std::is_enum_v<T>) {
+            return typeCode<std::underlying_type_t<T>>();
+        } else if constexpr (IsFormatString<T>) {
+            return 's';
+        } else if constexpr (std::is_same_v<T, char>) {
+            return 'c';
+        } else if constexpr (std::is_integral_v<T>) {
+            constexpr int index = std::bit_width(sizeof(T)) - 1;
+            return std::is_signed_v<T> ? "bhil"[index] : "BHIL"[index];
+        } else if constexpr (std::is_same_v<T, float>) {
+            return 'f';
+        } else if constexpr (std::is_same_v<T, double>) {
+            return 'd';
+        } else {
+            static_assert(std::is_same_v<T, double>, "binlog: unsupported argument type");
+        }
+    }
+
+    // maximum encoded length of an argument
+    template <typename T>
+    consteval int maxLength() {
+        if constexpr (std::is_enum_v<T>) {
+            return maxLength<std::underlying_type_t<T>>();
+        } else if constexpr (IsFormatString<T>) {
+            return 2 + MAX_STRING_LENGTH;
+        } else if constexpr (std::is_same_v<T, char>) {
+            return 1;
+        } else if constexpr (std::is_integral_v<T>) {
+            return sizeof(T) <= 4 ? 5 : 10;
+        } else {
+            return sizeof(T);
+        }
+    }
+
+    constexpr int varintLength(uint32_t value) {
+        return (std::bit_width(value | 1) + 6) / 7;
+    }
+
+    // entry in the coco_binlog section: type codes, null, format string, null
+    template <FormatString F, typename ...Args>
+    struct Entry {
+        static_assert(coco::detail::Format<F>::FIELD_COUNT == sizeof...(Args),
+            "binlog: number of arguments does not match the format string");
+
+        consteval Entry() {
+            int i = 0;
+            ((this->data[i++] = typeCode<Args>()), ...);
+            this->data[i++] = 0;
+            for (char ch : F.data)
+                this->data[i++] = ch;
+        }
+
+        char data[sizeof...(Args) + 1 + sizeof(F.data)];
+    };
+
+    // only used in decltype() to deduce the entry type from the arguments
+    template <FormatString F, typename ...Args>
+    Entry<F, std::remove_cvref_t<Args>...> entry(const Args &...args);
+
+    inline uint8_t *writeVarint(uint8_t *out, uint32_t value) {
+        while (value >= 0x80) {
+            *out++ = uint8_t(value | 0x80);
+            value >>= 7;
+        }
+        *out = uint8_t(value);
+        return out + 1;
+    }
+
+    inline uint8_t *writeVarint(uint8_t *out, uint64_t value) {
+        while (value >= 0x80) {
+            *out++ = uint8_t(value | 0x80);
+            value >>= 7;
+        }
+        *out = uint8_t(value);
+        return out + 1;
+    }
+
+    template <typename T>
+    uint8_t *writeValue(uint8_t *out, const T &value) {
+        if constexpr (std::is_enum_v<T>) {
+            return writeValue(out, std::underlying_type_t<T>(value));
+        } else if constexpr (IsFormatString<T>) {
+            String str(value);
+            int length = std::min(str.size(), MAX_STRING_LENGTH);
+            out = writeVarint(out, uint32_t(length));
+            std::memcpy(out, str.data(), length);
+            return out + length;
+        } else if constexpr (std::is_same_v<T, char>) {
+            *out = uint8_t(value);
+            return out + 1;
+        } else if constexpr (std::is_integral_v<T>) {
+            using U = std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>;
+            if constexpr (std::is_signed_v<T>) {
+                // zigzag encoding so that small negative values are short
+                using S = std::make_signed_t<U>;
+                return writeVarint(out, (U(value) << 1) ^ U(S(value) >> (sizeof(U) * 8 - 1)));
+            } else {
+                return writeVarint(out, U(value));
+            }
+        } else {
+            // float or double, all supported platforms are little endian
+            std::memcpy(out, &value, sizeof(T));
+            return out + sizeof(T);
+        }
+    }
+
+#ifdef __ELF__
+    // start and end of the coco_binlog section, provided by the linker
+    extern "C" __attribute__((visibility("hidden"))) const char __start_coco_binlog[];
+    extern "C" __attribute__((visibility("hidden"))) const char __stop_coco_binlog[];
+
+    // encode a record and write it using the write function, e.g. debug::write
+    template <bool TIMED, typename W, typename E, typename ...Args>
+    void print(W &&write, const E &entry, uint32_t timestamp, const Args &...args) {
+        // id, timestamp and arguments
+        constexpr int maxLength = 5 + (TIMED ? 5 : 0) + (0 + ... + detail::maxLength<Args>());
+        static_assert(maxLength <= MAX_RECORD_LENGTH, "binlog: too many arguments");
+        constexpr int prefixLength = varintLength(maxLength);
+        uint8_t record[prefixLength + maxLength];
+        uint8_t *begin = record + prefixLength;
+        uint8_t *it = writeVarint(begin, uint32_t(entry.data - __start_coco_binlog) * 2 + TIMED);
+        if constexpr (TIMED)
+            it = writeVarint(it, timestamp);
+        ((it = writeValue(it, args)), ...);
+
+        // length in front of the record
+        uint32_t length = it - begin;
+        int n = prefixLength == 1 ? 1 : varintLength(length);
+        writeVarint(begin - n, length);
+        write(reinterpret_cast<const char *>(begin - n), int(length) + n);
+    }
+#endif
+
+    // debug::write() is overloaded, therefore wrap it for use as write function
+    inline void debugWrite(const char *data, int length) {
+        debug::write(data, length);
+    }
+
+    // stream that forwards to a write function, used to format the text directly on non-ELF platforms
+    template <typename W>
+    struct WriteStream {
+        WriteStream &operator <<(const String &str) {
+            this->write(str.data(), str.size());
+            return *this;
+        }
+
+        W &write;
+    };
+
+    template <FormatString F, bool TIMED, typename W, typename ...Args>
+    void printText(W &&write, uint32_t timestamp, const Args &...args) {
+        WriteStream<W> s{write};
+        if constexpr (TIMED)
+            coco::format<"[{}] ">(s, timestamp);
+        coco::format<F>(s, args...);
+    }
+} // namespace detail
+
+/// @brief Decode a binary log record into text
+/// @param strings Contents of the coco_binlog section
+/// @param data Received data that starts with a record
+/// @param out Output buffer for the text, gets clipped to size
+/// @param size Size of the output buffer
+/// @return Length of the text and length of the record. The record length is 0 if data does not contain a complete
+/// record. If the id is unknown or the length is larger than the record can be (e.g. corrupt data or start in the
+/// middle of a stream), one byte gets skipped without text so that the decoder resynchronizes instead of waiting for
+/// the length. Other invalid records are decoded as "<invalid binlog record>" so that decoding can continue
+ConvertedValue<int> decode(String strings, String data, char *out, int size);
+
+/// @brief Decode all complete records at the start of received data, e.g. after each byte from a serial port
+/// @param strings Contents of the coco_binlog section
+/// @param data Received data
+/// @param out Output buffer for the text of one record, gets clipped to size
+/// @param size Size of the output buffer
+/// @param write Function that takes (const char *text, int length) and gets called for each decoded record
+/// @param end True at the end of the data (e.g. end of file), then incomplete records can't complete anymore and get
+/// skipped byte by byte so that the following records get decoded
+/// @return Number of bytes used, remove them from the start of the received data
+template <typename W>
+int decodeAll(String strings, String data, char *out, int size, W write, bool end = false) {
+    int used = 0;
+    while (used < data.size()) {
+        auto result = decode(strings, data.substring(used), out, size);
+        if (result) {
+            if (result.value > 0)
+                write(out, result.value);
+            used += result.length;
+        } else if (end) {
+            ++used;
+        } else {
+            break;
+        }
+    }
+    return used;
+}
+
+#ifdef __ELF__
+/// @brief Get the contents of the coco_binlog section of the running program to decode records in the same process
+/// (e.g. in unit tests). Only call when COCO_BINLOG() is used, otherwise the section does not exist
+inline String section() {
+    return {detail::__start_coco_binlog, int(detail::__stop_coco_binlog - detail::__start_coco_binlog)};
+}
+#endif
+
+} // namespace binlog
+} // namespace coco
+
+
+#ifdef __ELF__
+
+/// @brief Write a binary log record using a write function, e.g. COCO_BINLOG_TO(usb.write, "x={}\n", x)
+/// @param write Function that takes (const char *data, int length)
+/// @param format Format string, see format()
+#define COCO_BINLOG_TO(write, format, ...) \
+    do { \
+        static constexpr decltype(coco::binlog::detail::entry<format>(__VA_ARGS__)) cocoBinlogEntry \
+            __attribute__((section("coco_binlog"), used)) = {}; \
+        coco::binlog::detail::print<false>(write, cocoBinlogEntry, 0 __VA_OPT__(,) __VA_ARGS__); \
+    } while (false)
+
+/// @brief Write a binary log record with a timestamp using a write function
+/// @param write Function that takes (const char *data, int length)
+/// @param timestamp Timestamp (32 bit), e.g. microseconds since start
+/// @param format Format string, see format()
+#define COCO_BINLOG_TIMED_TO(write, timestamp, format, ...) \
+    do { \
+        static constexpr decltype(coco::binlog::detail::entry<format>(__VA_ARGS__)) cocoBinlogEntry \
+            __attribute__((section("coco_binlog"), used)) = {}; \
+        coco::binlog::detail::print<true>(write, cocoBinlogEntry, timestamp __VA_OPT__(,) __VA_ARGS__); \
+    } while (false)
+
+#else
+
+#define COCO_BINLOG_TO(write, format, ...) \
+    coco::binlog::detail::printText<format, false>(write, 0 __VA_OPT__(,) __VA_ARGS__)
+
+#define COCO_BINLOG_TIMED_TO(write, timestamp, format, ...) \
+    coco::binlog::detail::printText<format, true>(write, timestamp __VA_OPT__(,) __VA_ARGS__)
+
+#endif
+
+/// @brief Write a binary log record to the debug console, e.g. COCO_BINLOG("x={} y={:x}\n", x, y)
+/// @param format Format string, see format()
+#define COCO_BINLOG(format, ...) \
+    COCO_BINLOG_TO(coco::binlog::detail::debugWrite, format __VA_OPT__(,) __VA_ARGS__)
+
+/// @brief Write a binary log record with a timestamp to the debug console
+/// @param timestamp Timestamp (32 bit), e.g. microseconds since start
+/// @param format Format string, see format()
+#define COCO_BINLOG_TIMED(timestamp, format, ...) \
+    COCO_BINLOG_TIMED_TO(coco::binlog::detail::debugWrite, timestamp, format __VA_OPT__(,) __VA_ARGS__)
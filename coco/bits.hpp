@@ -54,18 +54,19 @@ constexpr int popcount(T value) {
 }
 
 /// @brief Count number of set bits before a given bits starting at LSB.
+/// Uses a mask and std::popcount, see also Bitset::rank() for more than one word
 /// @tparam T Type of value
+/// @tparam T2 Type of bit
 /// @param value Value to count the bits in
 /// @param bit Bit up to which the set bits are counted. Must not be zero.
 /// @return Number of bits set before given bit
 template <typename T, typename T2>
 constexpr int popcountBefore(T value, T2 bit) {
-    int count = 0;
-    for (std::make_unsigned_t<T2> i = 1; i < std::make_unsigned_t<T2>(bit); i <<= 1) {
-        if (std::make_unsigned_t<T>(value) & i)
-            ++count;
-    }
-    return count;
+    using U = std::common_type_t<std::make_unsigned_t<T>, std::make_unsigned_t<T2>, unsigned>;
+
+    // mask of all bits below bit (rounded up to a power of two)
+    U mask = std::bit_ceil(U(std::make_unsigned_t<T2>(bit))) - 1;
+    return std::popcount(U(std::make_unsigned_t<T>(value)) & mask);
 }
 
 
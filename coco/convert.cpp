@@ -1,4 +1,15 @@
 #include "convert.hpp"
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 
 namespace coco {
@@ -6,105 +17,1257 @@ namespace coco {
 
 namespace detail {
 
+    // pairs of decimal digits "00" to "99" so that two digits get converted at a time
+    const char digitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    // value / 100 for value < 43699 using multiply and shift
+    inline uint32_t div100(uint32_t value) {
+        return (value * 5243) >> 19;
+    }
+
+    // value / 10000
+    inline uint32_t div10000(uint32_t value) {
+#if defined(__arm__) && !defined(__ARM_FEATURE_IDIV)
+        return detail::div10000Reciprocal(value);
+#else
+        return value / 10000;
+#endif
+    }
+
+    // write two digits of a value < 100
+    inline char *dec2(char *end, uint32_t value) {
+        char *it = end - 2;
+        it[0] = digitPairs[value * 2];
+        it[1] = digitPairs[value * 2 + 1];
+        return it;
+    }
+
+    // write four digits of a value < 10000
+    inline char *dec4(char *end, uint32_t value) {
+        uint32_t high = div100(value);
+        return dec2(dec2(end, value - high * 100), high);
+    }
+
     char *dec(char *end, uint32_t value, int digitCount) {
         char *it = end;
-        while (value > 0 || digitCount > 0) {
-            --it;
-            *it = '0' + value % 10;
-            value /= 10;
-            --digitCount;
+
+        // four digits at a time
+        while (value >= 10000) {
+            uint32_t high = div10000(value);
+            it = dec4(it, value - high * 10000);
+            value = high;
+        }
+
+        // remaining one to four digits
+        if (value >= 100) {
+            uint32_t high = div100(value);
+            it = dec2(it, value - high * 100);
+            value = high;
         }
+        if (value >= 10)
+            it = dec2(it, value);
+        else if (value > 0)
+            *--it = '0' + value;
+
+        // leading zeros
+        for (int i = int(end - it); i < digitCount; ++i)
+            *--it = '0';
         return it;
     }
 
     char *dec(char *end, uint64_t value, int digitCount) {
         char *it = end;
-        while (value > 0 || digitCount > 0) {
+
+        // split into 32 bit chunks of eight digits, at most two 64 bit divisions
+        while (value > 0xffffffff) {
+            uint64_t high = value / 100000000;
+            uint32_t low = uint32_t(value - high * 100000000);
+            uint32_t middle = div10000(low);
+            it = dec4(dec4(it, low - middle * 10000), middle);
+            value = high;
+        }
+        return dec(it, uint32_t(value), digitCount - int(end - it));
+    }
+
+
+    // powers of ten, exact up to 10^10 for float and up to 10^22 for double
+    const uint64_t pow10IntegerTable[20] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+        10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+        1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000,
+        10000000000000000000u};
+    const float pow10FloatTable[19] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+        1e11f, 1e12f, 1e13f, 1e14f, 1e15f, 1e16f, 1e17f, 1e18f};
+    const double pow10DoubleTable[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    // g = ceil(10^k * 2^-r) with r such that g has 64 bits (float) or 128 bits (high word first) for the shortest
+    // conversion using the Schubfach algorithm (https://github.com/c4f7fcce9cb06515/Schubfach) and for parsing,
+    // generated with Python: k = -31 to 45 for float and k = -342 to 324 for 128 bits
+    const uint64_t shortestFloatTable[77] = {
+        0x81ceb32c4b43fcf5, 0xa2425ff75e14fc32, 0xcad2f7f5359a3b3f,
+        0xfd87b5f28300ca0e, 0x9e74d1b791e07e49, 0xc612062576589ddb,
+        0xf79687aed3eec552, 0x9abe14cd44753b53, 0xc16d9a0095928a28,
+        0xf1c90080baf72cb2, 0x971da05074da7bef, 0xbce5086492111aeb,
+        0xec1e4a7db69561a6, 0x9392ee8e921d5d08, 0xb877aa3236a4b44a,
+        0xe69594bec44de15c, 0x901d7cf73ab0acda, 0xb424dc35095cd810,
+        0xe12e13424bb40e14, 0x8cbccc096f5088cc, 0xafebff0bcb24aaff,
+        0xdbe6fecebdedd5bf, 0x89705f4136b4a598, 0xabcc77118461cefd,
+        0xd6bf94d5e57a42bd, 0x8637bd05af6c69b6, 0xa7c5ac471b478424,
+        0xd1b71758e219652c, 0x83126e978d4fdf3c, 0xa3d70a3d70a3d70b,
+        0xcccccccccccccccd, 0x8000000000000000, 0xa000000000000000,
+        0xc800000000000000, 0xfa00000000000000, 0x9c40000000000000,
+        0xc350000000000000, 0xf424000000000000, 0x9896800000000000,
+        0xbebc200000000000, 0xee6b280000000000, 0x9502f90000000000,
+        0xba43b74000000000, 0xe8d4a51000000000, 0x9184e72a00000000,
+        0xb5e620f480000000, 0xe35fa931a0000000, 0x8e1bc9bf04000000,
+        0xb1a2bc2ec5000000, 0xde0b6b3a76400000, 0x8ac7230489e80000,
+        0xad78ebc5ac620000, 0xd8d726b7177a8000, 0x878678326eac9000,
+        0xa968163f0a57b400, 0xd3c21bcecceda100, 0x84595161401484a0,
+        0xa56fa5b99019a5c8, 0xcecb8f27f4200f3a, 0x813f3978f8940985,
+        0xa18f07d736b90be6, 0xc9f2c9cd04674edf, 0xfc6f7c4045812297,
+        0x9dc5ada82b70b59e, 0xc5371912364ce306, 0xf684df56c3e01bc7,
+        0x9a130b963a6c115d, 0xc097ce7bc90715b4, 0xf0bdc21abb48db21,
+        0x96769950b50d88f5, 0xbc143fa4e250eb32, 0xeb194f8e1ae525fe,
+        0x92efd1b8d0cf37bf, 0xb7abc627050305ae, 0xe596b7b0c643c71a,
+        0x8f7e32ce7bea5c70, 0xb35dbf821ae4f38c
+    };
+    const uint64_t pow10Table128[667][2] = {
+        {0xeef453d6923bd65a, 0x113faa2906a13b40}, {0x9558b4661b6565f8, 0x4ac7ca59a424c508},
+        {0xbaaee17fa23ebf76, 0x5d79bcf00d2df64a}, {0xe95a99df8ace6f53, 0xf4d82c2c107973dd},
+        {0x91d8a02bb6c10594, 0x79071b9b8a4be86a}, {0xb64ec836a47146f9, 0x9748e2826cdee285},
+        {0xe3e27a444d8d98b7, 0xfd1b1b2308169b26}, {0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f8},
+        {0xb208ef855c969f4f, 0xbdbd2d335e51a936}, {0xde8b2b66b3bc4723, 0xad2c788035e61383},
+        {0x8b16fb203055ac76, 0x4c3bcb5021afcc32}, {0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3e},
+        {0xd953e8624b85dd78, 0xd71d6dad34a2af0e}, {0x87d4713d6f33aa6b, 0x8672648c40e5ad69},
+        {0xa9c98d8ccb009506, 0x680efdaf511f18c3}, {0xd43bf0effdc0ba48, 0x0212bd1b2566def3},
+        {0x84a57695fe98746d, 0x014bb630f7604b58}, {0xa5ced43b7e3e9188, 0x419ea3bd35385e2e},
+        {0xcf42894a5dce35ea, 0x52064cac828675ba}, {0x818995ce7aa0e1b2, 0x7343efebd1940994},
+        {0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf9}, {0xca66fa129f9b60a6, 0xd41a26e077774ef7},
+        {0xfd00b897478238d0, 0x8920b098955522b5}, {0x9e20735e8cb16382, 0x55b46e5f5d5535b1},
+        {0xc5a890362fddbc62, 0xeb2189f734aa831e}, {0xf712b443bbd52b7b, 0xa5e9ec7501d523e5},
+        {0x9a6bb0aa55653b2d, 0x47b233c92125366f}, {0xc1069cd4eabe89f8, 0x999ec0bb696e840b},
+        {0xf148440a256e2c76, 0xc00670ea43ca250e}, {0x96cd2a865764dbca, 0x380406926a5e5729},
+        {0xbc807527ed3e12bc, 0xc605083704f5ecf3}, {0xeba09271e88d976b, 0xf7864a44c633682f},
+        {0x93445b8731587ea3, 0x7ab3ee6afbe0211e}, {0xb8157268fdae9e4c, 0x5960ea05bad82965},
+        {0xe61acf033d1a45df, 0x6fb92487298e33be}, {0x8fd0c16206306bab, 0xa5d3b6d479f8e057},
+        {0xb3c4f1ba87bc8696, 0x8f48a4899877186d}, {0xe0b62e2929aba83c, 0x331acdabfe94de88},
+        {0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b15}, {0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dda},
+        {0xdb71e91432b1a24a, 0xc9e82cd9f69d6151}, {0x892731ac9faf056e, 0xbe311c083a225cd3},
+        {0xab70fe17c79ac6ca, 0x6dbd630a48aaf407}, {0xd64d3d9db981787d, 0x092cbbccdad5b109},
+        {0x85f0468293f0eb4e, 0x25bbf56008c58ea6}, {0xa76c582338ed2621, 0xaf2af2b80af6f24f},
+        {0xd1476e2c07286faa, 0x1af5af660db4aee2}, {0x82cca4db847945ca, 0x50d98d9fc890ed4e},
+        {0xa37fce126597973c, 0xe50ff107bab528a1}, {0xcc5fc196fefd7d0c, 0x1e53ed49a96272c9},
+        {0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7b}, {0x9faacf3df73609b1, 0x77b191618c54e9ad},
+        {0xc795830d75038c1d, 0xd59df5b9ef6a2418}, {0xf97ae3d0d2446f25, 0x4b0573286b44ad1e},
+        {0x9becce62836ac577, 0x4ee367f9430aec33}, {0xc2e801fb244576d5, 0x229c41f793cda740},
+        {0xf3a20279ed56d48a, 0x6b43527578c11110}, {0x9845418c345644d6, 0x830a13896b78aaaa},
+        {0xbe5691ef416bd60c, 0x23cc986bc656d554}, {0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa9},
+        {0x94b3a202eb1c3f39, 0x7bf7d71432f3d6aa}, {0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc54},
+        {0xe858ad248f5c22c9, 0xd1b3400f8f9cff69}, {0x91376c36d99995be, 0x23100809b9c21fa2},
+        {0xb58547448ffffb2d, 0xabd40a0c2832a78b}, {0xe2e69915b3fff9f9, 0x16c90c8f323f516d},
+        {0x8dd01fad907ffc3b, 0xae3da7d97f6792e4}, {0xb1442798f49ffb4a, 0x99cd11cfdf41779d},
+        {0xdd95317f31c7fa1d, 0x40405643d711d584}, {0x8a7d3eef7f1cfc52, 0x482835ea666b2573},
+        {0xad1c8eab5ee43b66, 0xda3243650005eed0}, {0xd863b256369d4a40, 0x90bed43e40076a83},
+        {0x873e4f75e2224e68, 0x5a7744a6e804a292}, {0xa90de3535aaae202, 0x711515d0a205cb37},
+        {0xd3515c2831559a83, 0x0d5a5b44ca873e04}, {0x8412d9991ed58091, 0xe858790afe9486c3},
+        {0xa5178fff668ae0b6, 0x626e974dbe39a873}, {0xce5d73ff402d98e3, 0xfb0a3d212dc81290},
+        {0x80fa687f881c7f8e, 0x7ce66634bc9d0b9a}, {0xa139029f6a239f72, 0x1c1fffc1ebc44e81},
+        {0xc987434744ac874e, 0xa327ffb266b56221}, {0xfbe9141915d7a922, 0x4bf1ff9f0062baa9},
+        {0x9d71ac8fada6c9b5, 0x6f773fc3603db4aa}, {0xc4ce17b399107c22, 0xcb550fb4384d21d4},
+        {0xf6019da07f549b2b, 0x7e2a53a146606a49}, {0x99c102844f94e0fb, 0x2eda7444cbfc426e},
+        {0xc0314325637a1939, 0xfa911155fefb5309}, {0xf03d93eebc589f88, 0x793555ab7eba27cb},
+        {0x96267c7535b763b5, 0x4bc1558b2f3458df}, {0xbbb01b9283253ca2, 0x9eb1aaedfb016f17},
+        {0xea9c227723ee8bcb, 0x465e15a979c1cadd}, {0x92a1958a7675175f, 0x0bfacd89ec191eca},
+        {0xb749faed14125d36, 0xcef980ec671f667c}, {0xe51c79a85916f484, 0x82b7e12780e7401b},
+        {0x8f31cc0937ae58d2, 0xd1b2ecb8b0908811}, {0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa16},
+        {0xdfbdcece67006ac9, 0x67a791e093e1d49b}, {0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e1},
+        {0xaecc49914078536d, 0x58fae9f773886e19}, {0xda7f5bf590966848, 0xaf39a475506a899f},
+        {0x888f99797a5e012d, 0x6d8406c952429604}, {0xaab37fd7d8f58178, 0xc8e5087ba6d33b84},
+        {0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a65}, {0x855c3be0a17fcd26, 0x5cf2eea09a550680},
+        {0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481f}, {0xd0601d8efc57b08b, 0xf13b94daf124da27},
+        {0x823c12795db6ce57, 0x76c53d08d6b70859}, {0xa2cb1717b52481ed, 0x54768c4b0c64ca6f},
+        {0xcb7ddcdda26da268, 0xa9942f5dcf7dfd0a}, {0xfe5d54150b090b02, 0xd3f93b35435d7c4d},
+        {0x9efa548d26e5a6e1, 0xc47bc5014a1a6db0}, {0xc6b8e9b0709f109a, 0x359ab6419ca1091c},
+        {0xf867241c8cc6d4c0, 0xc30163d203c94b63}, {0x9b407691d7fc44f8, 0x79e0de63425dcf1e},
+        {0xc21094364dfb5636, 0x985915fc12f542e5}, {0xf294b943e17a2bc4, 0x3e6f5b7b17b2939e},
+        {0x979cf3ca6cec5b5a, 0xa705992ceecf9c43}, {0xbd8430bd08277231, 0x50c6ff782a838354},
+        {0xece53cec4a314ebd, 0xa4f8bf5635246429}, {0x940f4613ae5ed136, 0x871b7795e136be9a},
+        {0xb913179899f68584, 0x28e2557b59846e40}, {0xe757dd7ec07426e5, 0x331aeada2fe589d0},
+        {0x9096ea6f3848984f, 0x3ff0d2c85def7622}, {0xb4bca50b065abe63, 0x0fed077a756b53aa},
+        {0xe1ebce4dc7f16dfb, 0xd3e8495912c62895}, {0x8d3360f09cf6e4bd, 0x64712dd7abbbd95d},
+        {0xb080392cc4349dec, 0xbd8d794d96aacfb4}, {0xdca04777f541c567, 0xecf0d7a0fc5583a1},
+        {0x89e42caaf9491b60, 0xf41686c49db57245}, {0xac5d37d5b79b6239, 0x311c2875c522ced6},
+        {0xd77485cb25823ac7, 0x7d633293366b828c}, {0x86a8d39ef77164bc, 0xae5dff9c02033198},
+        {0xa8530886b54dbdeb, 0xd9f57f830283fdfd}, {0xd267caa862a12d66, 0xd072df63c324fd7c},
+        {0x8380dea93da4bc60, 0x4247cb9e59f71e6e}, {0xa46116538d0deb78, 0x52d9be85f074e609},
+        {0xcd795be870516656, 0x67902e276c921f8c}, {0x806bd9714632dff6, 0x00ba1cd8a3db53b7},
+        {0xa086cfcd97bf97f3, 0x80e8a40eccd228a5}, {0xc8a883c0fdaf7df0, 0x6122cd128006b2ce},
+        {0xfad2a4b13d1b5d6c, 0x796b805720085f82}, {0x9cc3a6eec6311a63, 0xcbe3303674053bb1},
+        {0xc3f490aa77bd60fc, 0xbedbfc4411068a9d}, {0xf4f1b4d515acb93b, 0xee92fb5515482d45},
+        {0x991711052d8bf3c5, 0x751bdd152d4d1c4b}, {0xbf5cd54678eef0b6, 0xd262d45a78a0635e},
+        {0xef340a98172aace4, 0x86fb897116c87c35}, {0x9580869f0e7aac0e, 0xd45d35e6ae3d4da1},
+        {0xbae0a846d2195712, 0x8974836059cca10a}, {0xe998d258869facd7, 0x2bd1a438703fc94c},
+        {0x91ff83775423cc06, 0x7b6306a34627ddd0}, {0xb67f6455292cbf08, 0x1a3bc84c17b1d543},
+        {0xe41f3d6a7377eeca, 0x20caba5f1d9e4a94}, {0x8e938662882af53e, 0x547eb47b7282ee9d},
+        {0xb23867fb2a35b28d, 0xe99e619a4f23aa44}, {0xdec681f9f4c31f31, 0x6405fa00e2ec94d5},
+        {0x8b3c113c38f9f37e, 0xde83bc408dd3dd05}, {0xae0b158b4738705e, 0x9624ab50b148d446},
+        {0xd98ddaee19068c76, 0x3badd624dd9b0958}, {0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d7},
+        {0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4d}, {0xd47487cc8470652b, 0x7647c32000696720},
+        {0x84c8d4dfd2c63f3b, 0x29ecd9f40041e074}, {0xa5fb0a17c777cf09, 0xf468107100525891},
+        {0xcf79cc9db955c2cc, 0x7182148d4066eeb5}, {0x81ac1fe293d599bf, 0xc6f14cd848405531},
+        {0xa21727db38cb002f, 0xb8ada00e5a506a7d}, {0xca9cf1d206fdc03b, 0xa6d90811f0e4851d},
+        {0xfd442e4688bd304a, 0x908f4a166d1da664}, {0x9e4a9cec15763e2e, 0x9a598e4e043287ff},
+        {0xc5dd44271ad3cdba, 0x40eff1e1853f29fe}, {0xf7549530e188c128, 0xd12bee59e68ef47d},
+        {0x9a94dd3e8cf578b9, 0x82bb74f8301958cf}, {0xc13a148e3032d6e7, 0xe36a52363c1faf02},
+        {0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac2}, {0x96f5600f15a7b7e5, 0x29ab103a5ef8c0ba},
+        {0xbcb2b812db11a5de, 0x7415d448f6b6f0e8}, {0xebdf661791d60f56, 0x111b495b3464ad22},
+        {0x936b9fcebb25c995, 0xcab10dd900beec35}, {0xb84687c269ef3bfb, 0x3d5d514f40eea743},
+        {0xe65829b3046b0afa, 0x0cb4a5a3112a5113}, {0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ac},
+        {0xb3f4e093db73a093, 0x59ed216765690f57}, {0xe0f218b8d25088b8, 0x306869c13ec3532d},
+        {0x8c974f7383725573, 0x1e414218c73a13fc}, {0xafbd2350644eeacf, 0xe5d1929ef90898fb},
+        {0xdbac6c247d62a583, 0xdf45f746b74abf3a}, {0x894bc396ce5da772, 0x6b8bba8c328eb784},
+        {0xab9eb47c81f5114f, 0x066ea92f3f326565}, {0xd686619ba27255a2, 0xc80a537b0efefebe},
+        {0x8613fd0145877585, 0xbd06742ce95f5f37}, {0xa798fc4196e952e7, 0x2c48113823b73705},
+        {0xd17f3b51fca3a7a0, 0xf75a15862ca504c6}, {0x82ef85133de648c4, 0x9a984d73dbe722fc},
+        {0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebbb}, {0xcc963fee10b7d1b3, 0x318df905079926a9},
+        {0xffbbcfe994e5c61f, 0xfdf17746497f7053}, {0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa634},
+        {0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc1}, {0xf9bd690a1b68637b, 0x3dfdce7aa3c673b1},
+        {0x9c1661a651213e2d, 0x06bea10ca65c084f}, {0xc31bfa0fe5698db8, 0x486e494fcff30a63},
+        {0xf3e2f893dec3f126, 0x5a89dba3c3efccfb}, {0x986ddb5c6b3a76b7, 0xf89629465a75e01d},
+        {0xbe89523386091465, 0xf6bbb397f1135824}, {0xee2ba6c0678b597f, 0x746aa07ded582e2d},
+        {0x94db483840b717ef, 0xa8c2a44eb4571cdd}, {0xba121a4650e4ddeb, 0x92f34d62616ce414},
+        {0xe896a0d7e51e1566, 0x77b020baf9c81d18}, {0x915e2486ef32cd60, 0x0ace1474dc1d122f},
+        {0xb5b5ada8aaff80b8, 0x0d819992132456bb}, {0xe3231912d5bf60e6, 0x10e1fff697ed6c6a},
+        {0x8df5efabc5979c8f, 0xca8d3ffa1ef463c2}, {0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb3},
+        {0xddd0467c64bce4a0, 0xac7cb3f6d05ddbdf}, {0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96c},
+        {0xad4ab7112eb3929d, 0x86c16c98d2c953c7}, {0xd89d64d57a607744, 0xe871c7bf077ba8b8},
+        {0x87625f056c7c4a8b, 0x11471cd764ad4973}, {0xa93af6c6c79b5d2d, 0xd598e40d3dd89bd0},
+        {0xd389b47879823479, 0x4aff1d108d4ec2c4}, {0x843610cb4bf160cb, 0xcedf722a585139bb},
+        {0xa54394fe1eedb8fe, 0xc2974eb4ee658829}, {0xce947a3da6a9273e, 0x733d226229feea33},
+        {0x811ccc668829b887, 0x0806357d5a3f5260}, {0xa163ff802a3426a8, 0xca07c2dcb0cf26f8},
+        {0xc9bcff6034c13052, 0xfc89b393dd02f0b6}, {0xfc2c3f3841f17c67, 0xbbac2078d443ace3},
+        {0x9d9ba7832936edc0, 0xd54b944b84aa4c0e}, {0xc5029163f384a931, 0x0a9e795e65d4df12},
+        {0xf64335bcf065d37d, 0x4d4617b5ff4a16d6}, {0x99ea0196163fa42e, 0x504bced1bf8e4e46},
+        {0xc06481fb9bcf8d39, 0xe45ec2862f71e1d7}, {0xf07da27a82c37088, 0x5d767327bb4e5a4d},
+        {0x964e858c91ba2655, 0x3a6a07f8d510f870}, {0xbbe226efb628afea, 0x890489f70a55368c},
+        {0xeadab0aba3b2dbe5, 0x2b45ac74ccea842f}, {0x92c8ae6b464fc96f, 0x3b0b8bc90012929e},
+        {0xb77ada0617e3bbcb, 0x09ce6ebb40173745}, {0xe55990879ddcaabd, 0xcc420a6a101d0516},
+        {0x8f57fa54c2a9eab6, 0x9fa946824a12232e}, {0xb32df8e9f3546564, 0x47939822dc96abfa},
+        {0xdff9772470297ebd, 0x59787e2b93bc56f8}, {0x8bfbea76c619ef36, 0x57eb4edb3c55b65b},
+        {0xaefae51477a06b03, 0xede622920b6b23f2}, {0xdab99e59958885c4, 0xe95fab368e45ecee},
+        {0x88b402f7fd75539b, 0x11dbcb0218ebb415}, {0xaae103b5fcd2a881, 0xd652bdc29f26a11a},
+        {0xd59944a37c0752a2, 0x4be76d3346f04960}, {0x857fcae62d8493a5, 0x6f70a4400c562ddc},
+        {0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb953}, {0xd097ad07a71f26b2, 0x7e2000a41346a7a8},
+        {0x825ecc24c873782f, 0x8ed400668c0c28c9}, {0xa2f67f2dfa90563b, 0x728900802f0f32fb},
+        {0xcbb41ef979346bca, 0x4f2b40a03ad2ffba}, {0xfea126b7d78186bc, 0xe2f610c84987bfa9},
+        {0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7ca}, {0xc6ede63fa05d3143, 0x91503d1c79720dbc},
+        {0xf8a95fcf88747d94, 0x75a44c6397ce912b}, {0x9b69dbe1b548ce7c, 0xc986afbe3ee11abb},
+        {0xc24452da229b021b, 0xfbe85badce996169}, {0xf2d56790ab41c2a2, 0xfae27299423fb9c4},
+        {0x97c560ba6b0919a5, 0xdccd879fc967d41b}, {0xbdb6b8e905cb600f, 0x5400e987bbc1c921},
+        {0xed246723473e3813, 0x290123e9aab23b69}, {0x9436c0760c86e30b, 0xf9a0b6720aaf6522},
+        {0xb94470938fa89bce, 0xf808e40e8d5b3e6a}, {0xe7958cb87392c2c2, 0xb60b1d1230b20e05},
+        {0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c3}, {0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af4},
+        {0xe2280b6c20dd5232, 0x25c6da63c38de1b1}, {0x8d590723948a535f, 0x579c487e5a38ad0f},
+        {0xb0af48ec79ace837, 0x2d835a9df0c6d852}, {0xdcdb1b2798182244, 0xf8e431456cf88e66},
+        {0x8a08f0f8bf0f156b, 0x1b8e9ecb641b5900}, {0xac8b2d36eed2dac5, 0xe272467e3d222f40},
+        {0xd7adf884aa879177, 0x5b0ed81dcc6abb10}, {0x86ccbb52ea94baea, 0x98e947129fc2b4ea},
+        {0xa87fea27a539e9a5, 0x3f2398d747b36225}, {0xd29fe4b18e88640e, 0x8eec7f0d19a03aae},
+        {0x83a3eeeef9153e89, 0x1953cf68300424ad}, {0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd8},
+        {0xcdb02555653131b6, 0x3792f412cb06794e}, {0x808e17555f3ebf11, 0xe2bbd88bbee40bd1},
+        {0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec5}, {0xc8de047564d20a8b, 0xf245825a5a445276},
+        {0xfb158592be068d2e, 0xeed6e2f0f0d56713}, {0x9ced737bb6c4183d, 0x55464dd69685606c},
+        {0xc428d05aa4751e4c, 0xaa97e14c3c26b887}, {0xf53304714d9265df, 0xd53dd99f4b3066a9},
+        {0x993fe2c6d07b7fab, 0xe546a8038efe402a}, {0xbf8fdb78849a5f96, 0xde98520472bdd034},
+        {0xef73d256a5c0f77c, 0x963e66858f6d4441}, {0x95a8637627989aad, 0xdde7001379a44aa9},
+        {0xbb127c53b17ec159, 0x5560c018580d5d53}, {0xe9d71b689dde71af, 0xaab8f01e6e10b4a7},
+        {0x9226712162ab070d, 0xcab3961304ca70e9}, {0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d23},
+        {0xe45c10c42a2b3b05, 0x8cb89a7db77c506b}, {0x8eb98a7a9a5b04e3, 0x77f3608e92adb243},
+        {0xb267ed1940f1c61c, 0x55f038b237591ed4}, {0xdf01e85f912e37a3, 0x6b6c46dec52f6689},
+        {0x8b61313bbabce2c6, 0x2323ac4b3b3da016}, {0xae397d8aa96c1b77, 0xabec975e0a0d081b},
+        {0xd9c7dced53c72255, 0x96e7bd358c904a22}, {0x881cea14545c7575, 0x7e50d64177da2e55},
+        {0xaa242499697392d2, 0xdde50bd1d5d0b9ea}, {0xd4ad2dbfc3d07787, 0x955e4ec64b44e865},
+        {0x84ec3c97da624ab4, 0xbd5af13bef0b113f}, {0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58f},
+        {0xcfb11ead453994ba, 0x67de18eda5814af3}, {0x81ceb32c4b43fcf4, 0x80eacf948770ced8},
+        {0xa2425ff75e14fc31, 0xa1258379a94d028e}, {0xcad2f7f5359a3b3e, 0x096ee45813a04331},
+        {0xfd87b5f28300ca0d, 0x8bca9d6e188853fd}, {0x9e74d1b791e07e48, 0x775ea264cf55347e},
+        {0xc612062576589dda, 0x95364afe032a819e}, {0xf79687aed3eec551, 0x3a83ddbd83f52205},
+        {0x9abe14cd44753b52, 0xc4926a9672793543}, {0xc16d9a0095928a27, 0x75b7053c0f178294},
+        {0xf1c90080baf72cb1, 0x5324c68b12dd6339}, {0x971da05074da7bee, 0xd3f6fc16ebca5e04},
+        {0xbce5086492111aea, 0x88f4bb1ca6bcf585}, {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6},
+        {0x9392ee8e921d5d07, 0x3aff322e62439fd0}, {0xb877aa3236a4b449, 0x09befeb9fad487c3},
+        {0xe69594bec44de15b, 0x4c2ebe687989a9b4}, {0x901d7cf73ab0acd9, 0x0f9d37014bf60a11},
+        {0xb424dc35095cd80f, 0x538484c19ef38c95}, {0xe12e13424bb40e13, 0x2865a5f206b06fba},
+        {0x8cbccc096f5088cb, 0xf93f87b7442e45d4}, {0xafebff0bcb24aafe, 0xf78f69a51539d749},
+        {0xdbe6fecebdedd5be, 0xb573440e5a884d1c}, {0x89705f4136b4a597, 0x31680a88f8953031},
+        {0xabcc77118461cefc, 0xfdc20d2b36ba7c3e}, {0xd6bf94d5e57a42bc, 0x3d32907604691b4d},
+        {0x8637bd05af6c69b5, 0xa63f9a49c2c1b110}, {0xa7c5ac471b478423, 0x0fcf80dc33721d54},
+        {0xd1b71758e219652b, 0xd3c36113404ea4a9}, {0x83126e978d4fdf3b, 0x645a1cac083126ea},
+        {0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4}, {0xcccccccccccccccc, 0xcccccccccccccccd},
+        {0x8000000000000000, 0x0000000000000000}, {0xa000000000000000, 0x0000000000000000},
+        {0xc800000000000000, 0x0000000000000000}, {0xfa00000000000000, 0x0000000000000000},
+        {0x9c40000000000000, 0x0000000000000000}, {0xc350000000000000, 0x0000000000000000},
+        {0xf424000000000000, 0x0000000000000000}, {0x9896800000000000, 0x0000000000000000},
+        {0xbebc200000000000, 0x0000000000000000}, {0xee6b280000000000, 0x0000000000000000},
+        {0x9502f90000000000, 0x0000000000000000}, {0xba43b74000000000, 0x0000000000000000},
+        {0xe8d4a51000000000, 0x0000000000000000}, {0x9184e72a00000000, 0x0000000000000000},
+        {0xb5e620f480000000, 0x0000000000000000}, {0xe35fa931a0000000, 0x0000000000000000},
+        {0x8e1bc9bf04000000, 0x0000000000000000}, {0xb1a2bc2ec5000000, 0x0000000000000000},
+        {0xde0b6b3a76400000, 0x0000000000000000}, {0x8ac7230489e80000, 0x0000000000000000},
+        {0xad78ebc5ac620000, 0x0000000000000000}, {0xd8d726b7177a8000, 0x0000000000000000},
+        {0x878678326eac9000, 0x0000000000000000}, {0xa968163f0a57b400, 0x0000000000000000},
+        {0xd3c21bcecceda100, 0x0000000000000000}, {0x84595161401484a0, 0x0000000000000000},
+        {0xa56fa5b99019a5c8, 0x0000000000000000}, {0xcecb8f27f4200f3a, 0x0000000000000000},
+        {0x813f3978f8940984, 0x4000000000000000}, {0xa18f07d736b90be5, 0x5000000000000000},
+        {0xc9f2c9cd04674ede, 0xa400000000000000}, {0xfc6f7c4045812296, 0x4d00000000000000},
+        {0x9dc5ada82b70b59d, 0xf020000000000000}, {0xc5371912364ce305, 0x6c28000000000000},
+        {0xf684df56c3e01bc6, 0xc732000000000000}, {0x9a130b963a6c115c, 0x3c7f400000000000},
+        {0xc097ce7bc90715b3, 0x4b9f100000000000}, {0xf0bdc21abb48db20, 0x1e86d40000000000},
+        {0x96769950b50d88f4, 0x1314448000000000}, {0xbc143fa4e250eb31, 0x17d955a000000000},
+        {0xeb194f8e1ae525fd, 0x5dcfab0800000000}, {0x92efd1b8d0cf37be, 0x5aa1cae500000000},
+        {0xb7abc627050305ad, 0xf14a3d9e40000000}, {0xe596b7b0c643c719, 0x6d9ccd05d0000000},
+        {0x8f7e32ce7bea5c6f, 0xe4820023a2000000}, {0xb35dbf821ae4f38b, 0xdda2802c8a800000},
+        {0xe0352f62a19e306e, 0xd50b2037ad200000}, {0x8c213d9da502de45, 0x4526f422cc340000},
+        {0xaf298d050e4395d6, 0x9670b12b7f410000}, {0xdaf3f04651d47b4c, 0x3c0cdd765f114000},
+        {0x88d8762bf324cd0f, 0xa5880a69fb6ac800}, {0xab0e93b6efee0053, 0x8eea0d047a457a00},
+        {0xd5d238a4abe98068, 0x72a4904598d6d880}, {0x85a36366eb71f041, 0x47a6da2b7f864750},
+        {0xa70c3c40a64e6c51, 0x999090b65f67d924}, {0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d},
+        {0x82818f1281ed449f, 0xbff8f10e7a8921a5}, {0xa321f2d7226895c7, 0xaff72d52192b6a0e},
+        {0xcbea6f8ceb02bb39, 0x9bf4f8a69f764491}, {0xfee50b7025c36a08, 0x02f236d04753d5b5},
+        {0x9f4f2726179a2245, 0x01d762422c946591}, {0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef6},
+        {0xf8ebad2b84e0d58b, 0xd2e0898765a7deb3}, {0x9b934c3b330c8577, 0x63cc55f49f88eb30},
+        {0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fc}, {0xf316271c7fc3908a, 0x8bef464e3945ef7b},
+        {0x97edd871cfda3a56, 0x97758bf0e3cbb5ad}, {0xbde94e8e43d0c8ec, 0x3d52eeed1cbea318},
+        {0xed63a231d4c4fb27, 0x4ca7aaa863ee4bde}, {0x945e455f24fb1cf8, 0x8fe8caa93e74ef6b},
+        {0xb975d6b6ee39e436, 0xb3e2fd538e122b45}, {0xe7d34c64a9c85d44, 0x60dbbca87196b617},
+        {0x90e40fbeea1d3a4a, 0xbc8955e946fe31ce}, {0xb51d13aea4a488dd, 0x6babab6398bdbe42},
+        {0xe264589a4dcdab14, 0xc696963c7eed2dd2}, {0x8d7eb76070a08aec, 0xfc1e1de5cf543ca3},
+        {0xb0de65388cc8ada8, 0x3b25a55f43294bcc}, {0xdd15fe86affad912, 0x49ef0eb713f39ebf},
+        {0x8a2dbf142dfcc7ab, 0x6e3569326c784338}, {0xacb92ed9397bf996, 0x49c2c37f07965405},
+        {0xd7e77a8f87daf7fb, 0xdc33745ec97be907}, {0x86f0ac99b4e8dafd, 0x69a028bb3ded71a4},
+        {0xa8acd7c0222311bc, 0xc40832ea0d68ce0d}, {0xd2d80db02aabd62b, 0xf50a3fa490c30191},
+        {0x83c7088e1aab65db, 0x792667c6da79e0fb}, {0xa4b8cab1a1563f52, 0x577001b891185939},
+        {0xcde6fd5e09abcf26, 0xed4c0226b55e6f87}, {0x80b05e5ac60b6178, 0x544f8158315b05b5},
+        {0xa0dc75f1778e39d6, 0x696361ae3db1c722}, {0xc913936dd571c84c, 0x03bc3a19cd1e38ea},
+        {0xfb5878494ace3a5f, 0x04ab48a04065c724}, {0x9d174b2dcec0e47b, 0x62eb0d64283f9c77},
+        {0xc45d1df942711d9a, 0x3ba5d0bd324f8395}, {0xf5746577930d6500, 0xca8f44ec7ee3647a},
+        {0x9968bf6abbe85f20, 0x7e998b13cf4e1ecc}, {0xbfc2ef456ae276e8, 0x9e3fedd8c321a67f},
+        {0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101f}, {0x95d04aee3b80ece5, 0xbba1f1d158724a13},
+        {0xbb445da9ca61281f, 0x2a8a6e45ae8edc98}, {0xea1575143cf97226, 0xf52d09d71a3293be},
+        {0x924d692ca61be758, 0x593c2626705f9c57}, {0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836d},
+        {0xe498f455c38b997a, 0x0b6dfb9c0f956448}, {0x8edf98b59a373fec, 0x4724bd4189bd5ead},
+        {0xb2977ee300c50fe7, 0x58edec91ec2cb658}, {0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ee},
+        {0x8b865b215899f46c, 0xbd79e0d20082ee75}, {0xae67f1e9aec07187, 0xecd8590680a3aa12},
+        {0xda01ee641a708de9, 0xe80e6f4820cc9496}, {0x884134fe908658b2, 0x3109058d147fdcde},
+        {0xaa51823e34a7eede, 0xbd4b46f0599fd416}, {0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91b},
+        {0x850fadc09923329e, 0x03e2cf6bc604ddb1}, {0xa6539930bf6bff45, 0x84db8346b786151d},
+        {0xcfe87f7cef46ff16, 0xe612641865679a64}, {0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07f},
+        {0xa26da3999aef7749, 0xe3be5e330f38f09e}, {0xcb090c8001ab551c, 0x5cadf5bfd3072cc6},
+        {0xfdcb4fa002162a63, 0x73d9732fc7c8f7f7}, {0x9e9f11c4014dda7e, 0x2867e7fddcdd9afb},
+        {0xc646d63501a1511d, 0xb281e1fd541501b9}, {0xf7d88bc24209a565, 0x1f225a7ca91a4227},
+        {0x9ae757596946075f, 0x3375788de9b06959}, {0xc1a12d2fc3978937, 0x0052d6b1641c83af},
+        {0xf209787bb47d6b84, 0xc0678c5dbd23a49b}, {0x9745eb4d50ce6332, 0xf840b7ba963646e1},
+        {0xbd176620a501fbff, 0xb650e5a93bc3d899}, {0xec5d3fa8ce427aff, 0xa3e51f138ab4cebf},
+        {0x93ba47c980e98cdf, 0xc66f336c36b10138}, {0xb8a8d9bbe123f017, 0xb80b0047445d4185},
+        {0xe6d3102ad96cec1d, 0xa60dc059157491e6}, {0x9043ea1ac7e41392, 0x87c89837ad68db30},
+        {0xb454e4a179dd1877, 0x29babe4598c311fc}, {0xe16a1dc9d8545e94, 0xf4296dd6fef3d67b},
+        {0x8ce2529e2734bb1d, 0x1899e4a65f58660d}, {0xb01ae745b101e9e4, 0x5ec05dcff72e7f90},
+        {0xdc21a1171d42645d, 0x76707543f4fa1f74}, {0x899504ae72497eba, 0x6a06494a791c53a9},
+        {0xabfa45da0edbde69, 0x0487db9d17636893}, {0xd6f8d7509292d603, 0x45a9d2845d3c42b7},
+        {0x865b86925b9bc5c2, 0x0b8a2392ba45a9b3}, {0xa7f26836f282b732, 0x8e6cac7768d7141f},
+        {0xd1ef0244af2364ff, 0x3207d795430cd927}, {0x8335616aed761f1f, 0x7f44e6bd49e807b9},
+        {0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a7}, {0xcd036837130890a1, 0x36dba887c37a8c10},
+        {0x802221226be55a64, 0xc2494954da2c978a}, {0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6d},
+        {0xc83553c5c8965d3d, 0x6f92829494e5acc8}, {0xfa42a8b73abbf48c, 0xcb772339ba1f17fa},
+        {0x9c69a97284b578d7, 0xff2a760414536efc}, {0xc38413cf25e2d70d, 0xfef5138519684abb},
+        {0xf46518c2ef5b8cd1, 0x7eb258665fc25d6a}, {0x98bf2f79d5993802, 0xef2f773ffbd97a62},
+        {0xbeeefb584aff8603, 0xaafb550ffacfd8fb}, {0xeeaaba2e5dbf6784, 0x95ba2a53f983cf39},
+        {0x952ab45cfa97a0b2, 0xdd945a747bf26184}, {0xba756174393d88df, 0x94f971119aeef9e5},
+        {0xe912b9d1478ceb17, 0x7a37cd5601aab85e}, {0x91abb422ccb812ee, 0xac62e055c10ab33b},
+        {0xb616a12b7fe617aa, 0x577b986b314d600a}, {0xe39c49765fdf9d94, 0xed5a7e85fda0b80c},
+        {0x8e41ade9fbebc27d, 0x14588f13be847308}, {0xb1d219647ae6b31c, 0x596eb2d8ae258fc9},
+        {0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bc}, {0x8aec23d680043bee, 0x25de7bb9480d5855},
+        {0xada72ccc20054ae9, 0xaf561aa79a10ae6b}, {0xd910f7ff28069da4, 0x1b2ba1518094da05},
+        {0x87aa9aff79042286, 0x90fb44d2f05d0843}, {0xa99541bf57452b28, 0x353a1607ac744a54},
+        {0xd3fa922f2d1675f2, 0x42889b8997915ce9}, {0x847c9b5d7c2e09b7, 0x69956135febada12},
+        {0xa59bc234db398c25, 0x43fab9837e699096}, {0xcf02b2c21207ef2e, 0x94f967e45e03f4bc},
+        {0x8161afb94b44f57d, 0x1d1be0eebac278f6}, {0xa1ba1ba79e1632dc, 0x6462d92a69731733},
+        {0xca28a291859bbf93, 0x7d7b8f7503cfdcff}, {0xfcb2cb35e702af78, 0x5cda735244c3d43f},
+        {0x9defbf01b061adab, 0x3a0888136afa64a8}, {0xc56baec21c7a1916, 0x088aaa1845b8fdd1},
+        {0xf6c69a72a3989f5b, 0x8aad549e57273d46}, {0x9a3c2087a63f6399, 0x36ac54e2f678864c},
+        {0xc0cb28a98fcf3c7f, 0x84576a1bb416a7de}, {0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d6},
+        {0x969eb7c47859e743, 0x9f644ae5a4b1b326}, {0xbc4665b596706114, 0x873d5d9f0dde1fef},
+        {0xeb57ff22fc0c7959, 0xa90cb506d155a7eb}, {0x9316ff75dd87cbd8, 0x09a7f12442d588f3},
+        {0xb7dcbf5354e9bece, 0x0c11ed6d538aeb30}, {0xe5d3ef282a242e81, 0x8f1668c8a86da5fb},
+        {0x8fa475791a569d10, 0xf96e017d694487bd}, {0xb38d92d760ec4455, 0x37c981dcc395a9ad},
+        {0xe070f78d3927556a, 0x85bbe253f47b1418}, {0x8c469ab843b89562, 0x93956d7478ccec8f},
+        {0xaf58416654a6babb, 0x387ac8d1970027b3}, {0xdb2e51bfe9d0696a, 0x06997b05fcc0319f},
+        {0x88fcf317f22241e2, 0x441fece3bdf81f04}, {0xab3c2fddeeaad25a, 0xd527e81cad7626c4},
+        {0xd60b3bd56a5586f1, 0x8a71e223d8d3b075}, {0x85c7056562757456, 0xf6872d5667844e4a},
+        {0xa738c6bebb12d16c, 0xb428f8ac016561dc}, {0xd106f86e69d785c7, 0xe13336d701beba53},
+        {0x82a45b450226b39c, 0xecc0024661173474}, {0xa34d721642b06084, 0x27f002d7f95d0191},
+        {0xcc20ce9bd35c78a5, 0x31ec038df7b441f5}, {0xff290242c83396ce, 0x7e67047175a15272},
+        {0x9f79a169bd203e41, 0x0f0062c6e984d387}, {0xc75809c42c684dd1, 0x52c07b78a3e60869},
+        {0xf92e0c3537826145, 0xa7709a56ccdf8a83}, {0x9bbcc7a142b17ccb, 0x88a66076400bb692},
+        {0xc2abf989935ddbfe, 0x6acff893d00ea436}, {0xf356f7ebf83552fe, 0x0583f6b8c4124d44},
+        {0x98165af37b2153de, 0xc3727a337a8b704b}, {0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5d},
+        {0xeda2ee1c7064130c, 0x1162def06f79df74}, {0x9485d4d1c63e8be7, 0x8addcb5645ac2ba9},
+        {0xb9a74a0637ce2ee1, 0x6d953e2bd7173693}, {0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0438},
+        {0x910ab1d4db9914a0, 0x1d9c9892400a22a3}, {0xb54d5e4a127f59c8, 0x2503beb6d00cab4c},
+        {0xe2a0b5dc971f303a, 0x2e44ae64840fd61e}, {0x8da471a9de737e24, 0x5ceaecfed289e5d3},
+        {0xb10d8e1456105dad, 0x7425a83e872c5f48}, {0xdd50f1996b947518, 0xd12f124e28f7771a},
+        {0x8a5296ffe33cc92f, 0x82bd6b70d99aaa70}, {0xace73cbfdc0bfb7b, 0x636cc64d1001550c},
+        {0xd8210befd30efa5a, 0x3c47f7e05401aa4f}, {0x8714a775e3e95c78, 0x65acfaec34810a72},
+        {0xa8d9d1535ce3b396, 0x7f1839a741a14d0e}, {0xd31045a8341ca07c, 0x1ede48111209a051},
+        {0x83ea2b892091e44d, 0x934aed0aab460433}, {0xa4e4b66b68b65d60, 0xf81da84d56178540},
+        {0xce1de40642e3f4b9, 0x36251260ab9d668f}, {0x80d2ae83e9ce78f3, 0xc1d72b7c6b42601a},
+        {0xa1075a24e4421730, 0xb24cf65b8612f820}, {0xc94930ae1d529cfc, 0xdee033f26797b628},
+        {0xfb9b7cd9a4a7443c, 0x169840ef017da3b2}, {0x9d412e0806e88aa5, 0x8e1f289560ee864f},
+        {0xc491798a08a2ad4e, 0xf1a6f2bab92a27e3}, {0xf5b5d7ec8acb58a2, 0xae10af696774b1dc},
+        {0x9991a6f3d6bf1765, 0xacca6da1e0a8ef2a}, {0xbff610b0cc6edd3f, 0x17fd090a58d32af4},
+        {0xeff394dcff8a948e, 0xddfc4b4cef07f5b1}, {0x95f83d0a1fb69cd9, 0x4abdaf101564f98f},
+        {0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f2}, {0xea53df5fd18d5513, 0x84c86189216dc5ee},
+        {0x92746b9be2f8552c, 0x32fd3cf5b4e49bb5}, {0xb7118682dbb66a77, 0x3fbc8c33221dc2a2},
+        {0xe4d5e82392a40515, 0x0fabaf3feaa5334b}, {0x8f05b1163ba6832d, 0x29cb4d87f2a7400f},
+        {0xb2c71d5bca9023f8, 0x743e20e9ef511013}, {0xdf78e4b2bd342cf6, 0x914da9246b255417},
+        {0x8bab8eefb6409c1a, 0x1ad089b6c2f7548f}, {0xae9672aba3d0c320, 0xa184ac2473b529b2},
+        {0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741f}, {0x8865899617fb1871, 0x7e2fa67c7a658893},
+        {0xaa7eebfb9df9de8d, 0xddbb901b98feeab8}, {0xd51ea6fa85785631, 0x552a74227f3ea566},
+        {0x8533285c936b35de, 0xd53a88958f872760}, {0xa67ff273b8460356, 0x8a892abaf368f138},
+        {0xd01fef10a657842c, 0x2d2b7569b0432d86}, {0x8213f56a67f6b29b, 0x9c3b29620e29fc74},
+        {0xa298f2c501f45f42, 0x8349f3ba91b47b90}, {0xcb3f2f7642717713, 0x241c70a936219a74},
+        {0xfe0efb53d30dd4d7, 0xed238cd383aa0111}, {0x9ec95d1463e8a506, 0xf4363804324a40ab},
+        {0xc67bb4597ce2ce48, 0xb143c6053edcd0d6}, {0xf81aa16fdc1b81da, 0xdd94b7868e94050b},
+        {0x9b10a4e5e9913128, 0xca7cf2b4191c8327}, {0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f1},
+        {0xf24a01a73cf2dccf, 0xbc633b39673c8ced}, {0x976e41088617ca01, 0xd5be0503e085d814},
+        {0xbd49d14aa79dbc82, 0x4b2d8644d8a74e19}, {0xec9c459d51852ba2, 0xddf8e7d60ed1219f},
+        {0x93e1ab8252f33b45, 0xcabb90e5c942b504}, {0xb8da1662e7b00a17, 0x3d6a751f3b936244},
+        {0xe7109bfba19c0c9d, 0x0cc512670a783ad5}, {0x906a617d450187e2, 0x27fb2b80668b24c6},
+        {0xb484f9dc9641e9da, 0xb1f9f660802dedf7}, {0xe1a63853bbd26451, 0x5e7873f8a0396974},
+        {0x8d07e33455637eb2, 0xdb0b487b6423e1e9}, {0xb049dc016abc5e5f, 0x91ce1a9a3d2cda63},
+        {0xdc5c5301c56b75f7, 0x7641a140cc7810fc}, {0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9e},
+        {0xac2820d9623bf429, 0x546345fa9fbdcd45}, {0xd732290fbacaf133, 0xa97c177947ad4096},
+        {0x867f59a9d4bed6c0, 0x49ed8eabcccc485e}, {0xa81f301449ee8c70, 0x5c68f256bfff5a75},
+        {0xd226fc195c6a2f8c, 0x73832eec6fff3112}, {0x83585d8fd9c25db7, 0xc831fd53c5ff7eac},
+        {0xa42e74f3d032f525, 0xba3e7ca8b77f5e56}, {0xcd3a1230c43fb26f, 0x28ce1bd2e55f35ec},
+        {0x80444b5e7aa7cf85, 0x7980d163cf5b81b4}, {0xa0555e361951c366, 0xd7e105bcc3326220},
+        {0xc86ab5c39fa63440, 0x8dd9472bf3fefaa8}, {0xfa856334878fc150, 0xb14f98f6f0feb952},
+        {0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d4}, {0xc3b8358109e84f07, 0x0a862f80ec4700c9},
+        {0xf4a642e14c6262c8, 0xcd27bb612758c0fb}, {0x98e7e9cccfbd7dbd, 0x8038d51cb897789d},
+        {0xbf21e44003acdd2c, 0xe0470a63e6bd56c4}, {0xeeea5d5004981478, 0x1858ccfce06cac75},
+        {0x95527a5202df0ccb, 0x0f37801e0c43ebc9}, {0xbaa718e68396cffd, 0xd30560258f54e6bb},
+        {0xe950df20247c83fd, 0x47c6b82ef32a206a}, {0x91d28b7416cdd27e, 0x4cdc331d57fa5442},
+        {0xb6472e511c81471d, 0xe0133fe4adf8e953}, {0xe3d8f9e563a198e5, 0x58180fddd97723a7},
+        {0x8e679c2f5e44ff8f, 0x570f09eaa7ea7649}, {0xb201833b35d63f73, 0x2cd2cc6551e513db},
+        {0xde81e40a034bcf4f, 0xf8077f7ea65e58d2}, {0x8b112e86420f6191, 0xfb04afaf27faf783},
+        {0xadd57a27d29339f6, 0x79c5db9af1f9b564}, {0xd94ad8b1c7380874, 0x18375281ae7822bd},
+        {0x87cec76f1c830548, 0x8f2293910d0b15b6}, {0xa9c2794ae3a3c69a, 0xb2eb3875504ddb23},
+        {0xd433179d9c8cb841, 0x5fa60692a46151ec}, {0x849feec281d7f328, 0xdbc7c41ba6bcd334},
+        {0xa5c7ea73224deff3, 0x12b9b522906c0801}, {0xcf39e50feae16bef, 0xd768226b34870a01},
+        {0x81842f29f2cce375, 0xe6a1158300d46641}, {0xa1e53af46f801c53, 0x60495ae3c1097fd1},
+        {0xca5e89b18b602368, 0x385bb19cb14bdfc5}, {0xfcf62c1dee382c42, 0x46729e03dd9ed7b6},
+        {0x9e19db92b4e31ba9, 0x6c07a2c26a8346d2}
+    };
+
+    // floor(log2(10^e)) and floor(log10(2^e)) or floor(log10(3/4 * 2^e)) if the lower boundary is closer
+    inline int floorLog2Pow10(int e) {
+        return (e * 1741647) >> 19;
+    }
+    inline int floorLog10Pow2(int e, bool lowerBoundaryIsCloser) {
+        return (e * 1262611 - (lowerBoundaryIsCloser ? 524031 : 0)) >> 22;
+    }
+
+    // upper 32 bits of the 96 bit product g * cp, rounded to odd
+    inline uint32_t roundToOdd(uint64_t g, uint32_t cp) {
+        uint64_t low = uint64_t(uint32_t(g)) * cp;
+        uint64_t high = (g >> 32) * cp + (low >> 32);
+        return uint32_t(high >> 32) | (uint32_t(high) > 1);
+    }
+
+    // 64x64 -> 128 bit multiplication, returns the low word
+    inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t &high) {
+#ifdef __SIZEOF_INT128__
+        __extension__ using uint128 = unsigned __int128;
+        uint128 p = uint128(a) * b;
+        high = uint64_t(p >> 64);
+        return uint64_t(p);
+#else
+        uint64_t p00 = uint64_t(uint32_t(a)) * uint32_t(b);
+        uint64_t p01 = uint64_t(uint32_t(a)) * (b >> 32);
+        uint64_t p10 = (a >> 32) * uint32_t(b);
+        uint64_t middle = p10 + (p00 >> 32) + uint32_t(p01);
+        high = (a >> 32) * (b >> 32) + (middle >> 32) + (p01 >> 32);
+        return (middle << 32) | uint32_t(p00);
+#endif
+    }
+
+    // upper 64 bits of the 192 bit product g * cp, rounded to odd
+    inline uint64_t roundToOdd(const uint64_t *g, uint64_t cp) {
+        uint64_t lowHigh;
+        mul128(g[1], cp, lowHigh);
+        uint64_t high;
+        uint64_t low = mul128(g[0], cp, high) + lowHigh;
+        high += low < lowHigh;
+        return high | (low > 1);
+    }
+
+    // shortest decimal digits * 10^exponent that converts back to the same floating point value
+    struct Decimal {
+        uint64_t digits;
+        int exponent;
+    };
+
+    // select the shortest decimal in the rounding interval (lower, upper) of vb which is 4 * 10^-k * value
+    template <typename T>
+    inline Decimal shortest(T lower, T vb, T upper, int k) {
+        T s = vb / 4;
+        if (s >= 10) {
+            // check if one of the values with one digit less is in the interval
+            T sp = s / 10;
+            bool upInside = lower <= 40 * sp;
+            bool wpInside = 40 * sp + 40 <= upper;
+            if (upInside != wpInside)
+                return {sp + wpInside, k + 1};
+        }
+        bool uInside = lower <= 4 * s;
+        bool wInside = 4 * s + 4 <= upper;
+        if (uInside != wInside)
+            return {s + wInside, k};
+
+        // both are inside: round to nearest, ties to even
+        T mid = 4 * s + 2;
+        bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+        return {s + roundUp, k};
+    }
+
+    // positive finite float to shortest decimal, uses only 32x32->64 bit multiplications
+    static Decimal toDecimal(uint32_t bits) {
+        uint32_t significand = bits & 0x7fffff;
+        int exponent = int(bits >> 23);
+        uint32_t c;
+        int q;
+        if (exponent != 0) {
+            c = 0x800000 | significand;
+            q = exponent - 150;
+
+            // small integers
+            if (q <= 0 && q > -24 && (c & ((uint32_t(1) << -q) - 1)) == 0)
+                return {c >> -q, 0};
+        } else {
+            // subnormal
+            c = significand;
+            q = -149;
+        }
+        bool even = (c & 1) == 0;
+        bool lowerBoundaryIsCloser = significand == 0 && exponent > 1;
+
+        int k = floorLog10Pow2(q, lowerBoundaryIsCloser);
+        int h = q + floorLog2Pow10(-k) + 1;
+        uint64_t g = shortestFloatTable[-k + 31];
+        uint32_t vbl = roundToOdd(g, (4 * c - 2 + lowerBoundaryIsCloser) << h);
+        uint32_t vb = roundToOdd(g, (4 * c) << h);
+        uint32_t vbr = roundToOdd(g, (4 * c + 2) << h);
+        return shortest(vbl + !even, vb, vbr - !even, k);
+    }
+
+    // positive finite double to shortest decimal
+    static Decimal toDecimal(uint64_t bits) {
+        uint64_t significand = bits & 0xfffffffffffff;
+        int exponent = int(bits >> 52);
+        uint64_t c;
+        int q;
+        if (exponent != 0) {
+            c = 0x10000000000000 | significand;
+            q = exponent - 1075;
+
+            // small integers
+            if (q <= 0 && q > -53 && (c & ((uint64_t(1) << -q) - 1)) == 0)
+                return {c >> -q, 0};
+        } else {
+            // subnormal
+            c = significand;
+            q = -1074;
+        }
+        bool even = (c & 1) == 0;
+        bool lowerBoundaryIsCloser = significand == 0 && exponent > 1;
+
+        int k = floorLog10Pow2(q, lowerBoundaryIsCloser);
+        int h = q + floorLog2Pow10(-k) + 1;
+        const uint64_t *g = pow10Table128[-k + 342];
+        uint64_t vbl = roundToOdd(g, (4 * c - 2 + lowerBoundaryIsCloser) << h);
+        uint64_t vb = roundToOdd(g, (4 * c) << h);
+        uint64_t vbr = roundToOdd(g, (4 * c + 2) << h);
+        return shortest(vbl + !even, vb, vbr - !even, k);
+    }
+
+    static char *copy(char *end, const char *str, int length) {
+        char *it = end - length;
+        std::memcpy(it, str, length);
+        return it;
+    }
+
+    // convert special values nan and inf
+    static char *special(char *end, bool negative, bool nan) {
+        if (nan)
+            return copy(end, "nan", 3);
+        return negative ? copy(end, "-inf", 4) : copy(end, "inf", 3);
+    }
+
+    // convert digits * 10^exponent in fixed point notation if the decimal point is near the digits, otherwise in
+    // scientific notation, e.g. 1.5e-7. Needs at most 24 characters
+    static char *shortest(char *end, Decimal decimal, bool negative) {
+        uint64_t digits = decimal.digits;
+        int exponent = decimal.exponent;
+
+        // remove trailing zeros
+        while (digits >= 10 && digits % 10 == 0) {
+            digits /= 10;
+            ++exponent;
+        }
+
+        // number of digits and position of decimal point relative to the first digit
+        int count = 1;
+        while (count < 20 && digits >= pow10IntegerTable[count])
+            ++count;
+        int point = count + exponent;
+
+        char *it = end;
+        if (point < -3 || point > 21) {
+            // scientific notation: exponent and digits with decimal point after the first digit
+            int e = point - 1;
+            it = dec(it, uint32_t(e < 0 ? -e : e), 1);
+            if (e < 0)
+                *--it = '-';
+            *--it = 'e';
+            it = dec(it, digits, 1);
+            if (count > 1) {
+                it[-1] = it[0];
+                it[0] = '.';
+                --it;
+            }
+        } else if (exponent >= 0) {
+            // integer: digits followed by zeros
+            while (exponent > 0) {
+                *--it = '0';
+                --exponent;
+            }
+            it = dec(it, digits, 1);
+        } else if (point > 0) {
+            // insert decimal point between the digits
+            it = dec(it, digits, 1);
+            std::memmove(it - 1, it, point);
+            it[point - 1] = '.';
             --it;
-            *it = '0' + value % 10;
-            value /= 10;
-            --digitCount;
+        } else {
+            // leading zeros, e.g. 0.001
+            it = dec(it, digits, count - point);
+            *--it = '.';
+            *--it = '0';
         }
+
+        // add sign
+        if (negative)
+            *--it = '-';
+
         return it;
     }
 
+    // convert an integer that is the value multiplied by 10^decimalCount in fixed point notation
+    static char *fixed(char *end, uint64_t value, int digitCount, int decimalCount, bool suppressTrailingZeros,
+        bool negative)
+    {
+        // suppress trailing zeros (50.1 vs 50.1000)
+        if (suppressTrailingZeros) {
+            while (decimalCount > 0 && value % 10 == 0) {
+                value /= 10;
+                --decimalCount;
+            }
+        }
+
+        // if the value and digit count of integer part are zero, set to one digit to get at least a '0'
+        if (value == 0 && digitCount == 0)
+            digitCount = 1;
+
+        // convert integer and decimal part into buffer and insert decimal point
+        char *it = dec(end, value, digitCount + decimalCount);
+        if (decimalCount > 0) {
+            char *point = end - decimalCount;
+            std::memmove(it - 1, it, point - it);
+            point[-1] = '.';
+            --it;
+        }
 
-    /*static double const roundTable[11] = {
-        0.5, 0.05, 0.005, 0.0005, 0.00005,
-        0.000005, 0.0000005, 0.00000005, 0.000000005, 0.0000000005,
-        0.00000000005};
+        // add sign
+        if (negative)
+            *--it = '-';
 
-    static double const powTable[11] = {
-        1.0, 10.0, 100.0, 1000.0, 10000.0,
-        100000.0, 1000000.0, 10000000.0, 100000000.0, 1000000000.0,
-        10000000000.0};*/
+        return it;
+    }
 
     char *dec(char *end, double value, int digitCount, int decimalCount) {
-        // suppress trailing zeros (50.1 vs 50.1000)
         bool suppressTrailingZeros = decimalCount >= 0;
         if (decimalCount < 0)
             decimalCount = -decimalCount;
 
         // handle sign
-        bool hasSign = value < 0;
-        if (hasSign)
+        bool negative = value < 0;
+        if (negative)
             value = -value;
 
-        // calc round and power-of-ten values
-        double round = 0.5;
-        double pow = 1.0;
-        for (int i = 0; i < decimalCount; ++i) {
-            round /= 10.0;
-            pow *= 10.0;
+        // reduce decimal count for large values so that the scaled value fits into 18 digits
+        while (decimalCount > 0 && value >= pow10DoubleTable[18 - decimalCount])
+            --decimalCount;
+        if (!(value < 1e18)) {
+            // too large, inf or nan
+            return decShortest(end, negative ? -value : value);
+        }
+
+        // scale and round
+        uint64_t scaled = uint64_t(value * pow10DoubleTable[decimalCount] + 0.5);
+
+        return fixed(end, scaled, digitCount, decimalCount, suppressTrailingZeros, negative);
+    }
+
+    char *dec(char *end, float value, int digitCount, int decimalCount) {
+        bool suppressTrailingZeros = decimalCount >= 0;
+        if (decimalCount < 0)
+            decimalCount = -decimalCount;
+
+        // handle sign
+        bool negative = value < 0;
+        if (negative)
+            value = -value;
+
+        // reduce decimal count for large values so that the scaled value fits into 18 digits
+        while (decimalCount > 0 && value >= pow10FloatTable[18 - decimalCount])
+            --decimalCount;
+        if (!(value < 1e18f)) {
+            // too large, inf or nan
+            return decShortest(end, negative ? -value : value);
+        }
+
+        // scale and round exactly using integer arithmetic: value * 10^decimalCount = c * 10^decimalCount * 2^q
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        int exponent = int(bits >> 23);
+        uint64_t c = bits & 0x7fffff;
+        int q = -149;
+        if (exponent != 0) {
+            c |= 0x800000;
+            q = exponent - 150;
+        }
+        uint64_t scaled = c * pow10IntegerTable[decimalCount];
+        if (q >= 0)
+            scaled <<= q;
+        else if (q > -63)
+            scaled = (scaled + (uint64_t(1) << (-q - 1))) >> -q;
+        else
+            scaled = 0;
+
+        return fixed(end, scaled, digitCount, decimalCount, suppressTrailingZeros, negative);
+    }
+
+    char *decShortest(char *end, double value) {
+        uint64_t bits = std::bit_cast<uint64_t>(value);
+        bool negative = (bits >> 63) != 0;
+        bits &= 0x7fffffffffffffff;
+        if (bits >= 0x7ff0000000000000)
+            return special(end, negative, bits != 0x7ff0000000000000);
+        if (bits == 0)
+            return negative ? copy(end, "-0", 2) : copy(end, "0", 1);
+        return shortest(end, toDecimal(bits), negative);
+    }
+
+    char *decShortest(char *end, float value) {
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        bool negative = (bits >> 31) != 0;
+        bits &= 0x7fffffff;
+        if (bits >= 0x7f800000)
+            return special(end, negative, bits != 0x7f800000);
+        if (bits == 0)
+            return negative ? copy(end, "-0", 2) : copy(end, "0", 1);
+        return shortest(end, toDecimal(bits), negative);
+    }
+
+
+    // read eight characters as little endian word
+    inline uint64_t read64(const char *p) {
+        uint64_t value;
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(&value, p, 8);
+        } else {
+            value = 0;
+            for (int i = 7; i >= 0; --i)
+                value = (value << 8) | uint8_t(p[i]);
+        }
+        return value;
+    }
+
+    // check if eight characters are all decimal digits (SWAR: SIMD within a register)
+    inline bool isEightDigits(uint64_t value) {
+        return ((value & 0xf0f0f0f0f0f0f0f0) | (((value + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4))
+            == 0x3333333333333333;
+    }
+
+    // convert eight decimal digits to an integer using three multiplications
+    inline uint32_t parseEightDigits(uint64_t value) {
+        value -= 0x3030303030303030;
+        value = value * 10 + (value >> 8);
+        value = ((value & 0x000000ff000000ff) * 0x000f424000000064
+            + ((value >> 16) & 0x000000ff000000ff) * 0x0000271000000001) >> 32;
+        return uint32_t(value);
+    }
+
+    inline bool isDigit(char ch) {
+        return uint8_t(ch - '0') < 10;
+    }
+
+    int parseDec(const char *data, int length, uint64_t &value) {
+        const char *it = data;
+        const char *end = data + length;
+
+        // skip leading zeros
+        while (it < end && *it == '0')
+            ++it;
+        const char *start = it;
+
+        // up to 16 digits eight at a time
+        uint64_t v = 0;
+        while (end - it >= 8 && it - start <= 8) {
+            uint64_t block = read64(it);
+            if (!isEightDigits(block))
+                break;
+            v = v * 100000000 + parseEightDigits(block);
+            it += 8;
+        }
+
+        // remaining digits, overflow is only possible at the 20th digit
+        for (; it < end && isDigit(*it); ++it) {
+            uint32_t digit = *it - '0';
+            if (it - start >= 19 && (v > 1844674407370955161u || (v == 1844674407370955161u && digit > 5)))
+                return 0;
+            v = v * 10 + digit;
+        }
+
+        value = v;
+        return int(it - data);
+    }
+
+
+    // floating point format for Eisel-Lemire
+    template <typename T>
+    struct Binary;
+
+    template <>
+    struct Binary<float> {
+        using Bits = uint32_t;
+        static constexpr int MANTISSA_BITS = 23;
+        static constexpr int MINIMUM_EXPONENT = -127;
+        static constexpr int INFINITE_POWER = 0xff;
+        static constexpr int SMALLEST_POWER_OF_TEN = -65;
+        static constexpr int LARGEST_POWER_OF_TEN = 38;
+        static constexpr int MIN_ROUND_TO_EVEN = -17;
+        static constexpr int MAX_ROUND_TO_EVEN = 10;
+
+        // fast path: mantissa and power of ten are exact
+        static constexpr uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 24;
+        static constexpr int MAX_EXACT_POWER = 10;
+        static float pow10(int e) {return pow10FloatTable[e];}
+    };
+
+    template <>
+    struct Binary<double> {
+        using Bits = uint64_t;
+        static constexpr int MANTISSA_BITS = 52;
+        static constexpr int MINIMUM_EXPONENT = -1023;
+        static constexpr int INFINITE_POWER = 0x7ff;
+        static constexpr int SMALLEST_POWER_OF_TEN = -342;
+        static constexpr int LARGEST_POWER_OF_TEN = 308;
+        static constexpr int MIN_ROUND_TO_EVEN = -4;
+        static constexpr int MAX_ROUND_TO_EVEN = 23;
+
+        // fast path: mantissa and power of ten are exact
+        static constexpr uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+        static constexpr int MAX_EXACT_POWER = 22;
+        static double pow10(int e) {return pow10DoubleTable[e];}
+    };
+
+    // convert w * 10^q to the binary representation (without sign) using the Eisel-Lemire algorithm
+    // (https://arxiv.org/abs/2101.11408), the result is correctly rounded
+    template <typename T>
+    typename Binary<T>::Bits eiselLemire(uint64_t w, int q) {
+        using B = Binary<T>;
+        using Bits = typename B::Bits;
+        if (w == 0 || q < B::SMALLEST_POWER_OF_TEN)
+            return 0;
+        if (q > B::LARGEST_POWER_OF_TEN)
+            return Bits(B::INFINITE_POWER) << B::MANTISSA_BITS;
+
+        // normalize mantissa
+        int lz = std::countl_zero(w);
+        w <<= lz;
+
+        // 128 bit 5^q as expected by the algorithm: exact for 0 <= q <= 55, rounded up for -27 <= q < 0 and
+        // truncated otherwise. The table entries are rounded up except for the exact ones
+        const uint64_t *g = pow10Table128[q + 342];
+        uint64_t gHigh = g[0];
+        uint64_t gLow = g[1];
+        if (q < -27 || q > 55) {
+            gHigh -= gLow == 0;
+            --gLow;
+        }
+
+        // multiply, the low word of the power is only needed if the high word is not precise enough
+        constexpr uint64_t precisionMask = 0xffffffffffffffff >> (B::MANTISSA_BITS + 3);
+        uint64_t high;
+        uint64_t low = mul128(w, gHigh, high);
+        if ((high & precisionMask) == precisionMask) {
+            uint64_t high2;
+            mul128(w, gLow, high2);
+            low += high2;
+            high += low < high2;
+        }
+
+        int upperBit = int(high >> 63);
+        int shift = upperBit + 64 - B::MANTISSA_BITS - 3;
+        uint64_t mantissa = high >> shift;
+        int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperBit - lz - B::MINIMUM_EXPONENT;
+
+        if (power2 <= 0) {
+            // subnormal
+            if (-power2 + 1 >= 64)
+                return 0;
+            mantissa >>= -power2 + 1;
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+
+            // may round up to the smallest normal number
+            return Bits(mantissa);
+        }
+
+        // exactly halfway between two floating point numbers: round to even
+        if (low <= 1 && q >= B::MIN_ROUND_TO_EVEN && q <= B::MAX_ROUND_TO_EVEN && (mantissa & 3) == 1
+            && (mantissa << shift) == high)
+        {
+            mantissa &= ~uint64_t(1);
         }
 
         // round
-        value += round;//roundTable[decimalCount];
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (uint64_t(2) << B::MANTISSA_BITS)) {
+            mantissa = uint64_t(1) << B::MANTISSA_BITS;
+            ++power2;
+        }
+        mantissa &= ~(uint64_t(1) << B::MANTISSA_BITS);
+        if (power2 >= B::INFINITE_POWER)
+            return Bits(B::INFINITE_POWER) << B::MANTISSA_BITS;
+        return Bits(mantissa) | (Bits(power2) << B::MANTISSA_BITS);
+    }
 
-        // extract integer and fractional part
-        // check with https://godbolt.org/ and parameters -mthumb -mcpu=cortex-m4 -mfloat-abi=hard -mfpu=fpv4-sp-d16 -Os
-        uint64_t ipart = uint64_t(value);
-        uint64_t fpart = uint64_t((value - double(ipart)) * pow /*Table[decimalCount]*/);
+    // parse digits of a floating point number into the mantissa w with up to 19 significant digits
+    struct Digits {
+        uint64_t w = 0;
+        int count = 0;
+        int exponent = 0;
+        bool truncated = false;
+        bool valid = false;
+
+        const char *parse(const char *it, const char *end, bool fraction) {
+            // skip leading zeros
+            if (this->count == 0) {
+                while (it < end && *it == '0') {
+                    this->valid = true;
+                    if (fraction)
+                        --this->exponent;
+                    ++it;
+                }
+            }
 
-        // if fractional part and digit count of integer part are zero, set to one digit to get at least a '0'
-        if (fpart == 0 && digitCount == 0)
-            digitCount = 1;
+            // eight digits at a time while they fit into 19 digits
+            while (this->count <= 11 && end - it >= 8) {
+                uint64_t block = read64(it);
+                if (!isEightDigits(block))
+                    break;
+                this->w = this->w * 100000000 + parseEightDigits(block);
+                this->count += 8;
+                if (fraction)
+                    this->exponent -= 8;
+                this->valid = true;
+                it += 8;
+            }
 
-        // remove trailing zeros
-        if (suppressTrailingZeros) {
-            while (decimalCount > 0 && fpart % 10 == 0) {
-                fpart /= 10;
-                --decimalCount;
+            // remaining digits
+            for (; it < end && isDigit(*it); ++it) {
+                if (this->count < 19) {
+                    this->w = this->w * 10 + (*it - '0');
+                    ++this->count;
+                    if (fraction)
+                        --this->exponent;
+                } else {
+                    // more than 19 significant digits
+                    if (!fraction)
+                        ++this->exponent;
+                    this->truncated |= *it != '0';
+                }
+                this->valid = true;
             }
+            return it;
         }
+    };
 
-        char *it = end;
+    // big integer with 32 bit limbs for the slow path of parseFloat()
+    template <int N>
+    struct BigInt {
+        uint32_t limbs[N];
+        int size = 0;
+
+        void mul(uint32_t factor, uint32_t add = 0) {
+            uint64_t carry = add;
+            for (int i = 0; i < this->size; ++i) {
+                carry += uint64_t(this->limbs[i]) * factor;
+                this->limbs[i] = uint32_t(carry);
+                carry >>= 32;
+            }
+            if (carry != 0) {
+                assert(this->size < N);
+                this->limbs[this->size++] = uint32_t(carry);
+            }
+        }
 
-        // convert decimal part
-        while (decimalCount > 0) {
-            --decimalCount;
-            --it;
-            *it = '0' + fpart % 10;
-            fpart /= 10;
+        void mulPow5(int exponent) {
+            // 5^13 is the largest power of five that fits into 32 bits
+            for (; exponent >= 13; exponent -= 13)
+                mul(1220703125);
+            uint32_t factor = 1;
+            for (; exponent > 0; --exponent)
+                factor *= 5;
+            mul(factor);
         }
 
-        // add decimal point
-        if (it < end)
-            *--it = '.';
+        void shiftLeft(int shift) {
+            int words = shift / 32;
+            int bits = shift % 32;
+            if (this->size == 0)
+                return;
+            if (bits != 0) {
+                uint32_t carry = 0;
+                for (int i = 0; i < this->size; ++i) {
+                    uint32_t limb = this->limbs[i];
+                    this->limbs[i] = (limb << bits) | carry;
+                    carry = limb >> (32 - bits);
+                }
+                if (carry != 0) {
+                    assert(this->size < N);
+                    this->limbs[this->size++] = carry;
+                }
+            }
+            if (words != 0) {
+                assert(this->size + words <= N);
+                for (int i = this->size - 1; i >= 0; --i)
+                    this->limbs[i + words] = this->limbs[i];
+                for (int i = 0; i < words; ++i)
+                    this->limbs[i] = 0;
+                this->size += words;
+            }
+        }
 
-        // convert integer part into buffer
-        while (ipart > 0 || digitCount > 0) {
-            --it;
-            *it = '0' + ipart % 10;
-            ipart /= 10;
-            --digitCount;
+        // compare, returns -1, 0 or 1
+        int compare(const BigInt &b) const {
+            if (this->size != b.size)
+                return this->size < b.size ? -1 : 1;
+            for (int i = this->size - 1; i >= 0; --i) {
+                if (this->limbs[i] != b.limbs[i])
+                    return this->limbs[i] < b.limbs[i] ? -1 : 1;
+            }
+            return 0;
         }
+    };
 
-        // add sign
-        if (hasSign)
-            *--it = '-';
+    // slow path for the rare case that more than 19 significant digits are needed: the lower candidate bits (from
+    // the truncated mantissa) and the next floating point number are ambiguous. Compare all decimal digits (up to
+    // the maximum that can matter) exactly with the halfway point between the two candidates using big integers
+    // (similar to digit_comp of fast_float)
+    template <typename T>
+    typename Binary<T>::Bits compareDigits(const char *it, const char *end, int exponent,
+        typename Binary<T>::Bits bits)
+    {
+        using B = Binary<T>;
+        using Bits = typename B::Bits;
+
+        // maximum number of significant digits of a halfway point and size of the big integers
+        constexpr int MAX_DIGITS = std::is_same_v<T, float> ? 114 : 769;
+        constexpr int LIMBS = std::is_same_v<T, float> ? 32 : 125;
+
+        // parse up to MAX_DIGITS significant digits into a big integer, nine at a time
+        BigInt<LIMBS> digits;
+        int count = 0;
+        bool fraction = false;
+        bool sticky = false;
+        uint32_t block = 0;
+        int blockCount = 0;
+        for (; it < end; ++it) {
+            char ch = *it;
+            if (ch == '.') {
+                fraction = true;
+                continue;
+            }
+            if (count == 0 && ch == '0') {
+                // leading zero
+                if (fraction)
+                    --exponent;
+                continue;
+            }
+            if (count < MAX_DIGITS) {
+                block = block * 10 + (ch - '0');
+                if (++blockCount == 9) {
+                    digits.mul(1000000000, block);
+                    block = 0;
+                    blockCount = 0;
+                }
+                ++count;
+                if (fraction)
+                    --exponent;
+            } else {
+                // digits beyond MAX_DIGITS only matter if they are not zero
+                sticky |= ch != '0';
+                if (!fraction)
+                    ++exponent;
+            }
+        }
+        if (blockCount > 0) {
+            uint32_t factor = 1;
+            for (int i = 0; i < blockCount; ++i)
+                factor *= 10;
+            digits.mul(factor, block);
+        }
 
-        return it;
+        // halfway point between bits and the next floating point number: (2 * m + 1) * 2^(e - 1)
+        int biasedExponent = int(bits >> B::MANTISSA_BITS);
+        uint64_t m = bits & ((Bits(1) << B::MANTISSA_BITS) - 1);
+        int e = B::MINIMUM_EXPONENT + 1 - B::MANTISSA_BITS;
+        if (biasedExponent != 0) {
+            m |= uint64_t(1) << B::MANTISSA_BITS;
+            e += biasedExponent - 1;
+        }
+        BigInt<LIMBS> halfway;
+        uint64_t h = 2 * m + 1;
+        halfway.limbs[0] = uint32_t(h);
+        halfway.limbs[1] = uint32_t(h >> 32);
+        halfway.size = halfway.limbs[1] != 0 ? 2 : 1;
+        --e;
+
+        // compare digits * 5^exponent * 2^exponent with halfway * 2^e
+        if (exponent >= 0)
+            digits.mulPow5(exponent);
+        else
+            halfway.mulPow5(-exponent);
+        if (exponent >= e)
+            digits.shiftLeft(exponent - e);
+        else
+            halfway.shiftLeft(e - exponent);
+        int c = digits.compare(halfway);
+        if (c == 0 && sticky)
+            c = 1;
+
+        // round up (may carry into the exponent up to infinity) or to even on a tie
+        if (c > 0 || (c == 0 && (bits & 1) != 0))
+            ++bits;
+        return bits;
+    }
+
+    template <typename T>
+    int parseFloat(const char *data, int length, T &value) {
+        using Bits = typename Binary<T>::Bits;
+        const char *it = data;
+        const char *end = data + length;
+
+        // sign
+        bool negative = false;
+        if (it < end && (*it == '-' || *it == '+')) {
+            negative = *it == '-';
+            ++it;
+        }
+
+        // nan and inf
+        if (end - it >= 3) {
+            bool nan = std::memcmp(it, "nan", 3) == 0;
+            if (nan || std::memcmp(it, "inf", 3) == 0) {
+                value = nan ? std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::infinity();
+                if (negative)
+                    value = -value;
+                return int(it + 3 - data);
+            }
+        }
+
+        // integer and fractional part
+        Digits digits;
+        const char *digitsBegin = it;
+        it = digits.parse(it, end, false);
+        if (it < end && *it == '.')
+            it = digits.parse(it + 1, end, true);
+        if (!digits.valid)
+            return 0;
+        const char *digitsEnd = it;
+
+        // exponent
+        int explicitExponent = 0;
+        if (end - it >= 2 && (*it | 0x20) == 'e') {
+            const char *e = it + 1;
+            bool negativeExponent = *e == '-';
+            if (*e == '-' || *e == '+')
+                ++e;
+            if (e < end && isDigit(*e)) {
+                int exponent = 0;
+                for (; e < end && isDigit(*e); ++e) {
+                    if (exponent < 100000)
+                        exponent = exponent * 10 + (*e - '0');
+                }
+                explicitExponent = negativeExponent ? -exponent : exponent;
+                digits.exponent += explicitExponent;
+                it = e;
+            }
+        }
+        int q = digits.exponent;
+        uint64_t w = digits.w;
+
+        if (!digits.truncated && w <= Binary<T>::MAX_EXACT_MANTISSA && q >= -Binary<T>::MAX_EXACT_POWER
+            && q <= Binary<T>::MAX_EXACT_POWER)
+        {
+            // fast path (Clinger): one correctly rounded multiplication or division of exact values
+            T v = T(w);
+            v = q < 0 ? v / Binary<T>::pow10(-q) : v * Binary<T>::pow10(q);
+            value = negative ? -v : v;
+            return int(it - data);
+        }
+        Bits bits = eiselLemire<T>(w, q);
+        if (digits.truncated && eiselLemire<T>(w + 1, q) != bits) {
+            // rare case of more than 19 significant digits where the truncated digits matter
+            bits = compareDigits<T>(digitsBegin, digitsEnd, explicitExponent, bits);
+        }
+        if (negative)
+            bits |= Bits(1) << (sizeof(Bits) * 8 - 1);
+        value = std::bit_cast<T>(bits);
+        return int(it - data);
+    }
+
+    int parseDec(const char *data, int length, float &value) {
+        return parseFloat(data, length, value);
+    }
+
+    int parseDec(const char *data, int length, double &value) {
+        return parseFloat(data, length, value);
     }
 
 
@@ -132,6 +1295,245 @@ namespace detail {
         return b;
     }
 
+    // value of a hex digit or -1 if the character is not a hex digit
+    inline int hexValue(char ch) {
+        if (ch >= '0' && ch <= '9')
+            return ch - '0';
+        ch |= 0x20;
+        if (ch >= 'a' && ch <= 'f')
+            return ch - 'a' + 10;
+        return -1;
+    }
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+    // convert 16 nibbles to hex digits
+    inline __m128i hexDigits(__m128i n) {
+#if defined(__SSSE3__)
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hexTable)), n);
+#else
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+        return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), letter);
+#endif
+    }
+
+    // convert 16 hex digits to 8 bytes, return false if one of the characters is not a hex digit
+    inline bool hexBytes(__m128i c, uint8_t *out) {
+        // use unsigned range checks min(x, max) == x
+        __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+        if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff)
+            return false;
+        __m128i n = _mm_or_si128(_mm_and_si128(isDigit, digit),
+            _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+
+        // combine pairs of nibbles where the first one is the high nibble
+#if defined(__SSSE3__)
+        __m128i pairs = _mm_maddubs_epi16(n, _mm_set1_epi16(0x0110));
+#else
+        __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00ff)), 4),
+            _mm_srli_epi16(n, 8));
+#endif
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(pairs, pairs));
+        return true;
+    }
+
+#elif defined(__ARM_NEON)
+
+    // convert 16 nibbles to hex digits
+    inline uint8x16_t hexDigits(uint8x16_t n) {
+#if defined(__aarch64__)
+        return vqtbl1q_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(hexTable)), n);
+#else
+        uint8x16_t letter = vandq_u8(vcgtq_u8(n, vdupq_n_u8(9)), vdupq_n_u8('a' - '0' - 10));
+        return vaddq_u8(vaddq_u8(n, vdupq_n_u8('0')), letter);
+#endif
+    }
+
+    // convert 16 hex digits to nibbles, clear bytes in valid if a character is not a hex digit
+    inline uint8x16_t hexNibbles(uint8x16_t c, uint8x16_t &valid) {
+        uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+        uint8x16_t letter = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+        uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+        valid = vandq_u8(valid, vorrq_u8(isDigit, vcltq_u8(letter, vdupq_n_u8(6))));
+        return vbslq_u8(isDigit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+    }
+
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && (!defined(__arm__) || defined(__ARM_FEATURE_UNALIGNED))
+#define COCO_HEX_SWAR
+
+    // SWAR (SIMD within a register) fallback, e.g. for Cortex-M3/M4 which support unaligned word access
+    using HexWord = std::conditional_t<sizeof(void *) >= 8, uint64_t, uint32_t>;
+    constexpr HexWord HEX_ONES = HexWord(0x0101010101010101ull);
+    constexpr HexWord HEX_HIGH = HexWord(0x8080808080808080ull);
+    constexpr HexWord HEX_NIBBLES = HexWord(0x000f000f000f000full);
+    constexpr HexWord HEX_LOW_BYTES = HexWord(0x00ff00ff00ff00ffull);
+
+    // set the high bit of each byte that is greater or equal to k, bytes must be less than 0x80
+    inline HexWord greaterEqual(HexWord x, uint8_t k) {
+        return (x + (0x80 - k) * HEX_ONES) & HEX_HIGH;
+    }
+
+#endif
+
+} // namespace detail
+
+char *hexEncode(Array<const uint8_t> data, char *out) {
+    const uint8_t *it = data.data();
+    const uint8_t *end = it + data.size();
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    for (; end - it >= 16; it += 16, out += 32) {
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(b, 4), mask);
+        __m128i low = _mm_and_si128(b, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), detail::hexDigits(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), detail::hexDigits(_mm_unpackhi_epi8(high, low)));
+    }
+#elif defined(__ARM_NEON)
+    for (; end - it >= 16; it += 16, out += 32) {
+        uint8x16_t b = vld1q_u8(it);
+        uint8x16x2_t digits = {{detail::hexDigits(vshrq_n_u8(b, 4)), detail::hexDigits(vandq_u8(b, vdupq_n_u8(0x0f)))}};
+        vst2q_u8(reinterpret_cast<uint8_t *>(out), digits);
+    }
+#elif defined(COCO_HEX_SWAR)
+    using Word = detail::HexWord;
+    constexpr int STEP = sizeof(Word) / 2;
+    for (; end - it >= STEP; it += STEP, out += STEP * 2) {
+        // spread the bytes so that each one occupies two bytes
+        Word x;
+        if constexpr (STEP == 4) {
+            uint32_t v;
+            std::memcpy(&v, it, 4);
+            x = v;
+            x = (x | (x << 16)) & Word(0x0000ffff0000ffffull);
+        } else {
+            uint16_t v;
+            std::memcpy(&v, it, 2);
+            x = v;
+        }
+        x = (x | (x << 8)) & detail::HEX_LOW_BYTES;
+
+        // high nibble goes to the first byte, low nibble to the second byte
+        x = ((x >> 4) & detail::HEX_NIBBLES) | ((x & detail::HEX_NIBBLES) << 8);
+
+        // add '0' and additionally 'a' - '0' - 10 for nibbles greater than 9, no carries can occur
+        Word letter = ((x + 6 * detail::HEX_ONES) >> 4) & detail::HEX_ONES;
+        x += '0' * detail::HEX_ONES + letter * ('a' - '0' - 10);
+        std::memcpy(out, &x, sizeof(Word));
+    }
+#endif
+    for (; it < end; ++it) {
+        out[0] = detail::hexTable[*it >> 4];
+        out[1] = detail::hexTable[*it & 0xf];
+        out += 2;
+    }
+    return out;
+}
+
+ConvertedValue<int> hexDecode(String str, uint8_t *out) {
+    const char *begin = str.data();
+    const char *it = begin;
+    const char *end = it + str.size();
+    uint8_t *o = out;
+#if defined(__SSE2__) || defined(_M_X64)
+    for (; end - it >= 16; it += 16, o += 8) {
+        if (!detail::hexBytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(it)), o))
+            break;
+    }
+#elif defined(__ARM_NEON)
+    for (; end - it >= 32; it += 32, o += 16) {
+        // deinterleave into high and low digits
+        uint8x16x2_t c = vld2q_u8(reinterpret_cast<const uint8_t *>(it));
+        uint8x16_t valid = vdupq_n_u8(0xff);
+        uint8x16_t high = detail::hexNibbles(c.val[0], valid);
+        uint8x16_t low = detail::hexNibbles(c.val[1], valid);
+        uint64x2_t v = vreinterpretq_u64_u8(valid);
+        if ((vgetq_lane_u64(v, 0) & vgetq_lane_u64(v, 1)) != ~uint64_t(0))
+            break;
+        vst1q_u8(o, vsliq_n_u8(low, high, 4));
+    }
+#elif defined(COCO_HEX_SWAR)
+    using Word = detail::HexWord;
+    constexpr int STEP = sizeof(Word);
+    for (; end - it >= STEP; it += STEP, o += STEP / 2) {
+        Word c;
+        std::memcpy(&c, it, STEP);
+
+        // check that all characters are hex digits
+        if ((c & detail::HEX_HIGH) != 0)
+            break;
+        Word lower = c | 0x20 * detail::HEX_ONES;
+        Word isDigit = detail::greaterEqual(c, '0') & ~detail::greaterEqual(c, '9' + 1);
+        Word isLetter = detail::greaterEqual(lower, 'a') & ~detail::greaterEqual(lower, 'f' + 1);
+        if ((isDigit | isLetter) != detail::HEX_HIGH)
+            break;
+
+        // 'a' and 'A' have bit 6 set and 1 in the low nibble
+        Word x = (c & 0x0f * detail::HEX_ONES) + ((c >> 6) & detail::HEX_ONES) * 9;
+
+        // combine pairs of nibbles where the first one is the high nibble, then pack the bytes
+        x = ((x & detail::HEX_LOW_BYTES) << 4) | ((x >> 8) & detail::HEX_LOW_BYTES);
+        x = (x | (x >> 8));
+        if constexpr (STEP == 8) {
+            x &= Word(0x0000ffff0000ffffull);
+            x |= x >> 16;
+        }
+        auto bytes = uint32_t(x);
+        std::memcpy(o, &bytes, STEP / 2);
+    }
+#endif
+    for (; end - it >= 2; it += 2) {
+        int high = detail::hexValue(it[0]);
+        int low = detail::hexValue(it[1]);
+        if ((high | low) < 0)
+            break;
+        *o = uint8_t((high << 4) | low);
+        ++o;
+    }
+    return {int(o - out), int(it - begin)};
+}
+
+namespace detail {
+
+    char *hexDumpLine(char *out, const uint8_t *data, int length, uint32_t address) {
+        // address
+        hex(out + 8, address, 8);
+        out += 8;
+        *out++ = ' ';
+        *out++ = ' ';
+
+        // hex digits in two groups of 8 bytes, padded with spaces for a partial line
+        char digits[32];
+        hexEncode({data, length}, digits);
+        for (int i = 0; i < 16; ++i) {
+            if (i == 8)
+                *out++ = ' ';
+            if (i < length) {
+                out[0] = digits[i * 2];
+                out[1] = digits[i * 2 + 1];
+            } else {
+                out[0] = ' ';
+                out[1] = ' ';
+            }
+            out[2] = ' ';
+            out += 3;
+        }
+
+        // printable characters
+        *out++ = ' ';
+        *out++ = '|';
+        for (int i = 0; i < length; ++i) {
+            uint8_t ch = data[i];
+            *out++ = ch >= 0x20 && ch < 0x7f ? char(ch) : '.';
+        }
+        *out++ = '|';
+        *out++ = '\n';
+        return out;
+    }
+
     char *utf8(char *end, uint32_t code) {
         char *b = end;
         int bits = 0;
@@ -154,6 +1556,459 @@ namespace detail {
         *b = bits | code;
         return b;
     }
+
+    // encode a code point as UTF-8 in forward direction
+    inline char *encodeUtf8(char *out, uint32_t code) {
+        if (code < 0x80) {
+            out[0] = char(code);
+            return out + 1;
+        }
+        if (code < 0x800) {
+            out[0] = char(0xc0 | (code >> 6));
+            out[1] = char(0x80 | (code & 0x3f));
+            return out + 2;
+        }
+        if (code < 0x10000) {
+            out[0] = char(0xe0 | (code >> 12));
+            out[1] = char(0x80 | ((code >> 6) & 0x3f));
+            out[2] = char(0x80 | (code & 0x3f));
+            return out + 3;
+        }
+        out[0] = char(0xf0 | (code >> 18));
+        out[1] = char(0x80 | ((code >> 12) & 0x3f));
+        out[2] = char(0x80 | ((code >> 6) & 0x3f));
+        out[3] = char(0x80 | (code & 0x3f));
+        return out + 4;
+    }
+
+    // decode a non-ASCII UTF-8 sequence and advance the iterator, return -1 for overlong encodings, surrogates, code
+    // points above 0x10ffff and truncated sequences
+    inline int32_t decodeUtf8(const uint8_t *&it, const uint8_t *end) {
+        uint32_t b0 = it[0];
+        if (b0 < 0xc2)
+            return -1;
+        if (b0 < 0xe0) {
+            if (end - it < 2 || (it[1] & 0xc0) != 0x80)
+                return -1;
+            uint32_t code = ((b0 & 0x1f) << 6) | (it[1] & 0x3f);
+            it += 2;
+            return code;
+        }
+        if (b0 < 0xf0) {
+            if (end - it < 3)
+                return -1;
+            uint32_t b1 = it[1];
+            uint32_t b2 = it[2];
+
+            // exclude overlong encodings (e0 80..9f) and surrogates (ed a0..bf)
+            uint32_t low = b0 == 0xe0 ? 0xa0 : 0x80;
+            uint32_t high = b0 == 0xed ? 0x9f : 0xbf;
+            if (b1 < low || b1 > high || (b2 & 0xc0) != 0x80)
+                return -1;
+            it += 3;
+            return ((b0 & 0x0f) << 12) | ((b1 & 0x3f) << 6) | (b2 & 0x3f);
+        }
+        if (b0 < 0xf5) {
+            if (end - it < 4)
+                return -1;
+            uint32_t b1 = it[1];
+            uint32_t b2 = it[2];
+            uint32_t b3 = it[3];
+
+            // exclude overlong encodings (f0 80..8f) and code points above 0x10ffff (f4 90..bf)
+            uint32_t low = b0 == 0xf0 ? 0x90 : 0x80;
+            uint32_t high = b0 == 0xf4 ? 0x8f : 0xbf;
+            if (b1 < low || b1 > high || (b2 & 0xc0) != 0x80 || (b3 & 0xc0) != 0x80)
+                return -1;
+            it += 4;
+            return ((b0 & 0x07) << 18) | ((b1 & 0x3f) << 12) | ((b2 & 0x3f) << 6) | (b3 & 0x3f);
+        }
+        return -1;
+    }
+
+    // ASCII fast path: check 16 characters at a time and convert them in one step
+
+#if defined(__SSE2__) || defined(_M_X64)
+
+    inline bool isAscii(const uint8_t *in) {
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))) == 0;
+    }
+
+    inline bool asciiToUtf16(const uint8_t *in, char16_t *out) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        if (_mm_movemask_epi8(a) != 0)
+            return false;
+        __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(a, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(a, zero));
+        return true;
+    }
+
+    inline bool asciiToUtf32(const uint8_t *in, char32_t *out) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        if (_mm_movemask_epi8(a) != 0)
+            return false;
+        __m128i zero = _mm_setzero_si128();
+        __m128i low = _mm_unpacklo_epi8(a, zero);
+        __m128i high = _mm_unpackhi_epi8(a, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm_unpackhi_epi16(high, zero));
+        return true;
+    }
+
+    inline bool asciiFromUtf16(const char16_t *in, char *out) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 8));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(-0x80)),
+            _mm_setzero_si128())) != 0xffff)
+        {
+            return false;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(a, b));
+        return true;
+    }
+
+    inline bool asciiFromUtf32(const char32_t *in, char *out) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 4));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 8));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 12));
+        __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, _mm_set1_epi32(-0x80)),
+            _mm_setzero_si128())) != 0xffff)
+        {
+            return false;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+            _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+        return true;
+    }
+
+    inline int countLeadBytes(const uint8_t *in) {
+        // continuation bytes 0x80 to 0xbf are less or equal to -65 when interpreted as signed
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        __m128i lead = _mm_and_si128(_mm_cmpgt_epi8(a, _mm_set1_epi8(-65)), _mm_set1_epi8(1));
+        __m128i sum = _mm_sad_epu8(lead, _mm_setzero_si128());
+        return _mm_cvtsi128_si32(sum) + _mm_extract_epi16(sum, 4);
+    }
+
+#elif defined(__ARM_NEON)
+
+    // check if any bit is set in a vector
+    inline bool any(uint8x16_t a) {
+        uint64x2_t v = vreinterpretq_u64_u8(a);
+        return (vgetq_lane_u64(v, 0) | vgetq_lane_u64(v, 1)) != 0;
+    }
+
+    inline bool isAscii(const uint8_t *in) {
+        return !any(vandq_u8(vld1q_u8(in), vdupq_n_u8(0x80)));
+    }
+
+    inline bool asciiToUtf16(const uint8_t *in, char16_t *out) {
+        uint8x16_t a = vld1q_u8(in);
+        if (any(vandq_u8(a, vdupq_n_u8(0x80))))
+            return false;
+        auto o = reinterpret_cast<uint16_t *>(out);
+        vst1q_u16(o, vmovl_u8(vget_low_u8(a)));
+        vst1q_u16(o + 8, vmovl_u8(vget_high_u8(a)));
+        return true;
+    }
+
+    inline bool asciiToUtf32(const uint8_t *in, char32_t *out) {
+        uint8x16_t a = vld1q_u8(in);
+        if (any(vandq_u8(a, vdupq_n_u8(0x80))))
+            return false;
+        auto o = reinterpret_cast<uint32_t *>(out);
+        uint16x8_t low = vmovl_u8(vget_low_u8(a));
+        uint16x8_t high = vmovl_u8(vget_high_u8(a));
+        vst1q_u32(o, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(o + 4, vmovl_u16(vget_high_u16(low)));
+        vst1q_u32(o + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(o + 12, vmovl_u16(vget_high_u16(high)));
+        return true;
+    }
+
+    inline bool asciiFromUtf16(const char16_t *in, char *out) {
+        auto i = reinterpret_cast<const uint16_t *>(in);
+        uint16x8_t a = vld1q_u16(i);
+        uint16x8_t b = vld1q_u16(i + 8);
+        if (any(vreinterpretq_u8_u16(vandq_u16(vorrq_u16(a, b), vdupq_n_u16(0xff80)))))
+            return false;
+        vst1q_u8(reinterpret_cast<uint8_t *>(out), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+        return true;
+    }
+
+    inline bool asciiFromUtf32(const char32_t *in, char *out) {
+        auto i = reinterpret_cast<const uint32_t *>(in);
+        uint32x4_t a = vld1q_u32(i);
+        uint32x4_t b = vld1q_u32(i + 4);
+        uint32x4_t c = vld1q_u32(i + 8);
+        uint32x4_t d = vld1q_u32(i + 12);
+        uint32x4_t all = vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d));
+        if (any(vreinterpretq_u8_u32(vandq_u32(all, vdupq_n_u32(0xffffff80)))))
+            return false;
+        uint16x8_t low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+        uint16x8_t high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+        vst1q_u8(reinterpret_cast<uint8_t *>(out), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+        return true;
+    }
+
+    inline int countLeadBytes(const uint8_t *in) {
+        // continuation bytes 0x80 to 0xbf are less or equal to -65 when interpreted as signed
+        uint8x16_t lead = vcgtq_s8(vreinterpretq_s8_u8(vld1q_u8(in)), vdupq_n_s8(-65));
+        uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vshrq_n_u8(lead, 7))));
+        return int(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+    }
+
+#else
+
+    // word at a time, e.g. for Cortex-M
+    using Utf8Word = std::conditional_t<sizeof(void *) >= 8, uint64_t, uint32_t>;
+    constexpr Utf8Word UTF8_HIGH = Utf8Word(0x8080808080808080ull);
+
+    inline bool isAscii(const uint8_t *in) {
+        Utf8Word words[16 / sizeof(Utf8Word)];
+        std::memcpy(words, in, 16);
+        Utf8Word all = 0;
+        for (auto word : words)
+            all |= word;
+        return (all & UTF8_HIGH) == 0;
+    }
+
+    inline bool asciiToUtf16(const uint8_t *in, char16_t *out) {
+        if (!isAscii(in))
+            return false;
+        for (int i = 0; i < 16; ++i)
+            out[i] = in[i];
+        return true;
+    }
+
+    inline bool asciiToUtf32(const uint8_t *in, char32_t *out) {
+        if (!isAscii(in))
+            return false;
+        for (int i = 0; i < 16; ++i)
+            out[i] = in[i];
+        return true;
+    }
+
+    inline bool asciiFromUtf16(const char16_t *in, char *out) {
+        uint32_t all = 0;
+        for (int i = 0; i < 16; ++i)
+            all |= in[i];
+        if (all >= 0x80)
+            return false;
+        for (int i = 0; i < 16; ++i)
+            out[i] = char(in[i]);
+        return true;
+    }
+
+    inline bool asciiFromUtf32(const char32_t *in, char *out) {
+        uint32_t all = 0;
+        for (int i = 0; i < 16; ++i)
+            all |= in[i];
+        if (all >= 0x80)
+            return false;
+        for (int i = 0; i < 16; ++i)
+            out[i] = char(in[i]);
+        return true;
+    }
+
+    inline int countLeadBytes(const uint8_t *in) {
+        // continuation bytes have bit 7 set and bit 6 cleared
+        Utf8Word words[16 / sizeof(Utf8Word)];
+        std::memcpy(words, in, 16);
+        int count = 16;
+        for (auto word : words)
+            count -= std::popcount(word & ~(word << 1) & UTF8_HIGH);
+        return count;
+    }
+
+#endif
+
+#if defined(__SSSE3__) || (defined(__ARM_NEON) && defined(__aarch64__))
+#define COCO_UTF8_LOOKUP
+
+    // UTF-8 validation using three nibble lookup tables, 16 bytes at a time. See John Keiser, Daniel Lemire,
+    // "Validating UTF-8 In Less Than One Instruction Per Byte", Software: Practice and Experience 51 (5), 2021
+    enum : uint8_t {
+        TOO_SHORT = 1 << 0, // 11______ 0_______ or 11______ 11______
+        TOO_LONG = 1 << 1, // 0_______ 10______
+        OVERLONG_3 = 1 << 2, // 11100000 100_____
+        TOO_LARGE = 1 << 3, // 11110100 1001____, 11110100 101_____ or 11110101..11111111 10______
+        SURROGATE = 1 << 4, // 11101101 101_____
+        OVERLONG_2 = 1 << 5, // 1100000_ 10______
+        TOO_LARGE_1000 = 1 << 6, // 11110101..11111111 1000____
+        OVERLONG_4 = 1 << 6, // 11110000 1000____
+        TWO_CONTS = 1 << 7, // 10______ 10______
+        CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS
+    };
+
+    // indexed by the high nibble of the first byte
+    alignas(16) constexpr uint8_t byte1HighTable[16] = {
+        // 0_______ ASCII
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        // 10______ continuation
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        // 1100____ two byte lead
+        TOO_SHORT | OVERLONG_2,
+        // 1101____ two byte lead
+        TOO_SHORT,
+        // 1110____ three byte lead
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        // 1111____ four byte lead
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+    // indexed by the low nibble of the first byte
+    alignas(16) constexpr uint8_t byte1LowTable[16] = {
+        // ____0000
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        // ____0001
+        CARRY | OVERLONG_2,
+        // ____001_
+        CARRY, CARRY,
+        // ____0100
+        CARRY | TOO_LARGE,
+        // ____0101 to ____1100
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        // ____1101
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        // ____111_
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+    // indexed by the high nibble of the second byte
+    alignas(16) constexpr uint8_t byte2HighTable[16] = {
+        // 0_______ ASCII
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        // 1000____
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        // 1001____
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        // 101_____
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        // 11______ lead
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+    // maximum values of the last three bytes of a block that do not start an incomplete sequence
+    alignas(16) constexpr uint8_t incompleteTable[16] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1};
+
+#if defined(__SSSE3__)
+
+    class Utf8Checker {
+    public:
+        void check(__m128i input) {
+            // the previous one, two and three bytes for each byte of input
+            __m128i prev1 = _mm_alignr_epi8(input, this->previous, 15);
+            __m128i prev2 = _mm_alignr_epi8(input, this->previous, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, this->previous, 13);
+
+            // errors in two byte sequences
+            __m128i mask = _mm_set1_epi8(0x0f);
+            __m128i byte1High = _mm_shuffle_epi8(load(byte1HighTable), _mm_and_si128(_mm_srli_epi16(prev1, 4), mask));
+            __m128i byte1Low = _mm_shuffle_epi8(load(byte1LowTable), _mm_and_si128(prev1, mask));
+            __m128i byte2High = _mm_shuffle_epi8(load(byte2HighTable), _mm_and_si128(_mm_srli_epi16(input, 4), mask));
+            __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+            // the third and fourth bytes of three and four byte sequences must be continuation bytes
+            __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xe0 - 0x80)));
+            __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xf0 - 0x80)));
+            __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(char(0x80)));
+            this->error = _mm_or_si128(this->error, _mm_xor_si128(must23, special));
+
+            this->incomplete = _mm_subs_epu8(input, load(incompleteTable));
+            this->previous = input;
+        }
+
+        void checkAscii() {
+            this->error = _mm_or_si128(this->error, this->incomplete);
+            this->incomplete = _mm_setzero_si128();
+            this->previous = _mm_setzero_si128();
+        }
+
+        bool valid() const {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(this->error, this->incomplete),
+                _mm_setzero_si128())) == 0xffff;
+        }
+
+    protected:
+        static __m128i load(const uint8_t *table) {return _mm_load_si128(reinterpret_cast<const __m128i *>(table));}
+
+        __m128i error = _mm_setzero_si128();
+        __m128i incomplete = _mm_setzero_si128();
+        __m128i previous = _mm_setzero_si128();
+    };
+
+    inline void checkBlock(Utf8Checker &checker, const uint8_t *in) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16));
+        if (_mm_movemask_epi8(_mm_or_si128(a, b)) == 0) {
+            checker.checkAscii();
+        } else {
+            checker.check(a);
+            checker.check(b);
+        }
+    }
+
+#else
+
+    class Utf8Checker {
+    public:
+        void check(uint8x16_t input) {
+            // the previous one, two and three bytes for each byte of input
+            uint8x16_t prev1 = vextq_u8(this->previous, input, 15);
+            uint8x16_t prev2 = vextq_u8(this->previous, input, 14);
+            uint8x16_t prev3 = vextq_u8(this->previous, input, 13);
+
+            // errors in two byte sequences
+            uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(byte1HighTable), vshrq_n_u8(prev1, 4));
+            uint8x16_t byte1Low = vqtbl1q_u8(vld1q_u8(byte1LowTable), vandq_u8(prev1, vdupq_n_u8(0x0f)));
+            uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(byte2HighTable), vshrq_n_u8(input, 4));
+            uint8x16_t special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+            // the third and fourth bytes of three and four byte sequences must be continuation bytes
+            uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80));
+            uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80));
+            uint8x16_t must23 = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+            this->error = vorrq_u8(this->error, veorq_u8(must23, special));
+
+            this->incomplete = vqsubq_u8(input, vld1q_u8(incompleteTable));
+            this->previous = input;
+        }
+
+        void checkAscii() {
+            this->error = vorrq_u8(this->error, this->incomplete);
+            this->incomplete = vdupq_n_u8(0);
+            this->previous = vdupq_n_u8(0);
+        }
+
+        bool valid() const {
+            return vmaxvq_u8(vorrq_u8(this->error, this->incomplete)) == 0;
+        }
+
+    protected:
+        uint8x16_t error = vdupq_n_u8(0);
+        uint8x16_t incomplete = vdupq_n_u8(0);
+        uint8x16_t previous = vdupq_n_u8(0);
+    };
+
+    inline void checkBlock(Utf8Checker &checker, const uint8_t *in) {
+        uint8x16_t a = vld1q_u8(in);
+        uint8x16_t b = vld1q_u8(in + 16);
+        if (vmaxvq_u8(vorrq_u8(a, b)) < 0x80) {
+            checker.checkAscii();
+        } else {
+            checker.check(a);
+            checker.check(b);
+        }
+    }
+
+#endif
+#endif
 } // namespace detail
 
 ConvertedValue<int> utf8(String str) {
@@ -184,94 +2039,169 @@ ConvertedValue<int> utf8(String str) {
     return {code, length};
 }
 
+bool isValidUtf8(String str) {
+    auto it = reinterpret_cast<const uint8_t *>(str.data());
+    auto end = it + str.size();
+#ifdef COCO_UTF8_LOOKUP
+    detail::Utf8Checker checker;
+    for (; end - it >= 32; it += 32)
+        detail::checkBlock(checker, it);
+
+    // pad the last block with zeros which also detects a truncated sequence at the end
+    uint8_t last[32] = {};
+    std::memcpy(last, it, end - it);
+    detail::checkBlock(checker, last);
+    return checker.valid();
+#else
+    while (it < end) {
+        if (end - it >= 16 && detail::isAscii(it)) {
+            it += 16;
+        } else if (*it < 0x80) {
+            ++it;
+        } else if (detail::decodeUtf8(it, end) < 0) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
 
+int countUtf8(String str) {
+    auto it = reinterpret_cast<const uint8_t *>(str.data());
+    auto end = it + str.size();
+    int count = 0;
+    for (; end - it >= 16; it += 16)
+        count += detail::countLeadBytes(it);
+    for (; it < end; ++it)
+        count += (*it & 0xc0) != 0x80;
+    return count;
+}
 
+ConvertedValue<int> utf8ToUtf16(String str, char16_t *out) {
+    auto begin = reinterpret_cast<const uint8_t *>(str.data());
+    auto end = begin + str.size();
+    auto it = begin;
+    char16_t *o = out;
+    while (it < end) {
+        if (end - it >= 16 && detail::asciiToUtf16(it, o)) {
+            it += 16;
+            o += 16;
+        } else if (*it < 0x80) {
+            *o = *it;
+            ++it;
+            ++o;
+        } else {
+            int32_t code = detail::decodeUtf8(it, end);
+            if (code < 0)
+                break;
+            if (code >= 0x10000) {
+                // surrogate pair
+                code -= 0x10000;
+                o[0] = char16_t(0xd800 + (code >> 10));
+                o[1] = char16_t(0xdc00 + (code & 0x3ff));
+                o += 2;
+            } else {
+                *o = char16_t(code);
+                ++o;
+            }
+        }
+    }
+    return {int(o - out), int(it - begin)};
+}
 
+ConvertedValue<int> utf8ToUtf32(String str, char32_t *out) {
+    auto begin = reinterpret_cast<const uint8_t *>(str.data());
+    auto end = begin + str.size();
+    auto it = begin;
+    char32_t *o = out;
+    while (it < end) {
+        if (end - it >= 16 && detail::asciiToUtf32(it, o)) {
+            it += 16;
+            o += 16;
+        } else if (*it < 0x80) {
+            *o = *it;
+            ++it;
+            ++o;
+        } else {
+            int32_t code = detail::decodeUtf8(it, end);
+            if (code < 0)
+                break;
+            *o = char32_t(code);
+            ++o;
+        }
+    }
+    return {int(o - out), int(it - begin)};
+}
 
+ConvertedValue<int> utf16ToUtf8(Array<const char16_t> str, char *out) {
+    auto begin = str.data();
+    auto end = begin + str.size();
+    auto it = begin;
+    char *o = out;
+    while (it < end) {
+        if (end - it >= 16 && detail::asciiFromUtf16(it, o)) {
+            it += 16;
+            o += 16;
+            continue;
+        }
+        uint32_t code = *it;
+        if (code - 0xd800 < 0x800) {
+            // surrogate pair
+            if (code >= 0xdc00 || end - it < 2 || uint32_t(it[1] - 0xdc00) >= 0x400)
+                break;
+            code = 0x10000 + ((code - 0xd800) << 10) + (it[1] - 0xdc00);
+            ++it;
+        }
+        ++it;
+        o = detail::encodeUtf8(o, code);
+    }
+    return {int(o - out), int(it - begin)};
+}
 
+ConvertedValue<int> utf32ToUtf8(Array<const char32_t> str, char *out) {
+    auto begin = str.data();
+    auto end = begin + str.size();
+    auto it = begin;
+    char *o = out;
+    while (it < end) {
+        if (end - it >= 16 && detail::asciiFromUtf32(it, o)) {
+            it += 16;
+            o += 16;
+            continue;
+        }
+        uint32_t code = *it;
+        if (code > 0x10ffff || code - 0xd800 < 0x800)
+            break;
+        ++it;
+        o = detail::encodeUtf8(o, code);
+    }
+    return {int(o - out), int(it - begin)};
+}
 
 
 
-//
 
 
 
-std::optional<int> parseInt(String str) {
-    if (str.size() <= 0)
-        return {};
 
-    // check for sign
-    int i = 0;
-    bool minus = str[0] == '-';
-    if (minus || str[0] == '+') {
-        if (str.size() == 1)
-            return {};
-        i = 1;
-    }
 
-    // parse integer
-    int value = 0;
-    for (; i < str.size(); ++i) {
-        uint8_t ch = str[i];
-        if (ch >= '0' && ch <= '9') {
-            value = value * 10 + ch - '0';
-        } else {
-            // invalid character
-            return {};
-        }
-    }
 
-    return minus ? -value : value;
-}
+//
 
-std::optional<float> parseFloat(String str) {
-    if (str.size() <= 0)
-        return {};
 
-    // check for sign
-    int i = 0;
-    bool minus = str[0] == '-';
-    if (minus || str[0] == '+') {
-        if (str.size() == 1)
-            return {};
-        i = 1;
-    }
 
-    // check if there is only a decimal point
-    if (str.size() == i + 1 && str[i] == '.')
+std::optional<int> parseInt(String str) {
+    auto result = dec<int>(str);
+    if (!result)
         return {};
+    return *result;
+}
 
-    // parse integer part
-    float value = 0.0f;
-    for (; i < str.size(); ++i) {
-        char ch = str[i];
-        if (ch == '.') {
-            ++i;
-            break;
-        } else if (ch >= '0' && ch <= '9') {
-            float digit = ch - '0';
-            value = value * 10.0f + digit;
-        } else {
-            // invalid character
-            return {};
-        }
-    }
-
-    // parse decimal places
-    float decimal = 1.0f;
-    for (; i < str.size(); ++i) {
-        char ch = str[i];
-        if (ch >= '0' && ch <= '9') {
-            float digit = ch - '0';
-            decimal *= 0.1f;
-            value += digit * decimal;
-        } else {
-            // invalid character
-            return {};
-        }
-    }
-
-    return minus ? -value : value;
+std::optional<float> parseFloat(String str) {
+    auto result = dec<float>(str);
+    if (!result)
+        return {};
+    return *result;
 }
 /*
 int toString(int length, char *str, uint32_t value, int digitCount) {
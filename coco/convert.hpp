@@ -3,7 +3,9 @@
 #include "Array.hpp"
 #include "String.hpp"
 #include <atomic>
+#include <limits>
 #include <optional>
+#include <span>
 
 
 namespace coco {
@@ -52,47 +54,103 @@ struct ConvertedBuffer {
 namespace detail {
     char *dec(char *end, uint32_t value, int digitCount);
     char *dec(char *end, uint64_t value, int digitCount);
+    char *dec(char *end, float value, int digitCount, int decimalCount);
     char *dec(char *end, double value, int digitCount, int decimalCount);
+    char *decShortest(char *end, float value);
+    char *decShortest(char *end, double value);
+
+    // value / 10000 using multiply and shift for cores without hardware divider (e.g. Cortex-M0), exact for all 32 bit
+    // values
+    constexpr uint32_t div10000Reciprocal(uint32_t value) {
+        return uint32_t((uint64_t(value) * 0xd1b71759u) >> 45);
+    }
 
     char *hex(char *end, uint32_t value, int digitCount);
     char *hex(char *end, uint64_t value, int digitCount);
 
-    char *utf8(char *end, uint32_t code);
-} // namespace detail
+    // format one line of a hex dump with up to 16 bytes, needs HEX_DUMP_LINE_SIZE characters
+    constexpr int HEX_DUMP_LINE_SIZE = 79;
+    char *hexDumpLine(char *out, const uint8_t *data, int length, uint32_t address);
 
-/// @brief Convert a decimal string to an integer.
-/// @tparam T Integer type
-/// @param str String
-/// @return Converted integer and number of characters used
-template <typename T>
-ConvertedValue<T> dec(String str) {
-    int i = 0;
+    char *utf8(char *end, uint32_t code);
 
-    // check for sign
-    bool minus = false;
-    if constexpr (std::is_signed_v<T>) {
-        // signed
-        if (str.size() > 0) {
-            minus = str[0] == '-';
-            if (minus || str[0] == '+') {
+    // parse a decimal number at the start of a string, return number of characters used or zero on error
+    int parseDec(const char *data, int length, uint64_t &value);
+    int parseDec(const char *data, int length, float &value);
+    int parseDec(const char *data, int length, double &value);
+
+    template <typename T> requires (std::is_integral_v<T>)
+    int parseDec(const char *data, int length, T &value) {
+        // check for sign
+        int i = 0;
+        bool minus = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (length > 0 && (data[0] == '-' || data[0] == '+')) {
+                minus = data[0] == '-';
                 i = 1;
             }
         }
-    }
 
-    // parse integer
-    T value = 0;
-    for (; i < str.size(); ++i) {
-        uint8_t ch = str[i];
-        if (ch >= '0' && ch <= '9') {
-            value = value * 10 + ch - '0';
-        } else {
-            // invalid character
-            return {};
-        }
+        // parse and check for overflow, the negative range is larger by one
+        uint64_t v;
+        int n = parseDec(data + i, length - i, v);
+        if (n == 0 || v > uint64_t(std::numeric_limits<T>::max()) + minus)
+            return 0;
+        value = minus ? T(0 - v) : T(v);
+        return i + n;
     }
+} // namespace detail
 
-    return {minus ? -value : value, i};
+/// @brief Convert a decimal string to an integer or floating point number. Integers are parsed eight digits at a time,
+/// floating point numbers support exponents (e.g. 1.5e-3), nan and inf and are correctly rounded.
+/// @tparam T Integer or floating point type (float or double)
+/// @param str String
+/// @return Converted value and number of characters used, length is zero if the string is not a valid number or an
+/// integer does not fit into T
+template <typename T> requires (std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>)
+ConvertedValue<T> dec(String str) {
+    T value;
+    int length = detail::parseDec(str.data(), str.size(), value);
+    if (length == 0 || length != str.size())
+        return {};
+    return {value, length};
+}
+
+/// @brief Parse a stream of numbers separated by a delimiter and/or white space in one pass, e.g. "1.5,2,3\n4,5,6"
+/// @tparam T Integer or floating point type (float or double)
+/// @param str String to parse
+/// @param values Span of values to fill
+/// @param delimiter Delimiter character, white space (space, tab, carriage return and line feed) is also accepted
+/// @return Number of values and number of characters used up to the end of the last value. Stops at the first invalid
+/// number or when values is full
+template <typename T, size_t N> requires (std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>)
+ConvertedValue<int> parseMany(String str, std::span<T, N> values, char delimiter = ',') {
+    auto isSeparator = [delimiter](char ch) {
+        return ch == delimiter || ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    };
+    const char *data = str.data();
+    int length = str.size();
+    int i = 0;
+    int count = 0;
+    int used = 0;
+    while (count < int(values.size())) {
+        // skip separators
+        while (i < length && isSeparator(data[i]))
+            ++i;
+        if (i >= length)
+            break;
+
+        // parse value, must be followed by a separator or the end
+        T value;
+        int n = detail::parseDec(data + i, length - i, value);
+        if (n == 0 || (i + n < length && !isSeparator(data[i + n])))
+            break;
+        values[count] = value;
+        ++count;
+        i += n;
+        used = i;
+    }
+    return {count, used};
 }
 
 /// @brief Convert an integer value to a decimal string.
@@ -171,7 +229,13 @@ template <typename T> requires (std::is_floating_point_v<T>)
 auto dec(const T &value, int digitCount, int decimalCount, int minWidth = 0) {
     ConvertedBuffer<24> buffer;
     char *end = std::end(buffer.data);
-    char *it = detail::dec(end, double(value), std::clamp(digitCount, 0, 11), std::clamp(decimalCount, -11, 11));
+    char *it;
+    if constexpr (std::is_same_v<T, float>) {
+        // fast path for single precision floating point
+        it = detail::dec(end, value, std::clamp(digitCount, 0, 11), std::clamp(decimalCount, -11, 11));
+    } else {
+        it = detail::dec(end, double(value), std::clamp(digitCount, 0, 11), std::clamp(decimalCount, -11, 11));
+    }
     if (minWidth > 0) {
         auto begin = std::min(it, end - std::min(minWidth, 12));
         while (it > begin) {
@@ -193,6 +257,25 @@ auto dec(const T &value, int decimalCount = 3) {
 }
 
 
+/// @brief Convert a floating point value to the shortest decimal string that converts back to the same value, e.g.
+/// 0.1f -> "0.1", 1e21 -> "1e21". Uses scientific notation if the decimal point is far away from the digits.
+/// @param value Value
+/// @return Buffer that can convert itself to coco::String (via operator String)
+template <typename T> requires (std::is_floating_point_v<T>)
+auto decShortest(const T &value) {
+    ConvertedBuffer<24> buffer;
+    char *end = std::end(buffer.data);
+    char *it;
+    if constexpr (std::is_same_v<T, float>)
+        it = detail::decShortest(end, value);
+    else
+        it = detail::decShortest(end, double(value));
+    buffer.begin = it;
+    buffer.length = end - it;
+    return buffer;
+}
+
+
 /// @brief Convert an atomic integer or enum to a decimal string.
 /// @param value Value
 /// @return Buffer that can convert itself to coco::String (via operator String)
@@ -273,6 +356,35 @@ auto hex(const std::atomic<T> &value, int digitCount = sizeof(T) * 2, int minWid
 }
 
 
+/// @brief Encode binary data as a hex string with lower case digits, e.g. {0x12, 0xab} -> "12ab". Processes 16 bytes at a
+/// time using SIMD instructions (SSE2/SSSE3, NEON) or a machine word at a time on other platforms.
+/// @param data Data to encode
+/// @param out Output buffer, must have space for 2 * data.size() characters
+/// @return End of the hex string in the output buffer
+char *hexEncode(Array<const uint8_t> data, char *out);
+
+/// @brief Decode a hex string into binary data, upper and lower case digits are accepted.
+/// @param str String to decode
+/// @param out Output buffer, must have space for str.size() / 2 bytes
+/// @return Number of bytes and number of characters used, stops at the first invalid pair of digits. The whole string
+/// was valid if the length equals str.size()
+ConvertedValue<int> hexDecode(String str, uint8_t *out);
+
+/// @brief Write a hex dump of binary data to a stream (e.g. debug::out or StringBuffer), one line of 16 bytes at a time:
+/// 00000010  48 65 6c 6c 6f 2c 20 77  6f 72 6c 64 21 0a 00 ff  |Hello, world!...|
+/// @param s Stream
+/// @param data Data to dump
+/// @param address Address of the first byte shown at the start of each line
+template <typename S>
+void hexDump(S &s, Array<const uint8_t> data, uint32_t address = 0) {
+    char line[detail::HEX_DUMP_LINE_SIZE];
+    for (int i = 0; i < data.size(); i += 16) {
+        char *end = detail::hexDumpLine(line, data.data() + i, std::min(data.size() - i, 16), address + i);
+        s << String(line, end - line);
+    }
+}
+
+
 /// @brief Convert an UTF-8 string to a character code point.
 /// 1 byte: 0xxxxxxx
 /// 2 byte: 110xxxxx 10xxxxxx
@@ -282,6 +394,43 @@ auto hex(const std::atomic<T> &value, int digitCount = sizeof(T) * 2, int minWid
 /// @return Code and length
 ConvertedValue<int> utf8(String str);
 
+/// @brief Check if a string is valid UTF-8, i.e. has no truncated sequences, overlong encodings, surrogates or code
+/// points above 0x10ffff. Uses lookup tables to check 32 bytes at a time when SSSE3 or AArch64 NEON is available,
+/// otherwise skips 16 bytes of ASCII at a time
+/// @param str String to check
+/// @return true if valid
+bool isValidUtf8(String str);
+
+/// @brief Count the code points of an UTF-8 string by counting the bytes that are not continuation bytes
+/// @param str Valid UTF-8 string
+/// @return Number of code points
+int countUtf8(String str);
+
+/// @brief Convert an UTF-8 string to UTF-16, converts 16 ASCII characters at a time
+/// @param str UTF-8 string to convert
+/// @param out Output buffer, must have space for str.size() code units
+/// @return Number of UTF-16 code units and number of characters used, stops at the first invalid sequence
+ConvertedValue<int> utf8ToUtf16(String str, char16_t *out);
+
+/// @brief Convert an UTF-8 string to UTF-32, converts 16 ASCII characters at a time
+/// @param str UTF-8 string to convert
+/// @param out Output buffer, must have space for str.size() code points
+/// @return Number of code points and number of characters used, stops at the first invalid sequence
+ConvertedValue<int> utf8ToUtf32(String str, char32_t *out);
+
+/// @brief Convert an UTF-16 string to UTF-8, converts 16 ASCII characters at a time
+/// @param str UTF-16 string to convert
+/// @param out Output buffer, must have space for 3 * str.size() characters
+/// @return Number of characters and number of code units used, stops at the first unpaired surrogate
+ConvertedValue<int> utf16ToUtf8(Array<const char16_t> str, char *out);
+
+/// @brief Convert an UTF-32 string to UTF-8, converts 16 ASCII characters at a time
+/// @param str UTF-32 string to convert
+/// @param out Output buffer, must have space for 4 * str.size() characters
+/// @return Number of characters and number of code points used, stops at the first surrogate or code point above
+/// 0x10ffff
+ConvertedValue<int> utf32ToUtf8(Array<const char32_t> str, char *out);
+
 /// @brief Convert a character code point to an UTF-8 string.
 /// @param code Code point to convert
 /// @return Buffer that has an operator String
@@ -312,7 +461,7 @@ inline auto utf8(int code) {
 std::optional<int> parseInt(String str);
 
 /**
- * Convert string to floating point number in the form x.y without support for exponential notation
+ * Convert string to floating point number, e.g. 1.5 or 1.5e-3
  * @param str string to convert
  * @return optional floating point number, defined if conversion was successful
  */
@@ -6,5 +6,10 @@ namespace debug {
 
 Out out;
 
+#ifdef __GNUC__
+// default for platforms where write() is synchronous
+__attribute__((weak)) void flush() {}
+#endif
+
 } // namespace debug
 } // namespace coco
@@ -79,6 +79,10 @@ void sleep(Microseconds<> time);
 void write(const char *message, int length);
 inline void write(const String &message) {write(message.data(), message.size());}
 
+/// @brief Wait until all messages are written to the debug console. Needed on platforms where write() is asynchronous
+/// (e.g. native where each thread writes to a lock-free buffer and a background thread writes to stdout)
+void flush();
+
 struct Out {
     /// @brief Stream a single character into the debug output.
     ///
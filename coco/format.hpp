@@ -0,0 +1,400 @@
+#pragma once
+
+#include "ArrayBuffer.hpp"
+#include "convert.hpp"
+#include "String.hpp"
+#include "StringConcept.hpp"
+#include <bit>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+namespace coco {
+
+/// @brief Format string that can be used as template parameter, e.g. format<"x={}">(buffer, x)
+/// @tparam N size of the string literal including terminating null
+template <size_t N>
+struct FormatString {
+    consteval FormatString(const char (&str)[N]) {
+        for (size_t i = 0; i < N; ++i)
+            this->data[i] = str[i];
+    }
+
+    char data[N];
+};
+
+namespace detail {
+    // field of a format string: {} or {:[0][width][.precision][type]}
+    struct FormatField {
+        // literal text before the field
+        int literalBegin = 0;
+        int literalLength = 0;
+
+        // pad with zeros instead of spaces (integers only)
+        bool zero = false;
+
+        // minimum width
+        int width = 0;
+
+        // number of decimals (floating point only), -1 for default
+        int precision = -1;
+
+        // maximum number of decimals supported by dec()
+        static constexpr int MAX_PRECISION = 11;
+
+        // type: 0 for default, 'd', 'x', 'f', 'g', 's' or 'c'
+        char type = 0;
+    };
+
+    // parsed format string, the literal text is unescaped ({{ and }})
+    template <size_t N, int C>
+    struct FormatData {
+        char text[N] = {};
+        FormatField fields[C + 1] = {};
+    };
+
+    consteval int parseNumber(const char *str, int &i) {
+        int value = 0;
+        while (str[i] >= '0' && str[i] <= '9') {
+            value = value * 10 + str[i] - '0';
+            ++i;
+        }
+        return value;
+    }
+
+    template <size_t N>
+    consteval int countFormatFields(const char (&str)[N]) {
+        int count = 0;
+        for (int i = 0; i < int(N) - 1; ++i) {
+            if ((str[i] == '{' || str[i] == '}') && str[i + 1] == str[i]) {
+                ++i;
+            } else if (str[i] == '{') {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    template <int C, size_t N>
+    consteval FormatData<N, C> parseFormat(const char (&str)[N]) {
+        FormatData<N, C> data;
+        int length = 0;
+        int literalBegin = 0;
+        int fieldIndex = 0;
+        int i = 0;
+        while (i < int(N) - 1) {
+            char ch = str[i];
+            if ((ch == '{' || ch == '}') && str[i + 1] == ch) {
+                // escaped brace
+                data.text[length++] = ch;
+                i += 2;
+            } else if (ch == '{') {
+                FormatField &field = data.fields[fieldIndex++];
+                field.literalBegin = literalBegin;
+                field.literalLength = length - literalBegin;
+                ++i;
+                if (str[i] == ':') {
+                    ++i;
+                    if (str[i] == '0') {
+                        field.zero = true;
+                        ++i;
+                    }
+                    field.width = parseNumber(str, i);
+                    if (str[i] == '.') {
+                        ++i;
+                        if (str[i] < '0' || str[i] > '9')
+                            throw "format: precision expected after '.'";
+                        field.precision = parseNumber(str, i);
+                        if (field.precision > FormatField::MAX_PRECISION)
+                            throw "format: precision must be at most 11";
+                    }
+                    ch = str[i];
+                    if (ch == 'd' || ch == 'x' || ch == 'f' || ch == 'g' || ch == 's' || ch == 'c') {
+                        field.type = ch;
+                        ++i;
+                    }
+                }
+                if (str[i] != '}')
+                    throw "format: invalid format field";
+                ++i;
+                literalBegin = length;
+            } else if (ch == '}') {
+                throw "format: unmatched '}'";
+            } else {
+                data.text[length++] = ch;
+                ++i;
+            }
+        }
+
+        // literal text after the last field
+        FormatField &tail = data.fields[C];
+        tail.literalBegin = literalBegin;
+        tail.literalLength = length - literalBegin;
+        return data;
+    }
+
+    template <FormatString F>
+    struct Format {
+        static constexpr int FIELD_COUNT = countFormatFields(F.data);
+        static constexpr auto data = parseFormat<FIELD_COUNT>(F.data);
+    };
+
+    // powers of ten for counting decimal digits
+    constexpr uint64_t formatPow10[20] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+        100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull};
+
+    inline int decimalDigitCount(uint64_t value) {
+        // log10(2) is approximately 1233 / 4096
+        int n = (std::bit_width(value) * 1233) >> 12;
+        return n + (value >= formatPow10[n]) + (value == 0);
+    }
+
+    template <typename T>
+    constexpr bool IsFormatString = StringConcept<T> && !std::is_same_v<T, char>;
+
+    // check if the type and precision of a field are applicable to an argument type
+    template <typename T>
+    consteval bool formatFieldValid(FormatField field) {
+        char type = field.type;
+        if constexpr (std::is_enum_v<T>) {
+            return formatFieldValid<std::underlying_type_t<T>>(field);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return type == 0 || type == 'f' || type == 'g';
+        } else if (field.precision >= 0) {
+            // precision is only supported for floating point
+            return false;
+        } else if constexpr (IsFormatString<T>) {
+            return type == 0 || type == 's';
+        } else if constexpr (std::is_same_v<T, char>) {
+            return type == 0 || type == 'c';
+        } else {
+            return type == 0 || type == 'd' || type == 'x';
+        }
+    }
+
+    // maximum length of a formatted value that does not depend on the value, excluding strings
+    template <typename T>
+    consteval int formatMaxLength(FormatField field) {
+        if (!formatFieldValid<T>(field))
+            throw "format: type or precision of format field does not match the argument";
+        int length;
+        if constexpr (std::is_enum_v<T>) {
+            return formatMaxLength<std::underlying_type_t<T>>(field);
+        } else if constexpr (IsFormatString<T>) {
+            length = 0;
+        } else if constexpr (std::is_same_v<T, char>) {
+            length = 1;
+        } else if constexpr (std::is_integral_v<T>) {
+            if (field.type == 'x')
+                length = sizeof(T) * 2;
+            else
+                length = sizeof(T) <= 4 ? 11 : 20;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // same as the ConvertedBuffer of dec() and decShortest()
+            length = 24;
+        } else {
+            static_assert(std::is_floating_point_v<T>, "format: unsupported argument type");
+        }
+        return std::max(length, field.width);
+    }
+
+    // length of a formatted value that is only known at runtime (strings)
+    template <typename T>
+    int formatDynamicLength(const T &value) {
+        if constexpr (IsFormatString<T>)
+            return String(value).size();
+        else
+            return 0;
+    }
+
+    inline char *formatPad(char *out, int count, char ch = ' ') {
+        for (int i = 0; i < count; ++i)
+            out[i] = ch;
+        return out + std::max(count, 0);
+    }
+
+    // format a value, out must have space for formatMaxLength() + formatDynamicLength() characters
+    template <FormatField field, typename T>
+    char *formatValue(char *out, const T &value) {
+        if constexpr (std::is_enum_v<T>) {
+            return formatValue<field>(out, std::underlying_type_t<T>(value));
+        } else if constexpr (IsFormatString<T>) {
+            String str(value);
+            out = formatPad(out, field.width - str.size());
+            std::memcpy(out, str.data(), str.size());
+            return out + str.size();
+        } else if constexpr (std::is_same_v<T, char>) {
+            out = formatPad(out, field.width - 1);
+            *out = value;
+            return out + 1;
+        } else if constexpr (std::is_integral_v<T>) {
+            using U = std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>;
+            if constexpr (field.type == 'x') {
+                // hex of the unsigned value
+                U v = U(std::make_unsigned_t<T>(value));
+                int n = std::max(int(std::bit_width(v) + 3) >> 2, 1);
+                if (field.zero)
+                    n = std::max(n, field.width);
+                else
+                    out = formatPad(out, field.width - n);
+                detail::hex(out + n, v, n);
+                return out + n;
+            } else {
+                // decimal
+                bool negative = false;
+                U v = U(value);
+                if constexpr (std::is_signed_v<T>) {
+                    negative = value < 0;
+                    if (negative)
+                        v = 0 - v;
+                }
+                int n = decimalDigitCount(v);
+                if (field.zero) {
+                    n = std::max(n, field.width - negative);
+                } else {
+                    out = formatPad(out, field.width - n - negative);
+                }
+                if (negative)
+                    *out++ = '-';
+                detail::dec(out + n, v, n);
+                return out + n;
+            }
+        } else {
+            // floating point: convert backwards from the end of the maximum length, then move to the front
+            char *end = out + formatMaxLength<T>(field);
+            char *begin;
+            if constexpr (field.type == 'g') {
+                if constexpr (std::is_same_v<T, float>)
+                    begin = detail::decShortest(end, value);
+                else
+                    begin = detail::decShortest(end, double(value));
+            } else {
+                constexpr int decimalCount = field.precision >= 0 ? -field.precision : 3;
+                if constexpr (std::is_same_v<T, float>)
+                    begin = detail::dec(end, value, 1, decimalCount);
+                else
+                    begin = detail::dec(end, double(value), 1, decimalCount);
+            }
+            int length = end - begin;
+            out = formatPad(out, field.width - length);
+            std::memmove(out, begin, length);
+            return out + length;
+        }
+    }
+
+    template <FormatString F, int I, typename T>
+    char *formatField(char *out, const T &value) {
+        using Format = detail::Format<F>;
+        constexpr FormatField field = Format::data.fields[I];
+        std::memcpy(out, Format::data.text + field.literalBegin, field.literalLength);
+        return formatValue<field>(out + field.literalLength, value);
+    }
+
+    template <FormatString F, typename ...Args>
+    char *format(char *out, const Args &...args) {
+        using Format = detail::Format<F>;
+        [&out, &args...]<size_t ...I>(std::index_sequence<I...>) {
+            ((out = formatField<F, I>(out, args)), ...);
+        }(std::index_sequence_for<Args...>{});
+        constexpr FormatField tail = Format::data.fields[Format::FIELD_COUNT];
+        std::memcpy(out, Format::data.text + tail.literalBegin, tail.literalLength);
+        return out + tail.literalLength;
+    }
+
+    // format a field into a temporary buffer, strings are written directly to the stream
+    template <FormatString F, int I, typename S, typename T>
+    char *streamField(S &s, char *begin, char *out, const T &value) {
+        if constexpr (IsFormatString<T>) {
+            using Format = detail::Format<F>;
+            constexpr FormatField field = Format::data.fields[I];
+            String str(value);
+            std::memcpy(out, Format::data.text + field.literalBegin, field.literalLength);
+            out = formatPad(out + field.literalLength, field.width - str.size());
+            s << String(begin, out - begin);
+            s << str;
+            return begin;
+        } else {
+            return formatField<F, I>(out, value);
+        }
+    }
+
+    template <FormatString F, typename S, typename ...Args>
+    void formatStream(S &s, char *begin, const Args &...args) {
+        using Format = detail::Format<F>;
+        char *out = begin;
+        [&s, begin, &out, &args...]<size_t ...I>(std::index_sequence<I...>) {
+            ((out = streamField<F, I>(s, begin, out, args)), ...);
+        }(std::index_sequence_for<Args...>{});
+        constexpr FormatField tail = Format::data.fields[Format::FIELD_COUNT];
+        std::memcpy(out, Format::data.text + tail.literalBegin, tail.literalLength);
+        out += tail.literalLength;
+        if (out > begin)
+            s << String(begin, out - begin);
+    }
+
+    template <FormatString F, typename ...Args>
+    consteval int formatMaxLength() {
+        using Format = detail::Format<F>;
+        static_assert(Format::FIELD_COUNT == sizeof...(Args), "format: number of arguments does not match the format string");
+        int length = 0;
+        for (int i = 0; i <= Format::FIELD_COUNT; ++i)
+            length += Format::data.fields[i].literalLength;
+        return [&length]<size_t ...I>(std::index_sequence<I...>) {
+            return (length + ... + formatMaxLength<Args>(Format::data.fields[I]));
+        }(std::index_sequence_for<Args...>{});
+    }
+} // namespace detail
+
+/// @brief Maximum length of a formatted string excluding the length of string arguments
+/// @tparam F format string
+/// @tparam Args argument types
+template <FormatString F, typename ...Args>
+constexpr int formatMaxLength = detail::formatMaxLength<F, Args...>();
+
+/// @brief Format into a buffer using a format string that gets parsed at compile time. Each {} field formats one
+/// argument using the converters of convert.hpp, the format of a field is {:[0][width][.precision][type]}:
+/// 0: pad integers with zeros instead of spaces
+/// width: minimum width
+/// precision: number of decimals of floating point numbers (at most 11), default is up to 3 without trailing zeros
+/// type: d (decimal), x (hex), f (fixed point), g (shortest round trip), s (string), c (character)
+/// A precision on other than floating point arguments or a type that does not match the argument (e.g. {:x} on a
+/// float) is a compile time error
+/// Example: format<"x={} y={:04x} z={:.2}\n">(buffer, x, y, z);
+/// The arguments are formatted directly into the buffer without bounds checks if the maximum length fits, otherwise
+/// the output gets clipped
+/// @tparam F format string, use {{ and }} for literal braces
+/// @param buffer buffer to append to
+/// @param args arguments: integers, enums, float, double, char and strings
+template <FormatString F, int N, typename ...Args>
+void format(ArrayBuffer<char, N> &buffer, const Args &...args) {
+    constexpr int maxLength = formatMaxLength<F, Args...>;
+    if (N - buffer.length >= (maxLength + ... + detail::formatDynamicLength(args))) {
+        // fast path without bounds checks
+        char *end = detail::format<F>(buffer.data() + buffer.length, args...);
+        buffer.length = end - buffer.data();
+#ifdef DEBUG
+        buffer.buffer[buffer.length] = 0;
+#endif
+    } else {
+        // append via a temporary buffer which clips the output
+        char temp[maxLength > 0 ? maxLength : 1];
+        detail::formatStream<F>(buffer, temp, args...);
+    }
+}
+
+/// @brief Format into a stream (e.g. debug::out), see format() for ArrayBuffer. The formatted text is written to the
+/// stream in one call, except for string arguments which are written separately
+/// @tparam F format string, use {{ and }} for literal braces
+/// @param s stream
+/// @param args arguments: integers, enums, float, double, char and strings
+template <FormatString F, typename S, typename ...Args>
+void format(S &s, const Args &...args) {
+    constexpr int maxLength = formatMaxLength<F, Args...>;
+    char temp[maxLength > 0 ? maxLength : 1];
+    detail::formatStream<F>(s, temp, args...);
+}
+
+} // namespace coco
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+
+
+namespace coco {
+
+namespace detail {
+    // read 32 bit little endian word, also at compile time
+    constexpr uint32_t read32(const char *p) {
+        if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+            return uint32_t(uint8_t(p[0])) | (uint32_t(uint8_t(p[1])) << 8) | (uint32_t(uint8_t(p[2])) << 16)
+                | (uint32_t(uint8_t(p[3])) << 24);
+        }
+        uint32_t value;
+        std::memcpy(&value, p, 4);
+        return value;
+    }
+
+    // read 1 to 3 bytes
+    constexpr uint32_t read24(const char *p, int k) {
+        return (uint32_t(uint8_t(p[0])) << 16) | (uint32_t(uint8_t(p[k >> 1])) << 8) | uint32_t(uint8_t(p[k - 1]));
+    }
+
+    // 32x32 to 64 bit multiplication which is a single instruction on Cortex-M3/M4 (UMULL)
+    constexpr void mix(uint32_t &a, uint32_t &b) {
+        uint64_t c = uint64_t(a ^ 0x53c5ca59u) * uint64_t(b ^ 0x74743c1bu);
+        a = uint32_t(c);
+        b = uint32_t(c >> 32);
+    }
+} // namespace detail
+
+/// @brief Calculate the djb2 hash of a string which processes one byte at a time.
+/// http://www.cse.yorku.ca/~oz/hash.html
+/// @param data string data
+/// @param length string length
+/// @return djb2 hash
+constexpr uint32_t djb2(const char *data, int length) {
+    uint32_t h = 5381;
+    for (int i = 0; i < length; ++i) {
+        h = (h << 5) + h + uint8_t(data[i]); // hash * 33 + c
+    }
+    return h;
+}
+
+/// @brief Calculate a fast non-cryptographic hash of a string which processes 8 bytes at a time.
+/// Based on wyhash32 (https://github.com/wangyi-fudan/wyhash), can be evaluated at compile time.
+/// @param data string data
+/// @param length string length
+/// @param seed seed
+/// @return hash
+constexpr uint32_t hash(const char *data, int length, uint32_t seed = 0) {
+    auto p = data;
+    int i = length;
+    uint32_t seed1 = uint32_t(length);
+    detail::mix(seed, seed1);
+    for (; i > 8; i -= 8, p += 8) {
+        seed ^= detail::read32(p);
+        seed1 ^= detail::read32(p + 4);
+        detail::mix(seed, seed1);
+    }
+    if (i >= 4) {
+        seed ^= detail::read32(p);
+        seed1 ^= detail::read32(p + i - 4);
+    } else if (i > 0) {
+        seed ^= detail::read24(p, i);
+    }
+    detail::mix(seed, seed1);
+    detail::mix(seed, seed1);
+    return seed ^ seed1;
+}
+
+/// @brief Check at compile time that the hashes of a list of strings are unique, e.g.
+/// static_assert(hashesUnique({"start", "stop"}));
+/// @tparam T string type, e.g. coco::String, defaults to std::string_view so that string literals can be passed
+/// @param strings list of strings
+/// @return true if no two strings have the same hash
+template <typename T = std::string_view>
+consteval bool hashesUnique(std::initializer_list<std::type_identity_t<T>> strings) {
+    for (auto a = strings.begin(); a != strings.end(); ++a) {
+        uint32_t h = hash(a->data(), a->size());
+        for (auto b = strings.begin(); b != a; ++b) {
+            if (hash(b->data(), b->size()) == h)
+                return false;
+        }
+    }
+    return true;
+}
+
+/// @brief User defined literal for the hash of a string literal, e.g. for a switch statement:
+/// switch (str.hash()) {case "start"_hash: ...}
+/// @return hash of the string literal
+consteval uint32_t operator ""_hash(const char *str, size_t length) {
+    return hash(str, int(length));
+}
+
+} // namespace coco
@@ -0,0 +1,152 @@
+#include "EventLoop.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+
+namespace coco {
+
+EventLoop::EventLoop() {
+    this->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    this->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = this->eventFd;
+    epoll_ctl(this->epollFd, EPOLL_CTL_ADD, this->eventFd, &event);
+}
+
+EventLoop::~EventLoop() {
+    close(this->eventFd);
+    close(this->epollFd);
+}
+
+EventLoop::Time EventLoop::now() {
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return Time(int(std::chrono::duration_cast<std::chrono::milliseconds>(time).count()));
+}
+
+void EventLoop::run() {
+    this->running = true;
+    while (this->running)
+        runOnce();
+}
+
+void EventLoop::runOnce(bool wait) {
+    if (this->ring != nullptr)
+        this->ring->submit();
+
+    // sleep until the first timer expires or forever if there is nothing to do
+    int timeout = -1;
+    if (!wait || !this->yieldList.empty())
+        timeout = 0;
+    else if (!this->sleepList.empty())
+        timeout = std::max((this->sleepList.getFirstTime() - now()).value, 0);
+
+    epoll_event events[64];
+    int count = epoll_wait(this->epollFd, events, std::size(events), timeout);
+    for (int i = 0; i < count; ++i) {
+        auto &event = events[i];
+        int fd = event.data.fd;
+        if (fd == this->eventFd) {
+            handleMessages();
+        } else if (this->ring != nullptr && fd == this->ring->getEventFd()) {
+            this->ring->poll();
+        } else if (fd < int(this->watches.size()) && this->watches[fd]) {
+            // resume all tasks that wait for one of the events (errors are reported to all) and whose operation
+            // does not have to wait anymore
+            auto &watch = *this->watches[fd];
+            uint32_t ready = event.events;
+            watch.doAll([ready](FdTask &task) {
+                uint32_t result = ready & (task.events | EPOLLERR | EPOLLHUP);
+                task.result = result;
+                return result != 0 && (task.operation == nullptr || task.operation(task));
+            });
+
+            // unregister events nobody waits for anymore
+            update(watch);
+        }
+    }
+
+    this->sleepList.doUntil(now());
+    this->yieldList.doAll();
+}
+
+void EventLoop::remove(int fd) {
+    if (fd >= int(this->watches.size()) || !this->watches[fd])
+        return;
+    auto &watch = *this->watches[fd];
+    if (watch.mask != 0) {
+        epoll_ctl(this->epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        watch.mask = 0;
+    }
+    watch.doAll([](FdTask &task) {
+        task.result = 0;
+        return true;
+    });
+
+    // coroutines may have started waiting again, keep the watch as remove() may be called from a waiting coroutine
+    update(watch);
+}
+
+void EventLoop::attach(IoUring &ring) {
+    this->ring = &ring;
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = ring.getEventFd();
+    epoll_ctl(this->epollFd, EPOLL_CTL_ADD, ring.getEventFd(), &event);
+}
+
+void EventLoop::wakeup() {
+    // only the first wakeup writes to the eventfd until the loop has handled it
+    if (!this->notified.exchange(true)) {
+        uint64_t one = 1;
+        ::write(this->eventFd, &one, sizeof(one));
+    }
+}
+
+EventLoop::Watch &EventLoop::getWatch(int fd) {
+    if (fd >= int(this->watches.size()))
+        this->watches.resize(fd + 1);
+    auto &watch = this->watches[fd];
+    if (!watch)
+        watch = std::make_unique<Watch>(*this, fd);
+    return *watch;
+}
+
+void EventLoop::update(Watch &watch) {
+    uint32_t mask = 0;
+    watch.visitAll([&mask](FdTask &task) {
+        mask |= task.events;
+    });
+    if (mask == watch.mask)
+        return;
+
+    epoll_event event = {};
+    event.events = mask;
+    event.data.fd = watch.fd;
+    if (mask == 0) {
+        epoll_ctl(this->epollFd, EPOLL_CTL_DEL, watch.fd, nullptr);
+    } else if (watch.mask == 0) {
+        // the file descriptor may still be registered if remove() was not called before it was closed and reused
+        if (epoll_ctl(this->epollFd, EPOLL_CTL_ADD, watch.fd, &event) != 0 && errno == EEXIST)
+            epoll_ctl(this->epollFd, EPOLL_CTL_MOD, watch.fd, &event);
+    } else {
+        if (epoll_ctl(this->epollFd, EPOLL_CTL_MOD, watch.fd, &event) != 0 && errno == ENOENT)
+            epoll_ctl(this->epollFd, EPOLL_CTL_ADD, watch.fd, &event);
+    }
+    watch.mask = mask;
+}
+
+void EventLoop::handleMessages() {
+    uint64_t value;
+    ::read(this->eventFd, &value, sizeof(value));
+
+    // clear before popping so that a message posted after the last pop wakes up the loop again
+    this->notified.store(false);
+    while (auto message = this->messages.pop())
+        message->callback();
+}
+
+} // namespace coco
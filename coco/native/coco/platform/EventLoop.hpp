@@ -0,0 +1,209 @@
+#pragma once
+
+#include "IoUring.hpp"
+#include <coco/Callback.hpp>
+#include <coco/Coroutine.hpp>
+#include <coco/IntrusiveMpscQueue.hpp>
+#include <coco/Time.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <sys/epoll.h>
+
+
+namespace coco {
+
+/// @brief Event loop for Linux based on epoll that drives coroutines. The loop sleeps in epoll_wait() until a timer
+/// expires, a file descriptor becomes ready or a message gets posted from another thread, therefore it uses no CPU when
+/// idle. Use from one thread only, except for post() and wakeup() which can be called from any thread.
+///
+/// Use like this:
+/// Coroutine foo(EventLoop &loop, int fd) {
+///     while (true) {
+///         co_await loop.readable(fd);
+///         // read from fd until EAGAIN
+///         co_await loop.sleep(100ms);
+///     }
+/// }
+/// EventLoop loop;
+/// foo(loop, fd);
+/// loop.run();
+class EventLoop {
+public:
+    using Time = TimeMilliseconds<>;
+
+    /// @brief Task that waits for a file descriptor to become ready
+    ///
+    class FdTask : public CoroutineTask {
+    public:
+        // non-blocking operation, returns false if it has to wait (EAGAIN)
+        using Operation = bool (*)(FdTask &task);
+
+        FdTask(std::coroutine_handle<> handle, uint32_t events, Operation operation = nullptr)
+            : CoroutineTask(handle), events(events), operation(operation) {}
+
+        // events to wait for (EPOLLIN, EPOLLOUT, EPOLLPRI)
+        uint32_t events;
+
+        // optional operation that gets tried immediately and when the file descriptor is ready, the task only
+        // waits while the operation returns false (e.g. used by Socket)
+        Operation operation;
+
+        // events that occurred, also EPOLLERR and EPOLLHUP, 0 if the file descriptor was removed
+        uint32_t result = 0;
+    };
+
+    /// @brief Awaitable for a file descriptor, co_await returns the events that occurred
+    ///
+    struct FdAwaitable : public Awaitable<FdTask> {
+        using Awaitable<FdTask>::Awaitable;
+
+        uint32_t await_resume() const noexcept {return this->task.result;}
+
+        uint32_t result() const noexcept {return this->task.result;}
+    };
+
+    /// @brief Message that gets posted from another thread, the callback gets called in the thread of the loop
+    ///
+    struct Message : public IntrusiveMpscQueueNode {
+        Callback callback;
+    };
+
+
+    EventLoop();
+    ~EventLoop();
+
+    /// @brief Check if the construction was successful
+    ///
+    bool isValid() const {return this->epollFd != -1 && this->eventFd != -1;}
+
+    /// @brief Get the current time (milliseconds since an arbitrary point in time, e.g. system start)
+    ///
+    static Time now();
+
+    /// @brief Run the loop until exit() gets called
+    ///
+    void run();
+
+    /// @brief Run one iteration of the loop: submit I/O, wait for events (or only poll) and resume the coroutines
+    /// @param wait true to wait until something happens, false to return immediately
+    void runOnce(bool wait = true);
+
+    /// @brief Let run() return after the current iteration
+    ///
+    void exit() {this->running = false;}
+
+    /// @brief Yield control to other coroutines, resumes in the next iteration
+    /// @return use co_await on return value to wait
+    [[nodiscard]] Awaitable<> yield() {
+        return {this->yieldList};
+    }
+
+    /// @brief Sleep until the given time
+    /// @param time time point
+    /// @return use co_await on return value to wait
+    [[nodiscard]] Awaitable<CoroutineTimedTask> sleep(Time time) {
+        return {this->sleepList, time};
+    }
+
+    /// @brief Sleep for the given duration
+    /// @param duration duration
+    /// @return use co_await on return value to wait
+    [[nodiscard]] Awaitable<CoroutineTimedTask> sleep(Milliseconds<> duration) {
+        return {this->sleepList, now() + duration};
+    }
+
+    /// @brief Wait until a file descriptor is ready, level triggered. Multiple coroutines can wait for the same
+    /// file descriptor
+    /// @param fd file descriptor, should be non-blocking
+    /// @param events events to wait for (EPOLLIN, EPOLLOUT, EPOLLPRI)
+    /// @return use co_await on return value to wait, returns the events that occurred
+    [[nodiscard]] FdAwaitable wait(int fd, uint32_t events) {
+        return {getWatch(fd), events};
+    }
+
+    /// @brief Wait until a file descriptor is readable
+    /// @param fd file descriptor, should be non-blocking
+    /// @return use co_await on return value to wait, returns the events that occurred
+    [[nodiscard]] FdAwaitable readable(int fd) {
+        return wait(fd, EPOLLIN);
+    }
+
+    /// @brief Wait until a file descriptor is writable
+    /// @param fd file descriptor, should be non-blocking
+    /// @return use co_await on return value to wait, returns the events that occurred
+    [[nodiscard]] FdAwaitable writable(int fd) {
+        return wait(fd, EPOLLOUT);
+    }
+
+    /// @brief Remove a file descriptor from the loop, call before closing it. Waiting coroutines get resumed with
+    /// result 0
+    /// @param fd file descriptor
+    void remove(int fd);
+
+    /// @brief Attach an io_uring instance, the loop then submits its operations once per iteration and resumes the
+    /// coroutines when they have completed
+    /// @param ring io_uring instance, must live until the loop gets destroyed
+    void attach(IoUring &ring);
+
+    /// @brief Post a message from any thread, the callback gets called in the thread of the loop. The message must
+    /// remain valid until the callback was called
+    /// @param message message
+    void post(Message &message) {
+        this->messages.push(message);
+        wakeup();
+    }
+
+    /// @brief Wake up the loop from any thread
+    ///
+    void wakeup();
+
+protected:
+    friend class Socket;
+
+    // list of tasks waiting for a file descriptor
+    class Watch : public TaskList<FdTask> {
+    public:
+        Watch(EventLoop &loop, int fd) : loop(loop), fd(fd) {}
+
+        void add(FdTask &task) {
+            // no need to wait if the operation succeeds immediately
+            if (task.operation != nullptr && task.operation(task))
+                return;
+            TaskList<FdTask>::add(task);
+
+            // only register when new events get requested
+            if ((task.events & ~this->mask) != 0)
+                this->loop.update(*this);
+        }
+
+        EventLoop &loop;
+        int fd;
+
+        // events that are registered at epoll
+        uint32_t mask = 0;
+    };
+
+    Watch &getWatch(int fd);
+    void update(Watch &watch);
+    void handleMessages();
+
+    int epollFd;
+    int eventFd;
+    bool running = false;
+
+    TaskList<CoroutineTask> yieldList;
+    CoroutineTimedTaskList sleepList;
+
+    // watched file descriptors, indexed by file descriptor
+    std::vector<std::unique_ptr<Watch>> watches;
+
+    // messages from other threads, notified is true while a wakeup is pending
+    IntrusiveMpscQueue<Message> messages;
+    std::atomic<bool> notified = false;
+
+    IoUring *ring = nullptr;
+};
+
+} // namespace coco
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <coco/Array.hpp>
 #include <coco/enum.hpp>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #ifdef _WIN32
 #define NOMINMAX
@@ -14,7 +17,12 @@
 #else
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+#ifdef __linux__
+#include "IoUring.hpp"
 #endif
 
 
@@ -24,6 +32,8 @@ namespace fs = std::filesystem;
 
 /**
  * Simple file wrapper only for internal use such as in emulator drivers. Otherwise use coco-file
+ * In memory-mapped mode (see map()) the file contents are also accessible as an array of bytes and read(), write()
+ * and fill() copy from/to memory instead of doing a system call
  */
 class File {
 public:
@@ -54,6 +64,7 @@ public:
      * Destructor
      */
     ~File() {
+        unmap();
 #ifdef _WIN32
         CloseHandle(this->file);
 #else
@@ -86,27 +97,41 @@ public:
     }
 
     /**
-     * Set size of file
+     * Set size of file. Growing with value 0 only extends the file (sparse if supported by the file system), growing
+     * with another value reserves the space and fills it with large writes
      * @param value initial value
      */
     void resize(int64_t size, uint8_t value = 0) {
-        if (value != 0) {
-            int currentSize = getSize();
-            if (currentSize <= size) {
-                fill(currentSize, value, size - currentSize);
-                return;
-            }
+        int64_t currentSize = getSize();
+        if (value != 0 && currentSize < size) {
+#ifdef __linux__
+            // allocate in one piece, ignore errors as fill() allocates anyway
+            fallocate(this->file, 0, currentSize, size - currentSize);
+#endif
+            fillFile(currentSize, value, size - currentSize);
+            remap();
+            return;
         }
 #ifdef _WIN32
+        // a file can't be resized while it is mapped
+        bool mapped = this->mapped;
+        unmap();
         LONG high = size >> 32;
         SetFilePointer(this->file, size, &high, FILE_BEGIN);
         SetEndOfFile(this->file);
+        if (mapped)
+            map();
 #else
         ftruncate(this->file, size);
+        remap();
 #endif
     }
 
     int read(int64_t offset, void *data, int length) {
+        if (offset >= 0 && offset + length <= this->view.size()) {
+            std::memcpy(data, this->view.data() + offset, length);
+            return length;
+        }
 #ifdef _WIN32
         DWORD numRead;
         OVERLAPPED overlapped;
@@ -120,6 +145,10 @@ public:
     }
 
     int write(int64_t offset, const void *data, int length) {
+        if (this->writable && offset >= 0 && offset + length <= this->view.size()) {
+            std::memcpy(this->view.data() + offset, data, length);
+            return length;
+        }
 #ifdef _WIN32
         DWORD numWritten;
         OVERLAPPED overlapped;
@@ -133,21 +162,211 @@ public:
     }
 
     void fill(int64_t offset, uint8_t value, int length) {
-        uint8_t buffer[16] = {value, value, value, value, value, value, value, value, value, value, value, value, value, value, value, value};
-        int count = length >> 4;
-        for (int i = 0; i < count; ++i)
-            write(offset + i * 16, buffer, 16);
-        int remaining = length & 15;
-        if (remaining > 0)
-            write(offset + count * 16, buffer, remaining);
+        if (this->writable && offset >= 0 && offset + length <= this->view.size()) {
+            std::memset(this->view.data() + offset, value, length);
+            return;
+        }
+        if (value == 0 && length > 0) {
+            int64_t size = getSize();
+            if (offset >= size) {
+                // zeros after the end of the file: extend the file, the file system creates a hole if possible
+                resize(offset + length);
+                return;
+            }
+#ifdef __linux__
+            // zeros inside the file: deallocate the range, fails e.g. on file systems without hole support
+            int64_t end = std::min(offset + length, size);
+            if (fallocate(this->file, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, end - offset) == 0) {
+                // extend the file if the range goes past the end
+                if (offset + length > size)
+                    resize(offset + length);
+                return;
+            }
+#endif
+        }
+        fillFile(offset, value, length);
+    }
+
+#ifdef __linux__
+    /**
+     * Read asynchronously using io_uring or its thread pool, the operation gets submitted on the next ring.submit()
+     * @param ring io_uring instance
+     * @param offset offset in the file
+     * @param data data to read into, must remain valid until the operation has completed
+     * @param length length of data
+     * @return use co_await on return value to wait for completion, returns the number of bytes read
+     */
+    [[nodiscard]] IoUring::Awaitable readAsync(IoUring &ring, int64_t offset, void *data, int length) {
+        return ring.read(this->file, offset, data, length);
+    }
+
+    /**
+     * Write asynchronously using io_uring or its thread pool, the operation gets submitted on the next ring.submit()
+     * @param ring io_uring instance
+     * @param offset offset in the file
+     * @param data data to write, must remain valid until the operation has completed
+     * @param length length of data
+     * @return use co_await on return value to wait for completion, returns the number of bytes written
+     */
+    [[nodiscard]] IoUring::Awaitable writeAsync(IoUring &ring, int64_t offset, const void *data, int length) {
+        return ring.write(this->file, offset, data, length);
+    }
+
+    /**
+     * Register the file as fixed file of an io_uring instance, unregister before the file gets destroyed
+     */
+    bool registerFile(IoUring &ring) {
+        return ring.registerFile(this->file);
+    }
+
+    void unregisterFile(IoUring &ring) {
+        ring.unregisterFile(this->file);
+    }
+#endif
+
+    /**
+     * Map the file into memory (MAP_SHARED). The mapping follows resize() and gets removed by unmap() or the destructor
+     * @return view of the file contents, empty if the file is empty or can't be mapped. Valid until the next resize()
+     */
+    Array<uint8_t> map() {
+        unmap();
+        this->mapped = true;
+        int64_t size = getSize();
+        if (size <= 0)
+            return {};
+#ifdef _WIN32
+        this->mapping = CreateFileMappingW(this->file, nullptr, this->writable ? PAGE_READWRITE : PAGE_READONLY,
+            DWORD(size >> 32), DWORD(size), nullptr);
+        if (this->mapping == nullptr)
+            return {};
+        void *data = MapViewOfFile(this->mapping, this->writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+        if (data == nullptr)
+            return {};
+#else
+        void *data = mmap(nullptr, size, this->writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, this->file, 0);
+        if (data == MAP_FAILED)
+            return {};
+#endif
+        this->view = {static_cast<uint8_t *>(data), int(size)};
+        return this->view;
+    }
+
+    /**
+     * Remove the mapping of the file
+     */
+    void unmap() {
+        this->mapped = false;
+        if (!this->view.empty()) {
+#ifdef _WIN32
+            UnmapViewOfFile(this->view.data());
+#else
+            munmap(this->view.data(), this->view.size());
+#endif
+            this->view = {};
+        }
+#ifdef _WIN32
+        if (this->mapping != nullptr) {
+            CloseHandle(this->mapping);
+            this->mapping = nullptr;
+        }
+#endif
+    }
+
+    /**
+     * Check if the file is in memory-mapped mode
+     */
+    bool isMapped() {
+        return this->mapped;
+    }
+
+    /**
+     * Get the view of the mapped file contents
+     * @return view of the file contents, empty if the file is not mapped
+     */
+    Array<uint8_t> getView() {
+        return this->view;
+    }
+
+    /**
+     * Write modified data to the storage device (msync() of the mapping and fsync() of the file)
+     */
+    void flush() {
+#ifdef _WIN32
+        if (!this->view.empty())
+            FlushViewOfFile(this->view.data(), 0);
+        FlushFileBuffers(this->file);
+#else
+        if (!this->view.empty())
+            msync(this->view.data(), this->view.size(), MS_SYNC);
+        fsync(this->file);
+#endif
     }
 
 protected:
+    static constexpr int FILL_BUFFER_SIZE = 4096;
+
+    // fill using system calls with a large buffer, also grows the file
+    void fillFile(int64_t offset, uint8_t value, int64_t length) {
+        uint8_t buffer[FILL_BUFFER_SIZE];
+        std::memset(buffer, value, std::min(length, int64_t(FILL_BUFFER_SIZE)));
+#ifdef _WIN32
+        while (length > 0) {
+            int n = int(std::min(length, int64_t(FILL_BUFFER_SIZE)));
+            if (write(offset, buffer, n) <= 0)
+                break;
+            offset += n;
+            length -= n;
+        }
+#else
+        // write up to FILL_IOV_COUNT times the buffer with one system call
+        constexpr int FILL_IOV_COUNT = 256;
+        iovec vectors[FILL_IOV_COUNT];
+        while (length > 0) {
+            int count = 0;
+            int64_t n = 0;
+            while (count < FILL_IOV_COUNT && n < length) {
+                int size = int(std::min(length - n, int64_t(FILL_BUFFER_SIZE)));
+                vectors[count++] = {buffer, size_t(size)};
+                n += size;
+            }
+            auto written = pwritev(this->file, vectors, count, offset);
+            if (written <= 0)
+                break;
+            offset += written;
+            length -= written;
+        }
+#endif
+    }
+
+    // adjust the mapping to the current file size
+    void remap() {
+        if (!this->mapped)
+            return;
+#ifdef __linux__
+        int64_t size = getSize();
+        if (!this->view.empty() && size > 0) {
+            // grow or shrink in place or move
+            void *data = mremap(this->view.data(), this->view.size(), size, MREMAP_MAYMOVE);
+            if (data != MAP_FAILED) {
+                this->view = {static_cast<uint8_t *>(data), int(size)};
+                return;
+            }
+        }
+#endif
+        map();
+    }
+
 #ifdef _WIN32
     HANDLE file;
+    HANDLE mapping = nullptr;
 #else
     int file;
 #endif
+    bool writable;
+
+    // memory-mapped mode
+    bool mapped = false;
+    Array<uint8_t> view;
 };
 COCO_ENUM(File::Mode)
 
@@ -163,6 +382,7 @@ inline File::File(const fs::path &filename, Mode mode) {
 #else
     this->file = open(filename.c_str(), O_CREAT | int(mode), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
 #endif
+    this->writable = (mode & Mode::WRITE) == Mode::WRITE || (mode & Mode::READ_WRITE) == Mode::READ_WRITE;
 }
 
 } // namespace coco
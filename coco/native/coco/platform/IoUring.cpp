@@ -0,0 +1,447 @@
+#include "IoUring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+namespace coco {
+
+namespace {
+    // system calls, there is no wrapper in the C library
+    int ioUringSetup(unsigned entries, io_uring_params *params) {
+        return int(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    int ioUringRegister(int fd, unsigned opcode, const void *arg, unsigned count) {
+        return int(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    // check if the kernel supports the operations. IORING_OP_READ and IORING_OP_WRITE need Linux 5.6, older kernels
+    // create the ring but complete each operation with -EINVAL. The probe is also available since 5.6
+    bool probeOperations(int ringFd) {
+        constexpr int OP_COUNT = 64;
+        alignas(io_uring_probe) uint8_t buffer[sizeof(io_uring_probe) + OP_COUNT * sizeof(io_uring_probe_op)] = {};
+        auto probe = reinterpret_cast<io_uring_probe *>(buffer);
+        if (ioUringRegister(ringFd, IORING_REGISTER_PROBE, probe, OP_COUNT) != 0)
+            return false;
+        for (int op : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED,
+            IORING_OP_ASYNC_CANCEL})
+        {
+            if (op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    // the kernel reads and writes the ring indices concurrently
+    uint32_t loadAcquire(uint32_t *p) {
+        return std::atomic_ref<uint32_t>(*p).load(std::memory_order_acquire);
+    }
+
+    void storeRelease(uint32_t *p, uint32_t value) {
+        std::atomic_ref<uint32_t>(*p).store(value, std::memory_order_release);
+    }
+} // namespace
+
+
+IoUring::IoUring(int entries, Backend backend, int threadCount) {
+    std::fill(std::begin(this->files), std::end(this->files), -1);
+    this->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->eventFd == -1)
+        return;
+    if (backend != Backend::THREADS && setupUring(entries))
+        return;
+    if (backend == Backend::URING) {
+        close(this->eventFd);
+        this->eventFd = -1;
+        return;
+    }
+    startThreads(threadCount);
+}
+
+IoUring::~IoUring() {
+    // ignore the completions of operations that are still in progress
+    for (auto task : this->slots) {
+        if (task != nullptr)
+            task->slot = -1;
+    }
+
+    if (!this->threads.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->running = false;
+        }
+        uint64_t count = this->threads.size();
+        ::write(this->jobFd, &count, sizeof(count));
+        for (auto &thread : this->threads)
+            thread.join();
+        close(this->jobFd);
+    }
+    if (this->ringFd != -1) {
+        // closing the ring waits for the operations in progress
+        munmap(this->sqes, this->sqesSize);
+        if (this->cqRing != this->sqRing)
+            munmap(this->cqRing, this->cqRingSize);
+        munmap(this->sqRing, this->sqRingSize);
+        close(this->ringFd);
+    }
+    if (this->eventFd != -1)
+        close(this->eventFd);
+}
+
+bool IoUring::registerFile(int file) {
+    if (!this->filesRegistered)
+        return false;
+    auto it = std::find(std::begin(this->files), std::end(this->files), -1);
+    if (it == std::end(this->files))
+        return false;
+    io_uring_files_update update = {};
+    update.offset = unsigned(it - this->files);
+    update.fds = uint64_t(uintptr_t(&file));
+    if (ioUringRegister(this->ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) != 1)
+        return false;
+    *it = file;
+    return true;
+}
+
+void IoUring::unregisterFile(int file) {
+    auto it = std::find(std::begin(this->files), std::end(this->files), file);
+    if (it == std::end(this->files))
+        return;
+    int none = -1;
+    io_uring_files_update update = {};
+    update.offset = unsigned(it - this->files);
+    update.fds = uint64_t(uintptr_t(&none));
+    ioUringRegister(this->ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1);
+    *it = -1;
+}
+
+bool IoUring::registerBuffers(Array<const Array<uint8_t>> buffers) {
+    if (this->ringFd == -1)
+        return false;
+    if (!this->buffers.empty()) {
+        ioUringRegister(this->ringFd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        this->buffers.clear();
+    }
+    if (buffers.empty())
+        return true;
+    std::vector<iovec> vectors;
+    for (auto &buffer : buffers)
+        vectors.push_back({buffer.data(), size_t(buffer.size())});
+    if (ioUringRegister(this->ringFd, IORING_REGISTER_BUFFERS, vectors.data(), unsigned(vectors.size())) != 0)
+        return false;
+    for (auto &buffer : buffers)
+        this->buffers.push_back(buffer);
+    return true;
+}
+
+void IoUring::submit() {
+    prepareCancels();
+
+    // prepare queued operations, the queue may contain more operations than fit into the rings
+    while (!this->queued.empty()) {
+        auto &task = static_cast<Task &>(*this->queued.next);
+        if (!prepare(task))
+            break;
+        task.remove();
+    }
+    if (this->ringFd == -1)
+        return;
+
+    // submit all prepared entries with one system call
+    while (this->toSubmit > 0) {
+        int result = ioUringEnter(this->ringFd, this->toSubmit, 0, 0);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        this->toSubmit -= result;
+        if (result == 0)
+            break;
+    }
+}
+
+int IoUring::poll() {
+    submit();
+    return complete(false);
+}
+
+int IoUring::wait() {
+    submit();
+    if (this->inFlight == 0)
+        return complete(false);
+    return complete(true);
+}
+
+bool IoUring::setupUring(int entries) {
+    io_uring_params params = {};
+    this->ringFd = ioUringSetup(entries, &params);
+    if (this->ringFd < 0) {
+        this->ringFd = -1;
+        return false;
+    }
+
+    // use the thread pool on kernels that do not support all operations
+    if (!probeOperations(this->ringFd)) {
+        close(this->ringFd);
+        this->ringFd = -1;
+        return false;
+    }
+
+    // map the submission and completion rings (one mapping on newer kernels) and the submission queue entries
+    this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single)
+        this->sqRingSize = this->cqRingSize = std::max(this->sqRingSize, this->cqRingSize);
+    this->sqRing = mmap(nullptr, this->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd,
+        IORING_OFF_SQ_RING);
+    this->cqRing = single || this->sqRing == MAP_FAILED ? this->sqRing : mmap(nullptr, this->cqRingSize,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_CQ_RING);
+    this->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    this->sqes = mmap(nullptr, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd,
+        IORING_OFF_SQES);
+    if (this->sqRing == MAP_FAILED || this->cqRing == MAP_FAILED || this->sqes == MAP_FAILED) {
+        if (this->sqes != MAP_FAILED)
+            munmap(this->sqes, this->sqesSize);
+        if (this->cqRing != MAP_FAILED && this->cqRing != this->sqRing)
+            munmap(this->cqRing, this->cqRingSize);
+        if (this->sqRing != MAP_FAILED)
+            munmap(this->sqRing, this->sqRingSize);
+        close(this->ringFd);
+        this->ringFd = -1;
+        return false;
+    }
+
+    auto sq = static_cast<uint8_t *>(this->sqRing);
+    this->sqHead = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+    this->sqTail = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+    this->sqMask = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+    this->sqEntries = params.sq_entries;
+    this->sqArray = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+    auto cq = static_cast<uint8_t *>(this->cqRing);
+    this->cqHead = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+    this->cqTail = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+    this->cqMask = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+    this->cqEntries = params.cq_entries;
+    this->cqes = cq + params.cq_off.cqes;
+
+    // signal completions on the eventfd
+    ioUringRegister(this->ringFd, IORING_REGISTER_EVENTFD, &this->eventFd, 1);
+
+    // sparse table for fixed files
+    this->filesRegistered = ioUringRegister(this->ringFd, IORING_REGISTER_FILES, this->files, FILE_COUNT) == 0;
+    return true;
+}
+
+void IoUring::startThreads(int threadCount) {
+    // semaphore that counts the jobs
+    this->jobFd = eventfd(0, EFD_SEMAPHORE | EFD_CLOEXEC);
+    for (int i = 0; i < std::max(threadCount, 1); ++i)
+        this->threads.emplace_back([this] {run();});
+}
+
+void IoUring::run() {
+    while (true) {
+        // wait for a job
+        uint64_t value;
+        if (::read(this->jobFd, &value, sizeof(value)) < 0)
+            continue;
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (!this->running)
+            break;
+        Job job = this->jobs.front();
+        this->jobs.pop_front();
+        lock.unlock();
+
+        // blocking system call
+        ssize_t result = job.op == Op::READ
+            ? pread(job.file, job.data, job.length, job.offset)
+            : pwrite(job.file, job.data, job.length, job.offset);
+        if (result < 0)
+            result = -errno;
+
+        lock.lock();
+        this->completions.push_back({job.slot, int(result)});
+        uint64_t one = 1;
+        ::write(this->eventFd, &one, sizeof(one));
+    }
+}
+
+void IoUring::cancel(int slot) {
+    // keep the slot until the completion arrives so that it does not get reused
+    this->slots[slot] = nullptr;
+    if (this->ringFd != -1)
+        this->cancels.push_back(slot);
+}
+
+int IoUring::allocateSlot(Task *task) {
+    int slot;
+    if (!this->freeSlots.empty()) {
+        slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+        this->slots[slot] = task;
+    } else {
+        slot = int(this->slots.size());
+        this->slots.push_back(task);
+    }
+    ++this->inFlight;
+    return slot;
+}
+
+bool IoUring::prepare(Task &task) {
+    if (this->ringFd == -1) {
+        // thread pool
+        task.slot = allocateSlot(&task);
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->jobs.push_back({task.slot, task.op, task.file, task.offset, task.data, task.length});
+        }
+        uint64_t one = 1;
+        ::write(this->jobFd, &one, sizeof(one));
+        return true;
+    }
+
+    // limit the operations in progress so that the completion queue can't overflow
+    uint32_t tail = *this->sqTail;
+    uint32_t head = loadAcquire(this->sqHead);
+    if (tail - head >= this->sqEntries || uint32_t(this->inFlight) >= this->cqEntries)
+        return false;
+    auto sqes = static_cast<io_uring_sqe *>(this->sqes);
+
+    task.slot = allocateSlot(&task);
+    uint32_t index = tail & this->sqMask;
+    io_uring_sqe &sqe = sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = task.op == Op::READ ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe.fd = task.file;
+    sqe.off = uint64_t(task.offset);
+    sqe.addr = uint64_t(uintptr_t(task.data));
+    sqe.len = unsigned(task.length);
+    sqe.user_data = uint64_t(task.slot);
+
+    // use fixed file and fixed buffer if registered
+    auto file = std::find(std::begin(this->files), std::end(this->files), task.file);
+    if (file != std::end(this->files)) {
+        sqe.fd = int(file - this->files);
+        sqe.flags |= IOSQE_FIXED_FILE;
+    }
+    auto data = static_cast<const uint8_t *>(task.data);
+    for (size_t i = 0; i < this->buffers.size(); ++i) {
+        auto &buffer = this->buffers[i];
+        if (data >= buffer.begin() && data + task.length <= buffer.end()) {
+            sqe.opcode = task.op == Op::READ ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            sqe.buf_index = uint16_t(i);
+            break;
+        }
+    }
+
+    this->sqArray[index] = index;
+    storeRelease(this->sqTail, tail + 1);
+    ++this->toSubmit;
+    return true;
+}
+
+void IoUring::prepareCancels() {
+    if (this->cancels.empty())
+        return;
+    uint32_t tail = *this->sqTail;
+    uint32_t head = loadAcquire(this->sqHead);
+    auto sqes = static_cast<io_uring_sqe *>(this->sqes);
+    while (!this->cancels.empty() && tail - head < this->sqEntries && uint32_t(this->inFlight) < this->cqEntries) {
+        uint32_t index = tail & this->sqMask;
+        io_uring_sqe &sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        sqe.fd = -1;
+        sqe.addr = uint64_t(this->cancels.back());
+        sqe.user_data = CANCEL_TAG;
+        this->sqArray[index] = index;
+        this->cancels.pop_back();
+        ++tail;
+        ++this->inFlight;
+        ++this->toSubmit;
+    }
+    storeRelease(this->sqTail, tail);
+}
+
+int IoUring::complete(bool wait) {
+    clearEventFd();
+    if (this->ringFd == -1) {
+        // thread pool
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (wait) {
+            // the workers notify through the eventfd, block until it becomes readable
+            while (this->completions.empty()) {
+                lock.unlock();
+                pollfd p = {this->eventFd, POLLIN, 0};
+                ::poll(&p, 1, -1);
+                clearEventFd();
+                lock.lock();
+            }
+        }
+        std::vector<Completion> completions;
+        std::swap(completions, this->completions);
+        lock.unlock();
+        for (auto &completion : completions)
+            finish(completion.slot, completion.result);
+    } else {
+        if (wait) {
+            while (loadAcquire(this->cqTail) == *this->cqHead) {
+                if (ioUringEnter(this->ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                    break;
+            }
+        }
+        uint32_t head = *this->cqHead;
+        uint32_t tail = loadAcquire(this->cqTail);
+        auto cqes = static_cast<io_uring_cqe *>(this->cqes);
+        for (; head != tail; ++head) {
+            io_uring_cqe &cqe = cqes[head & this->cqMask];
+            if (cqe.user_data == CANCEL_TAG)
+                --this->inFlight;
+            else
+                finish(int(cqe.user_data), cqe.res);
+        }
+        storeRelease(this->cqHead, head);
+    }
+
+    // resume the coroutines
+    int count = 0;
+    while (!this->completed.empty()) {
+        ++count;
+        this->completed.doFirst();
+    }
+    return count;
+}
+
+void IoUring::finish(int slot, int result) {
+    --this->inFlight;
+    Task *task = this->slots[slot];
+    this->slots[slot] = nullptr;
+    this->freeSlots.push_back(slot);
+    if (task != nullptr) {
+        task->slot = -1;
+        task->result = result;
+        this->completed.add(*task);
+    }
+}
+
+void IoUring::clearEventFd() {
+    uint64_t value;
+    ::read(this->eventFd, &value, sizeof(value));
+}
+
+} // namespace coco
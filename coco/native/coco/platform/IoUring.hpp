@@ -0,0 +1,268 @@
+#pragma once
+
+#include <coco/Array.hpp>
+#include <coco/Coroutine.hpp>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace coco {
+
+/// @brief Asynchronous file I/O for Linux using io_uring, with a thread pool as fallback when io_uring is not available
+/// (old kernel or blocked by seccomp, e.g. in containers). Operations get queued by read() and write() (or
+/// File::readAsync() and File::writeAsync()) and are submitted in one batch by the next call of submit(), poll() or
+/// wait(). On completion, the waiting coroutines get resumed from poll() or wait() through a TaskList.
+/// Register files and buffers with registerFile() and registerBuffers(), then operations on them use fixed files and
+/// buffers (zero-copy for large transfers) automatically.
+/// Use from one thread only (e.g. the event loop), getEventFd() becomes readable when completions are available.
+/// Buffers must remain valid until the operation has completed, also when the waiting coroutine gets destroyed.
+class IoUring {
+public:
+    enum class Backend {
+        // use io_uring if available, otherwise a thread pool
+        AUTO,
+
+        // use io_uring only, isValid() returns false if not available
+        URING,
+
+        // use a thread pool
+        THREADS
+    };
+
+    enum class Op : uint8_t {
+        READ,
+        WRITE
+    };
+
+    /// @brief Task of an operation
+    ///
+    class Task : public CoroutineTask {
+    public:
+        Task(std::coroutine_handle<> handle, IoUring *ring, Op op, int file, int64_t offset, void *data, int length)
+            : CoroutineTask(handle), ring(ring), op(op), file(file), offset(offset), data(data), length(length) {}
+
+        Task(Task &&task) noexcept : CoroutineTask(std::move(task)) {
+            take(task);
+        }
+
+        Task &operator =(Task &&task) noexcept {
+            orphan();
+            CoroutineTask::operator =(std::move(task));
+            take(task);
+            return *this;
+        }
+
+        ~Task() {
+            orphan();
+        }
+
+        void cancel() noexcept {
+            orphan();
+            remove();
+        }
+
+        IoUring *ring;
+        Op op;
+        int file;
+        int64_t offset;
+        void *data;
+        int length;
+
+        // number of bytes transferred or negative error code (e.g. -EBADF)
+        int result = 0;
+
+        // index in the slot table while the operation is submitted, -1 otherwise
+        int slot = -1;
+
+    protected:
+        void take(Task &task) {
+            this->ring = task.ring;
+            this->op = task.op;
+            this->file = task.file;
+            this->offset = task.offset;
+            this->data = task.data;
+            this->length = task.length;
+            this->result = task.result;
+            this->slot = task.slot;
+            task.slot = -1;
+            if (this->slot >= 0)
+                this->ring->slots[this->slot] = this;
+        }
+
+        // detach from a submitted operation, the completion gets ignored
+        void orphan() {
+            if (this->slot >= 0) {
+                this->ring->cancel(this->slot);
+                this->slot = -1;
+            }
+        }
+    };
+
+    /// @brief Awaitable of an operation, co_await returns the number of bytes transferred or a negative error code
+    ///
+    struct Awaitable : public coco::Awaitable<Task> {
+        using coco::Awaitable<Task>::Awaitable;
+
+        int await_resume() const noexcept {return this->task.result;}
+
+        /// @brief Get the result when the operation has finished
+        /// @return number of bytes transferred or negative error code
+        int result() const noexcept {return this->task.result;}
+    };
+
+
+    /// @brief Constructor
+    /// @param entries number of entries of the submission queue, gets rounded up to a power of two
+    /// @param backend backend to use
+    /// @param threadCount number of threads of the thread pool
+    explicit IoUring(int entries = 256, Backend backend = Backend::AUTO, int threadCount = 4);
+
+    ~IoUring();
+
+    /// @brief Check if the construction was successful
+    ///
+    bool isValid() const {return this->eventFd != -1;}
+
+    /// @brief Check if io_uring is used
+    ///
+    bool isUring() const {return this->ringFd != -1;}
+
+    /// @brief Get an eventfd that becomes readable when completions are available, e.g. for epoll
+    ///
+    int getEventFd() const {return this->eventFd;}
+
+    /// @brief Read from a file, same as File::readAsync()
+    /// @param file file descriptor
+    /// @param offset offset in the file
+    /// @param data data to read into
+    /// @param length length of data
+    /// @return use co_await on return value to wait for completion, returns the number of bytes read
+    [[nodiscard]] Awaitable read(int file, int64_t offset, void *data, int length) {
+        return {this->queued, this, Op::READ, file, offset, data, length};
+    }
+
+    /// @brief Write to a file, same as File::writeAsync()
+    /// @param file file descriptor
+    /// @param offset offset in the file
+    /// @param data data to write
+    /// @param length length of data
+    /// @return use co_await on return value to wait for completion, returns the number of bytes written
+    [[nodiscard]] Awaitable write(int file, int64_t offset, const void *data, int length) {
+        return {this->queued, this, Op::WRITE, file, offset, const_cast<void *>(data), length};
+    }
+
+    /// @brief Register a file descriptor so that operations on it use a fixed file (less overhead per operation)
+    /// @param file file descriptor
+    /// @return true if successful, false if the table is full or io_uring is not used
+    bool registerFile(int file);
+
+    /// @brief Unregister a file descriptor, call before closing the file
+    /// @param file file descriptor
+    void unregisterFile(int file);
+
+    /// @brief Register buffers so that operations inside them use fixed buffers (zero-copy). Replaces the previously
+    /// registered buffers, therefore call only when no operations on registered buffers are in progress
+    /// @param buffers buffers
+    /// @return true if successful, false if io_uring is not used or the buffers exceed the locked memory limit
+    bool registerBuffers(Array<const Array<uint8_t>> buffers);
+
+    /// @brief Submit all queued operations
+    ///
+    void submit();
+
+    /// @brief Submit queued operations and resume the coroutines of completed operations, does not block
+    /// @return number of completed operations
+    int poll();
+
+    /// @brief Submit queued operations, wait until at least one operation has completed and resume the coroutines
+    /// of completed operations. Returns immediately if no operations are in progress
+    /// @return number of completed operations
+    int wait();
+
+    /// @brief Check if operations are queued or in progress
+    ///
+    bool busy() const {return !this->queued.empty() || this->inFlight > 0;}
+
+protected:
+    friend class Task;
+
+    static constexpr int FILE_COUNT = 16;
+    static constexpr uint64_t CANCEL_TAG = ~uint64_t(0);
+
+    bool setupUring(int entries);
+    void startThreads(int threadCount);
+    void run();
+    void cancel(int slot);
+    int allocateSlot(Task *task);
+    void prepareCancels();
+    bool prepare(Task &task);
+    int complete(bool wait);
+    void finish(int slot, int result);
+    void clearEventFd();
+
+    // operations that are not submitted yet
+    TaskList<Task> queued;
+
+    // submitted operations that have completed, the coroutines get resumed by doAll()
+    TaskList<Task> completed;
+
+    // submitted operations, nullptr when free or when the task was destroyed before the operation has completed
+    std::vector<Task *> slots;
+    std::vector<int> freeSlots;
+    int inFlight = 0;
+
+    int eventFd = -1;
+
+    // io_uring
+    int ringFd = -1;
+    void *sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;
+    size_t cqRingSize = 0;
+    void *sqes = nullptr;
+    size_t sqesSize = 0;
+    uint32_t *sqHead;
+    uint32_t *sqTail;
+    uint32_t sqMask;
+    uint32_t sqEntries;
+    uint32_t *sqArray;
+    uint32_t *cqHead;
+    uint32_t *cqTail;
+    uint32_t cqMask;
+    uint32_t cqEntries;
+    void *cqes;
+    int toSubmit = 0;
+
+    // async cancel requests of orphaned slots that still have to be submitted
+    std::vector<int> cancels;
+
+    // registered files and buffers
+    int files[FILE_COUNT];
+    bool filesRegistered = false;
+    std::vector<Array<const uint8_t>> buffers;
+
+    // thread pool
+    struct Job {
+        int slot;
+        Op op;
+        int file;
+        int64_t offset;
+        void *data;
+        int length;
+    };
+    struct Completion {
+        int slot;
+        int result;
+    };
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    int jobFd = -1;
+    std::deque<Job> jobs;
+    std::vector<Completion> completions;
+    bool running = true;
+};
+
+} // namespace coco
@@ -0,0 +1,46 @@
+#include "SharedMemory.hpp"
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace coco {
+
+namespace {
+
+uint8_t *map(int fd, size_t size) {
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return memory == MAP_FAILED ? nullptr : static_cast<uint8_t *>(memory);
+}
+
+} // namespace
+
+SharedMemory::SharedMemory(String name, size_t size) {
+    this->fd = memfd_create(std::string(name.data(), name.size()).c_str(), MFD_CLOEXEC);
+    if (this->fd == -1)
+        return;
+    if (ftruncate(this->fd, size) != 0)
+        return;
+    this->memory = map(this->fd, size);
+    if (this->memory != nullptr)
+        this->length = size;
+}
+
+SharedMemory::SharedMemory(int fd) : fd(fd) {
+    struct stat s;
+    if (fstat(fd, &s) != 0 || s.st_size == 0)
+        return;
+    this->memory = map(fd, s.st_size);
+    if (this->memory != nullptr)
+        this->length = s.st_size;
+}
+
+SharedMemory::~SharedMemory() {
+    if (this->memory != nullptr)
+        munmap(this->memory, this->length);
+    if (this->fd != -1)
+        close(this->fd);
+}
+
+} // namespace coco
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <coco/String.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+
+namespace coco {
+
+/// @brief Shared memory for Linux based on memfd that can be mapped into multiple processes, e.g. to exchange messages
+/// between peripheral emulators and the application using SharedMpscQueue. The file descriptor gets inherited by
+/// fork() or can be passed to another process over a Unix domain socket (SCM_RIGHTS). The memory gets mapped at a
+/// different address in each process, therefore data structures in it must use offsets instead of pointers.
+///
+/// Use like this:
+/// SharedMemory memory("queue", 65536);
+/// auto &queue = memory.construct<SharedMpscQueue<Message>>(0);
+/// // other process: SharedMemory memory(fd); auto &queue = memory.at<SharedMpscQueue<Message>>(0);
+class SharedMemory {
+public:
+    /// @brief Create new shared memory that is initialized with zero
+    /// @param name name for debugging (shows up in /proc/<pid>/fd)
+    /// @param size size in bytes
+    SharedMemory(String name, size_t size);
+
+    /// @brief Map existing shared memory, e.g. a file descriptor received from another process
+    /// @param fd file descriptor of the shared memory, gets owned by this object
+    explicit SharedMemory(int fd);
+
+    SharedMemory(const SharedMemory &) = delete;
+    SharedMemory(SharedMemory &&memory) noexcept
+        : fd(std::exchange(memory.fd, -1)), memory(std::exchange(memory.memory, nullptr))
+        , length(std::exchange(memory.length, 0)) {}
+
+    ~SharedMemory();
+
+    /// @brief Check if the construction was successful
+    ///
+    bool isValid() const {return this->memory != nullptr;}
+
+    /// @brief Get the file descriptor for passing to another process
+    ///
+    int getFd() const {return this->fd;}
+
+    uint8_t *data() const {return this->memory;}
+    size_t size() const {return this->length;}
+
+    /// @brief Get an object at an offset in the shared memory
+    /// @tparam T type of object, must be usable across processes (no pointers, lock-free atomics only)
+    /// @param offset offset in bytes
+    template <typename T>
+    T &at(size_t offset) const {
+        return *reinterpret_cast<T *>(this->memory + offset);
+    }
+
+    /// @brief Construct an object at an offset in the shared memory, only in the process that creates the memory
+    /// @tparam T type of object, must be usable across processes (no pointers, lock-free atomics only)
+    /// @param offset offset in bytes
+    /// @param args constructor arguments
+    template <typename T, typename ...Args>
+    T &construct(size_t offset, Args &&...args) {
+        return *new (this->memory + offset) T(std::forward<Args>(args)...);
+    }
+
+protected:
+    int fd = -1;
+    uint8_t *memory = nullptr;
+    size_t length = 0;
+};
+
+} // namespace coco
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "futex.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace coco {
+
+/// @brief Node for SharedMpscQueue
+///
+struct SharedMpscQueueNode {
+    /// @brief Offset of the next element relative to the queue, 0 for none
+    ///
+    std::atomic<ptrdiff_t> next;
+
+    SharedMpscQueueNode() = default;
+    SharedMpscQueueNode(SharedMpscQueueNode const &) = delete;
+};
+
+
+/// @brief Intrusive multiple producer single consumer queue for shared memory (see SharedMemory), same algorithm as
+/// IntrusiveMpscQueue but with offsets relative to the queue instead of pointers so that it works when the memory is
+/// mapped at different addresses in different processes. The queue and all elements must be located in the same
+/// shared memory, the messages get passed without copying. The consumer can block in wait() until a message arrives,
+/// producers only make a system call (futex wake) when the consumer is actually waiting.
+///
+/// Use like this:
+/// struct Message : SharedMpscQueueNode {int value;};
+/// auto &queue = memory.construct<SharedMpscQueue<Message>>(0);
+/// // producer process
+/// queue.push(message);
+/// // consumer process
+/// Message *message = queue.wait();
+///
+/// @tparam T element type, must derive from SharedMpscQueueNode
+template <typename T>
+class SharedMpscQueue {
+public:
+    using Node = SharedMpscQueueNode;
+
+    static_assert(std::atomic<ptrdiff_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+        "atomics in shared memory must be lock-free");
+
+    SharedMpscQueue() : head(offset(stub)), tail(offset(stub)) {
+        this->stub.next = 0;
+    }
+
+    SharedMpscQueue(SharedMpscQueue const &) = delete;
+
+    /// @brief Push an element to the queue, can be called from multiple threads and processes. Wakes up the consumer
+    /// if it is waiting
+    /// @param element element to add, must be located in the same shared memory as the queue
+    void push(T &element) {
+        pushInternal(element);
+
+        // the exchange in pushInternal() and the load of waiting are sequentially consistent, therefore either the
+        // consumer sees the element or we see that the consumer is waiting
+        if (this->waiting.load() != 0 && this->waiting.exchange(0) != 0)
+            futexWake(this->waiting, 1, true);
+    }
+
+    /// @brief Pop an element from the queue, can be called from only one thread of one process
+    /// @return the oldest element or nullptr if the queue was empty
+    T *pop() {
+        Node *tail = node(this->tail);
+        Node *next = node(tail->next);
+
+        if (tail == &this->stub) {
+            if (next == nullptr)
+                return nullptr;
+            this->tail = offset(*next);
+            tail = next;
+            next = node(next->next);
+        }
+
+        if (next != nullptr) {
+            this->tail = offset(*next);
+            return &static_cast<T &>(*tail); // cast reference instead of pointer to avoid null check
+        }
+
+        if (offset(*tail) != this->head.load())
+            return nullptr;
+
+        // push stub
+        pushInternal(this->stub);
+
+        next = node(tail->next);
+
+        if (next != nullptr) {
+            this->tail = offset(*next);
+            return &static_cast<T &>(*tail); // cast reference instead of pointer to avoid null check
+        }
+
+        return nullptr;
+    }
+
+    /// @brief Pop an element and wait until one is available if the queue is empty
+    /// @return the oldest element
+    T *wait() {
+        while (true) {
+            if (T *element = pop())
+                return element;
+            this->waiting = 1;
+            if (T *element = pop()) {
+                this->waiting = 0;
+                return element;
+            }
+            futexWait(this->waiting, 1, true);
+        }
+    }
+
+    /// @brief Pop an element and wait until one is available or a timeout occurs
+    /// @param timeout timeout
+    /// @return the oldest element or nullptr on timeout
+    T *wait(Milliseconds<> timeout) {
+        while (true) {
+            if (T *element = pop())
+                return element;
+            this->waiting = 1;
+            if (T *element = pop()) {
+                this->waiting = 0;
+                return element;
+            }
+            if (!futexWait(this->waiting, 1, timeout, true)) {
+                this->waiting = 0;
+                return pop();
+            }
+        }
+    }
+
+protected:
+    ptrdiff_t offset(Node &node) const {
+        return reinterpret_cast<const uint8_t *>(&node) - reinterpret_cast<const uint8_t *>(this);
+    }
+
+    Node *node(ptrdiff_t offset) {
+        return offset == 0 ? nullptr : reinterpret_cast<Node *>(reinterpret_cast<uint8_t *>(this) + offset);
+    }
+
+    void pushInternal(Node &n) {
+        n.next = 0;
+        ptrdiff_t o = offset(n);
+        Node *prev = node(this->head.exchange(o));
+        prev->next = o;
+    }
+
+    // push() adds to head, the first member so that no node has offset 0
+    std::atomic<ptrdiff_t> head;
+
+    // pop() removes from tail
+    ptrdiff_t tail;
+
+    Node stub;
+
+    // futex word, 1 while the consumer is waiting
+    std::atomic<uint32_t> waiting = 0;
+};
+
+} // namespace coco
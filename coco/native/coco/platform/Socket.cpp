@@ -0,0 +1,397 @@
+#include "Socket.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+
+namespace coco {
+
+namespace {
+    // check if an operation has to wait for the socket to become ready
+    bool wouldBlock() {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+
+    // build an I/O vector from an array of buffers, skip the given number of bytes. Returns the number of entries and
+    // the number of bytes in the vector, which covers at most MAX_VECTOR_COUNT buffers
+    template <typename T>
+    std::pair<int, int> makeVector(iovec *vector, const Array<T> *buffers, int count, int skip) {
+        int n = 0;
+        int size = 0;
+        for (int i = 0; i < count && n < Socket::MAX_VECTOR_COUNT; ++i) {
+            int s = buffers[i].size();
+            if (skip >= s) {
+                skip -= s;
+                continue;
+            }
+            vector[n++] = {const_cast<uint8_t *>(buffers[i].data()) + skip, size_t(s - skip)};
+            size += s - skip;
+            skip = 0;
+        }
+        return {n, size};
+    }
+
+    // check if a socket is a stream socket, only stream sockets can split a transfer into multiple system calls. Only
+    // used in assertions
+    [[maybe_unused]] bool isStream(int fd) {
+        int type = 0;
+        socklen_t length = sizeof(type);
+        return getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &length) == 0 && type == SOCK_STREAM;
+    }
+
+    template <typename T>
+    int totalSize(const Array<T> *buffers, int count) {
+        int size = 0;
+        for (int i = 0; i < count; ++i)
+            size += buffers[i].size();
+        return size;
+    }
+
+    bool doAccept(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        int fd = accept4(task.socket->getFd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) {
+            if (wouldBlock())
+                return false;
+            task.value = -errno;
+            return true;
+        }
+        auto &client = *static_cast<Socket *>(task.data);
+        client = Socket(client.getLoop(), fd);
+        task.value = 0;
+        return true;
+    }
+
+    bool doConnect(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto &address = *static_cast<const Socket::Address *>(task.extra);
+
+        // calling connect() again reports the state of a connection in progress
+        if (::connect(task.socket->getFd(), address.get(), address.length) == 0 || errno == EISCONN) {
+            task.value = 0;
+            return true;
+        }
+        if (errno == EINPROGRESS || errno == EALREADY || wouldBlock())
+            return false;
+        task.value = -errno;
+        return true;
+    }
+
+    bool doRecv(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto result = ::recv(task.socket->getFd(), task.data, task.length, 0);
+        if (result < 0) {
+            if (wouldBlock())
+                return false;
+            result = -errno;
+        }
+        task.value = int(result);
+        return true;
+    }
+
+    bool doRecvVector(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto buffers = static_cast<const Array<uint8_t> *>(task.data);
+        while (true) {
+            iovec vector[Socket::MAX_VECTOR_COUNT];
+            msghdr message = {};
+            message.msg_iov = vector;
+            auto [count, size] = makeVector(vector, buffers, task.length, task.done);
+            message.msg_iovlen = count;
+            auto result = ::recvmsg(task.socket->getFd(), &message, 0);
+            if (result < 0) {
+                // report the data of previous calls, a following recv() gets the error again
+                if (task.done > 0)
+                    break;
+                if (wouldBlock())
+                    return false;
+                task.value = -errno;
+                return true;
+            }
+            task.done += int(result);
+
+            // continue with the remaining buffers if the vector was filled and did not cover all buffers
+            if (result < size || size == 0 || task.done >= totalSize(buffers, task.length))
+                break;
+        }
+        task.value = task.done;
+        return true;
+    }
+
+    bool doRecvFrom(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto &address = *static_cast<Socket::Address *>(task.extra);
+        address.length = sizeof(address.storage);
+        auto result = ::recvfrom(task.socket->getFd(), task.data, task.length, 0, address.get(), &address.length);
+        if (result < 0) {
+            if (wouldBlock())
+                return false;
+            result = -errno;
+        }
+        task.value = int(result);
+        return true;
+    }
+
+    bool doSend(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        while (true) {
+            auto data = static_cast<const uint8_t *>(task.data) + task.done;
+            auto result = ::send(task.socket->getFd(), data, task.length - task.done, MSG_NOSIGNAL);
+            if (result < 0) {
+                if (wouldBlock())
+                    return false;
+                task.value = -errno;
+                return true;
+            }
+            task.done += int(result);
+            if (task.done >= task.length) {
+                task.value = task.done;
+                return true;
+            }
+        }
+    }
+
+    bool doSendVector(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto buffers = static_cast<const Array<const uint8_t> *>(task.data);
+        int total = totalSize(buffers, task.length);
+        while (true) {
+            iovec vector[Socket::MAX_VECTOR_COUNT];
+            msghdr message = {};
+            message.msg_iov = vector;
+            message.msg_iovlen = makeVector(vector, buffers, task.length, task.done).first;
+            auto result = ::sendmsg(task.socket->getFd(), &message, MSG_NOSIGNAL);
+            if (result < 0) {
+                if (wouldBlock())
+                    return false;
+                task.value = -errno;
+                return true;
+            }
+            task.done += int(result);
+            if (task.done >= total) {
+                task.value = task.done;
+                return true;
+            }
+        }
+    }
+
+    bool doSendTo(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto &address = *static_cast<const Socket::Address *>(task.extra);
+        auto result = ::sendto(task.socket->getFd(), task.data, task.length, MSG_NOSIGNAL, address.get(),
+            address.length);
+        if (result < 0) {
+            if (wouldBlock())
+                return false;
+            result = -errno;
+        }
+        task.value = int(result);
+        return true;
+    }
+
+    bool doRecvBatch(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto datagrams = static_cast<Socket::Datagram *>(task.data);
+        int count = std::min(task.length, Socket::MAX_BATCH_COUNT);
+        mmsghdr messages[Socket::MAX_BATCH_COUNT];
+        iovec vectors[Socket::MAX_BATCH_COUNT];
+        for (int i = 0; i < count; ++i) {
+            auto &datagram = datagrams[i];
+            vectors[i] = {datagram.buffer.data(), size_t(datagram.buffer.size())};
+            messages[i] = {};
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = datagram.address.get();
+            messages[i].msg_hdr.msg_namelen = sizeof(datagram.address.storage);
+        }
+        int result = ::recvmmsg(task.socket->getFd(), messages, count, 0, nullptr);
+        if (result < 0) {
+            if (wouldBlock())
+                return false;
+            task.value = -errno;
+            return true;
+        }
+        for (int i = 0; i < result; ++i) {
+            datagrams[i].length = int(messages[i].msg_len);
+            datagrams[i].address.length = messages[i].msg_hdr.msg_namelen;
+        }
+        task.value = result;
+        return true;
+    }
+
+    bool doSendBatch(EventLoop::FdTask &t) {
+        auto &task = static_cast<Socket::Task &>(t);
+        auto datagrams = static_cast<const Socket::Datagram *>(task.data);
+        while (task.done < task.length) {
+            int count = std::min(task.length - task.done, Socket::MAX_BATCH_COUNT);
+            mmsghdr messages[Socket::MAX_BATCH_COUNT];
+            iovec vectors[Socket::MAX_BATCH_COUNT];
+            for (int i = 0; i < count; ++i) {
+                auto &datagram = datagrams[task.done + i];
+                vectors[i] = {datagram.buffer.data(), size_t(datagram.buffer.size())};
+                messages[i] = {};
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                if (!datagram.address.empty()) {
+                    messages[i].msg_hdr.msg_name = const_cast<sockaddr *>(datagram.address.get());
+                    messages[i].msg_hdr.msg_namelen = datagram.address.length;
+                }
+            }
+            int result = ::sendmmsg(task.socket->getFd(), messages, count, MSG_NOSIGNAL);
+            if (result < 0) {
+                if (wouldBlock())
+                    return false;
+                task.value = -errno;
+                return true;
+            }
+            task.done += result;
+        }
+        task.value = task.done;
+        return true;
+    }
+} // namespace
+
+
+Socket::Address Socket::Address::inet(String host, int port) {
+    char buffer[INET6_ADDRSTRLEN];
+    Address address;
+    if (host.size() >= int(sizeof(buffer)))
+        return address;
+    std::memcpy(buffer, host.data(), host.size());
+    buffer[host.size()] = 0;
+    auto in4 = reinterpret_cast<sockaddr_in *>(&address.storage);
+    auto in6 = reinterpret_cast<sockaddr_in6 *>(&address.storage);
+    if (inet_pton(AF_INET, buffer, &in4->sin_addr) == 1) {
+        in4->sin_family = AF_INET;
+        in4->sin_port = htons(port);
+        address.length = sizeof(sockaddr_in);
+    } else if (inet_pton(AF_INET6, buffer, &in6->sin6_addr) == 1) {
+        in6->sin6_family = AF_INET6;
+        in6->sin6_port = htons(port);
+        address.length = sizeof(sockaddr_in6);
+    }
+    return address;
+}
+
+Socket::Address Socket::Address::local(String path) {
+    Address address;
+    auto un = reinterpret_cast<sockaddr_un *>(&address.storage);
+    if (path.size() >= int(sizeof(un->sun_path)))
+        return address;
+    un->sun_family = AF_UNIX;
+    std::memcpy(un->sun_path, path.data(), path.size());
+    if (path.startsWith("@")) {
+        // abstract namespace
+        un->sun_path[0] = 0;
+        address.length = offsetof(sockaddr_un, sun_path) + path.size();
+    } else {
+        address.length = offsetof(sockaddr_un, sun_path) + path.size() + 1;
+    }
+    return address;
+}
+
+int Socket::Address::getPort() const {
+    if (this->storage.ss_family == AF_INET)
+        return ntohs(reinterpret_cast<const sockaddr_in *>(&this->storage)->sin_port);
+    if (this->storage.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6 *>(&this->storage)->sin6_port);
+    return 0;
+}
+
+
+Socket::Socket(EventLoop &loop, int domain, int type) : loop(loop) {
+    this->fd = ::socket(domain, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+}
+
+Socket::Socket(EventLoop &loop, int fd) : loop(loop), fd(fd) {
+    if (fd != -1)
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+Socket &Socket::operator =(Socket &&socket) noexcept {
+    close();
+    this->fd = socket.fd;
+    socket.fd = -1;
+    return *this;
+}
+
+void Socket::close() {
+    if (this->fd != -1) {
+        this->loop.remove(this->fd);
+        ::close(this->fd);
+        this->fd = -1;
+    }
+}
+
+int Socket::bind(const Address &address) {
+    int type = 0;
+    socklen_t length = sizeof(type);
+    getsockopt(this->fd, SOL_SOCKET, SO_TYPE, &type, &length);
+    if (type == SOCK_STREAM && address.getFamily() != AF_UNIX) {
+        int one = 1;
+        setsockopt(this->fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+    return ::bind(this->fd, address.get(), address.length) == 0 ? 0 : -errno;
+}
+
+int Socket::listen(int backlog) {
+    return ::listen(this->fd, backlog) == 0 ? 0 : -errno;
+}
+
+Socket::Address Socket::getAddress() const {
+    Address address;
+    address.length = sizeof(address.storage);
+    if (getsockname(this->fd, address.get(), &address.length) != 0)
+        address.length = 0;
+    return address;
+}
+
+Socket::Awaitable Socket::accept(Socket &client) {
+    return start(EPOLLIN, &doAccept, &client, 0);
+}
+
+Socket::Awaitable Socket::connect(const Address &address) {
+    return start(EPOLLOUT, &doConnect, nullptr, 0, const_cast<Address *>(&address));
+}
+
+Socket::Awaitable Socket::recv(void *data, int length) {
+    return start(EPOLLIN, &doRecv, data, length);
+}
+
+Socket::Awaitable Socket::recv(Array<const Array<uint8_t>> buffers) {
+    assert(buffers.size() <= MAX_VECTOR_COUNT || isStream(this->fd));
+    return start(EPOLLIN, &doRecvVector, const_cast<Array<uint8_t> *>(buffers.data()), buffers.size());
+}
+
+Socket::Awaitable Socket::recvFrom(void *data, int length, Address &address) {
+    return start(EPOLLIN, &doRecvFrom, data, length, &address);
+}
+
+Socket::Awaitable Socket::send(const void *data, int length) {
+    return start(EPOLLOUT, &doSend, const_cast<void *>(data), length);
+}
+
+Socket::Awaitable Socket::send(Array<const Array<const uint8_t>> buffers) {
+    assert(buffers.size() <= MAX_VECTOR_COUNT || isStream(this->fd));
+    return start(EPOLLOUT, &doSendVector, const_cast<Array<const uint8_t> *>(buffers.data()), buffers.size());
+}
+
+Socket::Awaitable Socket::sendTo(const void *data, int length, const Address &address) {
+    return start(EPOLLOUT, &doSendTo, const_cast<void *>(data), length, const_cast<Address *>(&address));
+}
+
+Socket::Awaitable Socket::recvBatch(Array<Datagram> datagrams) {
+    return start(EPOLLIN, &doRecvBatch, datagrams.data(), datagrams.size());
+}
+
+Socket::Awaitable Socket::sendBatch(Array<const Datagram> datagrams) {
+    return start(EPOLLOUT, &doSendBatch, const_cast<Datagram *>(datagrams.data()), datagrams.size());
+}
+
+} // namespace coco
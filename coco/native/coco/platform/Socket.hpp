@@ -0,0 +1,220 @@
+#pragma once
+
+#include "EventLoop.hpp"
+#include <coco/Array.hpp>
+#include <coco/String.hpp>
+#include <cerrno>
+#include <cstdint>
+#include <sys/socket.h>
+
+
+namespace coco {
+
+/// @brief Non-blocking socket for Linux (TCP, UDP, Unix domain) with awaitable operations that are driven by an
+/// EventLoop. Each operation is tried immediately and only waits for the socket to become ready if it would block,
+/// co_await returns the result of the system call (number of bytes, number of messages or 0) or a negative error code
+/// (e.g. -ECONNREFUSED, -ECANCELED when the socket gets closed while waiting). Buffers and addresses must remain valid
+/// until the operation has completed.
+///
+/// Use like this:
+/// Coroutine echo(Socket &socket) {
+///     uint8_t buffer[1024];
+///     int n;
+///     while ((n = co_await socket.recv(buffer, sizeof(buffer))) > 0)
+///         co_await socket.send(buffer, n);
+/// }
+class Socket {
+public:
+    // maximum number of buffers per scatter/gather system call (stream sockets use multiple calls for more buffers)
+    // and of datagrams per batch system call
+    static constexpr int MAX_VECTOR_COUNT = 16;
+    static constexpr int MAX_BATCH_COUNT = 64;
+
+    /// @brief Socket address (IPv4, IPv6 or Unix domain)
+    ///
+    struct Address {
+        /// @brief Create an IPv4 or IPv6 address
+        /// @param host numeric host address, e.g. "127.0.0.1" or "::1"
+        /// @param port port number, 0 to let bind() choose a port
+        /// @return address, empty if the host is invalid
+        static Address inet(String host, int port);
+
+        /// @brief Create a Unix domain socket address
+        /// @param path path in the file system, or starting with '@' for the abstract namespace
+        /// @return address, empty if the path is too long
+        static Address local(String path);
+
+        bool empty() const {return this->length == 0;}
+        int getFamily() const {return this->storage.ss_family;}
+        int getPort() const;
+
+        const sockaddr *get() const {return reinterpret_cast<const sockaddr *>(&this->storage);}
+        sockaddr *get() {return reinterpret_cast<sockaddr *>(&this->storage);}
+
+        sockaddr_storage storage = {};
+        socklen_t length = 0;
+    };
+
+    /// @brief Datagram for batch operations (recvmmsg/sendmmsg)
+    ///
+    struct Datagram {
+        // receive: buffer for the data, send: the data
+        Array<uint8_t> buffer;
+
+        // receive: length of the received data, send: ignored
+        int length = 0;
+
+        // receive: address of the sender, send: destination address (empty if connected)
+        Address address;
+    };
+
+    /// @brief Task of an operation
+    ///
+    class Task : public EventLoop::FdTask {
+    public:
+        Task(std::coroutine_handle<> handle, uint32_t events = 0, Operation operation = nullptr,
+            Socket *socket = nullptr, void *data = nullptr, int length = 0, void *extra = nullptr)
+            : FdTask(handle, events, operation), socket(socket), data(data), length(length), extra(extra) {}
+
+        Socket *socket;
+
+        // data or array of buffers or datagrams
+        void *data;
+        int length;
+
+        // address
+        void *extra;
+
+        // progress of send operations and of receive operations into multiple buffers
+        int done = 0;
+
+        // result of the operation
+        int value = -ECANCELED;
+    };
+
+    /// @brief Awaitable of an operation, co_await returns the result of the operation
+    ///
+    struct Awaitable : public coco::Awaitable<Task> {
+        using coco::Awaitable<Task>::Awaitable;
+
+        int await_resume() const noexcept {return this->task.value;}
+
+        int result() const noexcept {return this->task.value;}
+    };
+
+
+    /// @brief Construct a closed socket, e.g. for accept()
+    /// @param loop event loop
+    explicit Socket(EventLoop &loop) : loop(loop) {}
+
+    /// @brief Construct a non-blocking socket
+    /// @param loop event loop
+    /// @param domain AF_INET, AF_INET6 or AF_UNIX
+    /// @param type SOCK_STREAM or SOCK_DGRAM
+    Socket(EventLoop &loop, int domain, int type);
+
+    /// @brief Construct from a file descriptor which gets set to non-blocking mode
+    /// @param loop event loop
+    /// @param fd file descriptor
+    Socket(EventLoop &loop, int fd);
+
+    Socket(const Socket &) = delete;
+    Socket(Socket &&socket) noexcept : loop(socket.loop), fd(socket.fd) {socket.fd = -1;}
+
+    ~Socket() {close();}
+
+    Socket &operator =(Socket &&socket) noexcept;
+
+    bool isOpen() const {return this->fd != -1;}
+    int getFd() const {return this->fd;}
+    EventLoop &getLoop() const {return this->loop;}
+
+    /// @brief Close the socket, waiting operations get resumed with -ECANCELED
+    ///
+    void close();
+
+    /// @brief Bind to an address, sets SO_REUSEADDR for TCP
+    /// @param address address
+    /// @return 0 or negative error code
+    int bind(const Address &address);
+
+    /// @brief Listen for connections
+    /// @param backlog maximum length of the queue of pending connections
+    /// @return 0 or negative error code
+    int listen(int backlog = 128);
+
+    /// @brief Get the local address, e.g. to get the port chosen by bind()
+    ///
+    Address getAddress() const;
+
+    /// @brief Accept a connection
+    /// @param client closed socket that receives the connection
+    /// @return use co_await on return value to wait, returns 0 or a negative error code
+    [[nodiscard]] Awaitable accept(Socket &client);
+
+    /// @brief Connect to an address
+    /// @param address address
+    /// @return use co_await on return value to wait, returns 0 or a negative error code
+    [[nodiscard]] Awaitable connect(const Address &address);
+
+    /// @brief Receive data, returns as soon as some data is available
+    /// @param data buffer for the data
+    /// @param length size of the buffer
+    /// @return use co_await on return value to wait, returns the number of bytes (0 on end of stream)
+    [[nodiscard]] Awaitable recv(void *data, int length);
+
+    /// @brief Receive data into multiple buffers (scatter), on stream sockets more than MAX_VECTOR_COUNT buffers are
+    /// filled using multiple system calls as long as data is available
+    /// @param buffers buffers, at most MAX_VECTOR_COUNT on datagram sockets
+    /// @return use co_await on return value to wait, returns the number of bytes (0 on end of stream)
+    [[nodiscard]] Awaitable recv(Array<const Array<uint8_t>> buffers);
+
+    /// @brief Receive a datagram and the address of the sender
+    /// @param data buffer for the data
+    /// @param length size of the buffer
+    /// @param address receives the address of the sender
+    /// @return use co_await on return value to wait, returns the number of bytes
+    [[nodiscard]] Awaitable recvFrom(void *data, int length, Address &address);
+
+    /// @brief Send all data, waits until everything is sent on stream sockets
+    /// @param data data to send
+    /// @param length length of the data
+    /// @return use co_await on return value to wait, returns the number of bytes
+    [[nodiscard]] Awaitable send(const void *data, int length);
+
+    /// @brief Send data from multiple buffers (gather), waits until everything is sent on stream sockets
+    /// @param buffers buffers, at most MAX_VECTOR_COUNT on datagram sockets
+    /// @return use co_await on return value to wait, returns the number of bytes
+    [[nodiscard]] Awaitable send(Array<const Array<const uint8_t>> buffers);
+
+    /// @brief Send a datagram to an address
+    /// @param data data to send
+    /// @param length length of the data
+    /// @param address destination address
+    /// @return use co_await on return value to wait, returns the number of bytes
+    [[nodiscard]] Awaitable sendTo(const void *data, int length, const Address &address);
+
+    /// @brief Receive multiple datagrams with one system call (recvmmsg), returns when at least one was received
+    /// @param datagrams datagrams, the buffers must be set
+    /// @return use co_await on return value to wait, returns the number of received datagrams
+    [[nodiscard]] Awaitable recvBatch(Array<Datagram> datagrams);
+
+    /// @brief Send multiple datagrams with few system calls (sendmmsg), waits until all are sent
+    /// @param datagrams datagrams
+    /// @return use co_await on return value to wait, returns the number of sent datagrams
+    [[nodiscard]] Awaitable sendBatch(Array<const Datagram> datagrams);
+
+protected:
+    // start an operation, completes immediately with -ECANCELED if the socket is closed
+    template <typename ...Args>
+    Awaitable start(uint32_t events, EventLoop::FdTask::Operation operation, Args &&...args) {
+        if (this->fd == -1)
+            return {};
+        return {this->loop.getWatch(this->fd), events, operation, this, std::forward<Args>(args)...};
+    }
+
+    EventLoop &loop;
+    int fd = -1;
+};
+
+} // namespace coco
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <coco/IntrusiveMpscQueue.hpp>
+#include <coco/Time.hpp>
+#include <atomic>
+#include <cstdint>
+#ifdef __linux__
+#include "futex.hpp"
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+
+namespace coco {
+
+/// @brief IntrusiveMpscQueue with a consumer that can block in wait() until an element arrives instead of spinning or
+/// sleeping. The consumer announces that it is about to park, therefore producers only make a system call (futex wake
+/// on Linux, std::atomic::notify_one() on other platforms) when the consumer is actually waiting, otherwise push()
+/// costs one additional atomic load.
+///
+/// Use like this:
+/// WaitableMpscQueue<Message> queue;
+/// // producer threads
+/// queue.push(message);
+/// // consumer thread
+/// while (true) {
+///     Message *message = queue.wait();
+///     // handle message
+/// }
+///
+/// @tparam T element type, must derive from IntrusiveMpscQueueNode
+template <typename T>
+class WaitableMpscQueue : protected IntrusiveMpscQueue<T> {
+public:
+    // derived protected so that elements can't be pushed via IntrusiveMpscQueue::push() which does not wake up the
+    // consumer
+    using typename IntrusiveMpscQueue<T>::Node;
+    using IntrusiveMpscQueue<T>::pop;
+
+    /// @brief Push an element to the queue and wake up the consumer if it is waiting. This may happen in multiple
+    /// threads
+    /// @param element element to add
+    void push(T &element) {
+        this->pushInternal(element);
+
+        // the exchange in pushInternal() and the load of waiting are sequentially consistent, therefore either the
+        // consumer sees the element or we see that the consumer is waiting
+        if (this->waiting.load() != 0 && this->waiting.exchange(0) != 0) {
+#ifdef __linux__
+            futexWake(this->waiting, 1);
+#else
+            this->waiting.notify_one();
+#endif
+        }
+    }
+
+    /// @brief Pop an element and wait until one is available if the queue is empty. This can happen in only one thread
+    /// @return the oldest element
+    T *wait() {
+        while (true) {
+            if (T *element = park())
+                return element;
+#ifdef __linux__
+            futexWait(this->waiting, 1);
+#else
+            this->waiting.wait(1);
+#endif
+        }
+    }
+
+    /// @brief Pop an element and wait until one is available or a timeout occurs. This can happen in only one thread
+    /// @param timeout timeout
+    /// @return the oldest element or nullptr on timeout
+    T *wait(Milliseconds<> timeout) {
+#ifdef __linux__
+        while (true) {
+            if (T *element = park())
+                return element;
+            if (!futexWait(this->waiting, 1, timeout)) {
+                this->waiting = 0;
+                return this->pop();
+            }
+        }
+#else
+        // std::atomic::wait() has no timeout, therefore poll
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout.value);
+        while (true) {
+            if (T *element = this->pop())
+                return element;
+            if (std::chrono::steady_clock::now() >= end)
+                return nullptr;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+#endif
+    }
+
+protected:
+    // announce that the consumer is about to wait, then check the queue again as a producer may have pushed in between
+    T *park() {
+        if (T *element = this->pop())
+            return element;
+        this->waiting = 1;
+        if (T *element = this->pop()) {
+            this->waiting = 0;
+            return element;
+        }
+        return nullptr;
+    }
+
+    // 1 while the consumer is waiting
+    std::atomic<uint32_t> waiting = 0;
+};
+
+} // namespace coco
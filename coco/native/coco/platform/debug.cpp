@@ -1,21 +1,248 @@
 #include <coco/debug.hpp>
+#include <coco/LogBuffer.hpp>
+#include <coco/trace.hpp>
+#include <atomic>
 #include <chrono>
-#include <iostream>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 
 namespace coco {
 namespace debug {
 
 namespace {
-inline void set(const char *name, bool value, bool function) {
-    if (function)
-        std::cout << name << (value ? " on" : " off") << std::endl;
-    else if (value)
-        std::cout << name << " toggle" << std::endl;
+
+// Asynchronous output: each thread appends to its own lock-free buffer and a background thread writes complete lines
+// to stdout in batches. Messages get dropped when a buffer is full. The background thread sleeps while there is
+// nothing to write and gets woken up by the next write
+
+constexpr int BUFFER_SIZE = 65536;
+
+struct Producer {
+    LogBuffer<BUFFER_SIZE> buffer;
+
+    // set when the thread has exited, the producer gets deleted when its buffer is empty
+    std::atomic<bool> closed = false;
+
+    // number of dropped messages that was already reported (consumer side)
+    uint32_t reportedDropCount = 0;
+
+    // size of the buffer after the last drain (consumer side)
+    int drainedSize = 0;
+};
+
+// set by the background thread before it sleeps, producers wake it up on the next write
+std::atomic<bool> sleeping = false;
+
+// producer of the current thread, used to find the producers of threads that do not exist in a forked child
+thread_local Producer *ownProducer = nullptr;
+
+class Logger;
+Logger &logger();
+
+class Logger {
+public:
+    Logger() {
+#ifndef _WIN32
+        // a forked child only has the forking thread, the background thread gets restarted on the next write
+        pthread_atfork([] {logger().prepareFork();}, [] {logger().parentFork();}, [] {logger().childFork();});
+#endif
+    }
+
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->running = false;
+        }
+        this->condition.notify_one();
+        if (this->thread.joinable())
+            this->thread.join();
+        drain(true);
+    }
+
+    Producer *add() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        start();
+        this->producers.push_back(std::make_unique<Producer>());
+        ownProducer = this->producers.back().get();
+        return ownProducer;
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        drain(true);
+    }
+
+    // wake up the background thread, called by producers when sleeping is set
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            sleeping.store(false, std::memory_order_relaxed);
+            start();
+        }
+        this->condition.notify_one();
+    }
+
+    // fork handlers: write everything so that the child does not write it again and keep the mutex locked across fork()
+    void prepareFork() {
+        this->mutex.lock();
+        drain(true);
+    }
+
+    void parentFork() {
+        this->mutex.unlock();
+    }
+
+    void childFork() {
+        // forget the background thread of the parent without joining it, the condition variable may still count it
+        // as waiter. Producers see sleeping on the next write and call wake() which starts a new background thread
+        new (&this->thread) std::thread();
+        new (&this->condition) std::condition_variable();
+        sleeping.store(true, std::memory_order_relaxed);
+
+        // remove the producers of the other threads of the parent
+        std::erase_if(this->producers, [](const std::unique_ptr<Producer> &producer) {
+            return producer.get() != ownProducer;
+        });
+        this->mutex.unlock();
+    }
+
+protected:
+    // start the background thread on first use and in a forked child, mutex must be locked
+    void start() {
+        if (this->running && !this->thread.joinable())
+            this->thread = std::thread([this] {run();});
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (this->running) {
+            if (drain(false)) {
+                // more data is likely to follow, collect it for a while to write in batches
+                this->condition.wait_for(lock, std::chrono::milliseconds(2));
+            } else {
+                // nothing to write (only incomplete lines): sleep until a producer writes. Check the buffers again
+                // after setting sleeping, a producer checks sleeping after writing
+                sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!changed()) {
+                    // wait_for() instead of wait() keeps compatibility with older libstdc++ (wait() needs
+                    // GLIBCXX_3.4.30), the timeout is long enough to not cause idle wakeups
+                    this->condition.wait_for(lock, std::chrono::hours(1), [this] {
+                        return !sleeping.load(std::memory_order_relaxed) || !this->running;
+                    });
+                }
+                sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // check if a producer has written since the last drain
+    bool changed() {
+        for (auto &producer : this->producers) {
+            auto &buffer = producer->buffer;
+            if (buffer.size() != producer->drainedSize || buffer.droppedCount() != producer->reportedDropCount
+                || producer->closed.load(std::memory_order_acquire))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // write buffered data to stdout, only complete lines if all is false
+    // returns true if something was written
+    bool drain(bool all) {
+        bool written = false;
+        for (auto it = this->producers.begin(); it != this->producers.end();) {
+            auto &producer = **it;
+            auto &buffer = producer.buffer;
+            bool closed = producer.closed.load(std::memory_order_acquire);
+
+            // also write incomplete lines when the buffer is half full or the thread has exited
+            bool whole = all || closed || buffer.size() >= BUFFER_SIZE / 2;
+            while (true) {
+                String data = buffer.read();
+                if (data.empty())
+                    break;
+                int length = data.size();
+                if (!whole && length == buffer.size()) {
+                    // no wrap-around: stop after the last complete line
+                    length = data.lastIndexOf('\n') + 1;
+                    if (length == 0)
+                        break;
+                }
+                std::fwrite(data.data(), 1, length, stdout);
+                buffer.consume(length);
+                written = true;
+            }
+
+            // report dropped messages
+            uint32_t dropCount = buffer.droppedCount();
+            if (dropCount != producer.reportedDropCount) {
+                std::fprintf(stdout, "\n*** %u debug messages dropped\n", unsigned(dropCount - producer.reportedDropCount));
+                producer.reportedDropCount = dropCount;
+                written = true;
+            }
+
+            if (closed && buffer.empty()) {
+                it = this->producers.erase(it);
+            } else {
+                producer.drainedSize = buffer.size();
+                ++it;
+            }
+        }
+        if (written)
+            std::fflush(stdout);
+        return written;
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool running = true;
+    std::vector<std::unique_ptr<Producer>> producers;
+    std::thread thread;
+};
+
+// constructed on first use and destroyed after the thread local producers of the main thread
+Logger &logger() {
+    static Logger logger;
+    return logger;
 }
+
+struct ThreadProducer {
+    Producer *producer = logger().add();
+
+    ~ThreadProducer() {
+        this->producer->closed.store(true, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed))
+            logger().wake();
+    }
+};
+
+thread_local ThreadProducer threadProducer;
+
+inline void set(const char *name, bool value, bool function) {
+    if (function) {
+        write(name);
+        write(value ? " on\n" : " off\n");
+    } else if (value) {
+        write(name);
+        write(" toggle\n");
+    }
 }
 
+} // namespace
+
 
 void init() {}
 
@@ -30,25 +257,34 @@ void sleep(Microseconds<> time) {
 }
 
 void write(const char *message, int length) {
-    int start = 0;
-    for (int i = 0; i <= length; ++i) {
-        if (i == length || message[i] == '\n') {
-            //std::wstring s;
-            //std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> conv;
-            //std::wstring wstr = conv.from_bytes(message + start, message + i);
-
-            std::cout.write(message + start, i - start);
-            //std::wcout << wstr;
-            if (i == length)
-                return;
-            std::cout << std::endl;
-            //std::wcout << std::endl;
-            start = i + 1;
-            if (start == length)
-                return;
-        }
+    if (length <= BUFFER_SIZE / 2) {
+        // fast path: copy into the buffer of this thread
+        threadProducer.producer->buffer.write(message, length);
+
+        // wake up the background thread if it sleeps, the fence pairs with setting sleeping in Logger::run()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed))
+            logger().wake();
+    } else {
+        // large messages are written synchronously
+        logger().flush();
+        std::fwrite(message, 1, length, stdout);
+        std::fflush(stdout);
     }
 }
 
+void flush() {
+    logger().flush();
+}
+
 } // namespace debug
+
+namespace trace {
+
+uint32_t now() {
+    static const auto start = std::chrono::steady_clock::now();
+    return uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace trace
 } // namespace coco
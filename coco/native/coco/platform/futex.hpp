@@ -0,0 +1,48 @@
+#pragma once
+
+#include <coco/Time.hpp>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+namespace coco {
+
+/// @brief Wait until a futex word is woken up, returns immediately if the word does not contain the expected value.
+/// Spurious wakeups are possible, therefore check the condition again after returning
+/// @param word futex word
+/// @param expected expected value of the futex word
+/// @param shared true if the word is in shared memory and gets woken up from another process
+inline void futexWait(std::atomic<uint32_t> &word, uint32_t expected, bool shared = false) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, expected,
+        nullptr, nullptr, 0);
+}
+
+/// @brief Wait until a futex word is woken up or a timeout occurs
+/// @param word futex word
+/// @param expected expected value of the futex word
+/// @param timeout relative timeout
+/// @param shared true if the word is in shared memory and gets woken up from another process
+/// @return false on timeout
+inline bool futexWait(std::atomic<uint32_t> &word, uint32_t expected, Milliseconds<> timeout, bool shared = false) {
+    timespec ts = {timeout.value / 1000, (timeout.value % 1000) * 1000000};
+    int result = syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE,
+        expected, &ts, nullptr, 0);
+    return result == 0 || errno != ETIMEDOUT;
+}
+
+/// @brief Wake up threads waiting on a futex word
+/// @param word futex word
+/// @param count number of threads to wake up
+/// @param shared true if the word is in shared memory and the waiters may be in another process
+inline void futexWake(std::atomic<uint32_t> &word, int count = INT_MAX, bool shared = false) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, count,
+        nullptr, nullptr, 0);
+}
+
+} // namespace coco
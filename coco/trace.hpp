@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+
+/**
+    Tracing of coroutine scheduling and user defined spans into a fixed size ring buffer of timestamped events.
+    Records when tasks get added to a task list, when coroutines suspend, when they get resumed (until they suspend
+    again or finish) and when timers fire. Enable by configuring with -DCOCO_TRACE=ON which defines COCO_TRACE for the
+    library and everything that links it (the definition must be the same in all translation units), otherwise all
+    trace functions are empty. The number of events in the ring buffer is COCO_TRACE_SIZE.
+    Record from one thread only (e.g. the event loop). The timestamps come from trace::now() which has to be
+    implemented by the platform (native: microseconds since start) or board.
+    Export with writeJson() or writeBinary() from traceWrite.hpp.
+*/
+#ifndef COCO_TRACE_SIZE
+#define COCO_TRACE_SIZE 1024
+#endif
+
+namespace coco {
+namespace trace {
+
+enum class EventType : uint8_t {
+    // begin of a user defined span, data is the name
+    BEGIN,
+
+    // end of the last span, resume or timer
+    END,
+
+    // user defined instant event, data is the name
+    INSTANT,
+
+    // task was added to a task list, data is the task
+    ADD,
+
+    // coroutine suspends, data is the coroutine
+    SUSPEND,
+
+    // task gets resumed, data is the coroutine
+    RESUME,
+
+    // task gets resumed by a timer, data is the coroutine
+    TIMER,
+};
+
+struct Event {
+    // time in microseconds
+    uint32_t time;
+
+    EventType type;
+
+    // name, task or coroutine
+    const void *data;
+};
+
+/// @brief Get the current time in microseconds for the timestamps of the events, only needed when COCO_TRACE is
+/// defined. Implementation comes from the platform or board
+uint32_t now();
+
+namespace detail {
+#ifdef COCO_TRACE
+    static_assert((COCO_TRACE_SIZE & (COCO_TRACE_SIZE - 1)) == 0, "COCO_TRACE_SIZE must be a power of two");
+
+    inline Event events[COCO_TRACE_SIZE];
+
+    // total number of recorded events
+    inline uint32_t count = 0;
+
+    inline void record(EventType type, const void *data) {
+        Event &event = events[count % COCO_TRACE_SIZE];
+        event.time = now();
+        event.type = type;
+        event.data = data;
+        ++count;
+    }
+#endif
+
+    // identify a task by the address of its coroutine, or by its own address if it is not a coroutine
+    template <typename T>
+    const void *id(const T &task) {
+        if constexpr (requires {task.task.address();})
+            return task.task.address();
+        else
+            return &task;
+    }
+} // namespace detail
+
+/// @brief Begin a user defined span, e.g. trace::begin("parse")
+/// @param name Name of the span, must be a string literal or remain valid until the trace is written
+inline void begin([[maybe_unused]] const char *name) {
+#ifdef COCO_TRACE
+    detail::record(EventType::BEGIN, name);
+#endif
+}
+
+/// @brief End the last span
+///
+inline void end() {
+#ifdef COCO_TRACE
+    detail::record(EventType::END, nullptr);
+#endif
+}
+
+/// @brief Record an instant event, e.g. trace::instant("overflow")
+/// @param name Name of the event, must be a string literal or remain valid until the trace is written
+inline void instant([[maybe_unused]] const char *name) {
+#ifdef COCO_TRACE
+    detail::record(EventType::INSTANT, name);
+#endif
+}
+
+/// @brief Span that ends when it goes out of scope, e.g. trace::Span span("parse");
+///
+class Span {
+public:
+    explicit Span(const char *name) {begin(name);}
+    ~Span() {end();}
+    Span(const Span &) = delete;
+    Span &operator =(const Span &) = delete;
+};
+
+/// @brief Record that a task was added to a task list (called by the task lists)
+///
+template <typename T>
+void add([[maybe_unused]] const T &task) {
+#ifdef COCO_TRACE
+    detail::record(EventType::ADD, &task);
+#endif
+}
+
+/// @brief Record that a coroutine suspends (called by Awaitable)
+/// @param coroutine Address of the coroutine
+inline void suspend([[maybe_unused]] const void *coroutine) {
+#ifdef COCO_TRACE
+    detail::record(EventType::SUSPEND, coroutine);
+#endif
+}
+
+/// @brief Record that a task gets resumed, call end() when it returns (called by the task lists)
+///
+template <typename T>
+void resume([[maybe_unused]] const T &task) {
+#ifdef COCO_TRACE
+    detail::record(EventType::RESUME, detail::id(task));
+#endif
+}
+
+/// @brief Record that a task gets resumed by a timer, call end() when it returns (called by the timed task lists)
+///
+template <typename T>
+void timer([[maybe_unused]] const T &task) {
+#ifdef COCO_TRACE
+    detail::record(EventType::TIMER, detail::id(task));
+#endif
+}
+
+/// @brief Get the number of events in the ring buffer
+///
+inline int size() {
+#ifdef COCO_TRACE
+    return int(std::min(detail::count, uint32_t(COCO_TRACE_SIZE)));
+#else
+    return 0;
+#endif
+}
+
+/// @brief Remove all events
+///
+inline void clear() {
+#ifdef COCO_TRACE
+    detail::count = 0;
+#endif
+}
+
+/// @brief Visit all events in the ring buffer from the oldest to the newest
+/// @param visitor Visitor, e.g. a lambda function taking const Event &
+template <typename V>
+void visitAll([[maybe_unused]] const V &visitor) {
+#ifdef COCO_TRACE
+    uint32_t count = detail::count;
+    for (uint32_t i = count - size(); i != count; ++i)
+        visitor(detail::events[i % COCO_TRACE_SIZE]);
+#endif
+}
+
+} // namespace trace
+} // namespace coco
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "trace.hpp"
+#include "format.hpp"
+#include "String.hpp"
+#include <cstring>
+
+
+/**
+    Export of the events recorded by trace.hpp.
+    Write with writeJson() to a Chrome trace file which can be viewed in ui.perfetto.dev or chrome://tracing, or with
+    writeBinary() (e.g. to debug::out) and convert on the host using the traceConvert tool.
+*/
+namespace coco {
+namespace trace {
+
+namespace detail {
+    // write a string with JSON escaping
+    template <typename S>
+    void writeJsonString(S &s, String str) {
+        int begin = 0;
+        for (int i = 0; i < str.size(); ++i) {
+            uint8_t ch = str[i];
+            if (ch == '"' || ch == '\\' || ch < 0x20) {
+                s << str.substring(begin, i);
+                if (ch == '"' || ch == '\\')
+                    format<"\\{:c}">(s, char(ch));
+                else
+                    format<"\\u{:04x}">(s, ch);
+                begin = i + 1;
+            }
+        }
+        s << str.substring(begin);
+    }
+
+    // write one event of a Chrome trace, name is used for BEGIN and INSTANT, id for the task events
+    template <typename S>
+    void writeJsonEvent(S &s, bool first, uint32_t time, EventType type, uint64_t id, String name) {
+        static const char *const phases[] = {"B", "E", "i", "i", "i", "B", "B"};
+        static const char *const prefixes[] = {"", "", "", "add ", "suspend ", "resume ", "timer "};
+        int t = int(type);
+        if (t > int(EventType::TIMER))
+            return;
+        format<"{}\n{{\"ph\":\"{}\",\"ts\":{},\"pid\":1,\"tid\":1">(s, first ? "" : ",", phases[t], time);
+        if (type == EventType::INSTANT || type == EventType::ADD || type == EventType::SUSPEND)
+            s << String(",\"s\":\"t\"");
+        if (type != EventType::END) {
+            s << String(",\"name\":\"");
+            if (type == EventType::BEGIN || type == EventType::INSTANT)
+                writeJsonString(s, name);
+            else
+                format<"{}0x{:x}">(s, prefixes[t], id);
+            s << String("\"");
+        }
+        s << String("}");
+    }
+
+    // header of the binary format
+    struct BinaryHeader {
+        char magic[4];
+        uint8_t version;
+        uint8_t pointerSize;
+        uint16_t reserved;
+        uint32_t count;
+    };
+
+    // size of an event in the binary format: time, type, data
+    constexpr int BINARY_EVENT_SIZE = 4 + 1 + sizeof(void *);
+} // namespace detail
+
+/// @brief Write the events as Chrome trace JSON, e.g. to a std::ofstream on native platforms
+/// @param s Stream
+template <typename S>
+void writeJson(S &s) {
+    s << String("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    visitAll([&s, &first](const Event &event) {
+        bool named = event.type == EventType::BEGIN || event.type == EventType::INSTANT;
+        detail::writeJsonEvent(s, first, event.time, event.type, uint64_t(uintptr_t(event.data)),
+            named ? String(static_cast<const char *>(event.data)) : String());
+        first = false;
+    });
+    s << String("\n]}\n");
+}
+
+/// @brief Write the events in binary form (e.g. to debug::out on microcontrollers) for conversion on the host. The
+/// format is a header (magic "CTRC", version, pointer size, reserved, count) followed by the events from oldest to
+/// newest (time, type, data), all little endian
+/// @param s Stream
+template <typename S>
+void writeBinary(S &s) {
+    detail::BinaryHeader header = {{'C', 'T', 'R', 'C'}, 1, uint8_t(sizeof(void *)), 0, uint32_t(size())};
+    s << String(reinterpret_cast<const char *>(&header), sizeof(header));
+    visitAll([&s](const Event &event) {
+        char buffer[detail::BINARY_EVENT_SIZE];
+        std::memcpy(buffer, &event.time, 4);
+        buffer[4] = char(event.type);
+        std::memcpy(buffer + 5, &event.data, sizeof(void *));
+        s << String(buffer, sizeof(buffer));
+    });
+}
+
+} // namespace trace
+} // namespace coco
@@ -1,7 +1,7 @@
 import os
 from conan import ConanFile
 from conan.tools.files import copy
-from conan.tools.cmake import CMake
+from conan.tools.cmake import CMake, CMakeDeps, CMakeToolchain
 
 
 class Project(ConanFile):
@@ -10,11 +10,12 @@ class Project(ConanFile):
     license = "Apache-2.0, BSD-3-Clause, MIT"
     settings = "os", "compiler", "build_type", "arch"
     options = {
-        "platform": [None, "ANY"]}
+        "platform": [None, "ANY"],
+        "trace": [True, False]}
     default_options = {
-        "platform": None}
-    generators = "CMakeDeps", "CMakeToolchain"
-    exports_sources = "conanfile.py", "CMakeLists.txt", "coco/*", "test/*"
+        "platform": None,
+        "trace": False}
+    exports_sources = "conanfile.py", "CMakeLists.txt", "coco/*", "test/*", "tools/*"
 
 
     # check if we are cross compiling
@@ -29,6 +30,13 @@ class Project(ConanFile):
             # platform is based on a "normal" operating system such as Windows, MacOS, Linux
             self.test_requires("gtest/1.17.0")
 
+    def generate(self):
+        deps = CMakeDeps(self)
+        deps.generate()
+        toolchain = CMakeToolchain(self)
+        toolchain.cache_variables["COCO_TRACE"] = bool(self.options.trace)
+        toolchain.generate()
+
     keep_imports = True
     def imports(self):
         # copy dependent libraries into the build folder
@@ -51,3 +59,6 @@ class Project(ConanFile):
 
     def package_info(self):
         self.cpp_info.libs = [self.name]
+        if self.options.trace:
+            # users have to see the same inline trace functions as the library
+            self.cpp_info.defines = ["COCO_TRACE"]
@@ -0,0 +1,1048 @@
+#include <coco/binlog.hpp>
+#include <coco/bits.hpp>
+#include <coco/Bitset.hpp>
+#include <coco/convert.hpp>
+#include <coco/Coroutine.hpp>
+#include <coco/format.hpp>
+#include <coco/hash.hpp>
+#include <coco/LogBuffer.hpp>
+#include <coco/MonotonicArena.hpp>
+#include <coco/ObjectPool.hpp>
+#include <coco/PerfectHash.hpp>
+#include <coco/SeqLock.hpp>
+#include <coco/platform/File.hpp>
+#include <coco/String.hpp>
+#include <coco/StringBuffer.hpp>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <coco/platform/EventLoop.hpp>
+#include <coco/platform/SharedMemory.hpp>
+#include <coco/platform/SharedMpscQueue.hpp>
+#include <coco/platform/Socket.hpp>
+#include <coco/platform/WaitableMpscQueue.hpp>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+// benchmarks for native platforms, run manually (not part of the unit tests)
+
+using namespace coco;
+
+
+// prevent the compiler from optimizing away a result
+template <typename T>
+void keep(const T &value) {
+    static volatile T sink;
+    sink = value;
+    (void)sink;
+}
+
+// measure a function and print the time per call in microseconds
+template <typename F>
+void measure(const char *name, int count, const F &function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+        function();
+    auto duration = std::chrono::steady_clock::now() - start;
+    double us = std::chrono::duration<double, std::micro>(duration).count() / count;
+    std::cout << name << ": " << us << " us" << std::endl;
+}
+
+
+// String
+// ------
+
+// byte-at-a-time reference implementations
+int scalarIndexOf(String str, char ch) {
+    for (int i = 0; i < str.size(); ++i) {
+        if (str[i] == ch)
+            return i;
+    }
+    return -1;
+}
+
+int scalarIndexOf(String str, String s) {
+    for (int i = 0; i + s.size() <= str.size(); ++i) {
+        int j = 0;
+        while (j < s.size() && str[i + j] == s[j])
+            ++j;
+        if (j == s.size())
+            return i;
+    }
+    return -1;
+}
+
+bool scalarEqual(String a, String b) {
+    if (a.size() != b.size())
+        return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+void benchmarkString() {
+    // 4 MB log buffer
+    std::string log;
+    while (log.size() < 4 * 1024 * 1024)
+        log += "2025-01-01 12:00:00 INFO device 42 sent frame id=0x123 length=8 data=0102030405060708\n";
+    std::string copy = log;
+    log += "ERROR: timeout";
+    copy += "ERROR: timeouT";
+    String str(log);
+    String str2(copy);
+
+    measure("String::indexOf(char) scalar", 20, [str] {keep(scalarIndexOf(str, '!'));});
+    measure("String::indexOf(char)", 20, [str] {keep(str.indexOf('!'));});
+    measure("String::indexOf(String) scalar", 20, [str] {keep(scalarIndexOf(str, "ERROR: timeout"));});
+    measure("String::indexOf(String)", 20, [str] {keep(str.indexOf("ERROR: timeout"));});
+    measure("String::lastIndexOf(char)", 20, [str] {keep(str.lastIndexOf('!'));});
+    measure("String == scalar", 20, [str, str2] {keep(scalarEqual(str, str2));});
+    measure("String ==", 20, [str, str2] {keep(str == str2);});
+}
+
+
+// convert
+// -------
+
+// one digit at a time as reference
+char *scalarDec(char *end, uint32_t value) {
+    char *it = end;
+    do {
+        *--it = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    return it;
+}
+
+char *scalarDec(char *end, uint64_t value) {
+    char *it = end;
+    do {
+        *--it = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    return it;
+}
+
+void benchmarkConvert() {
+    uint32_t values32[256];
+    uint64_t values64[256];
+    uint32_t x = 12345;
+    for (int i = 0; i < 256; ++i) {
+        x = x * 1103515245 + 12345;
+        values32[i] = x >> (i % 32);
+        values64[i] = (uint64_t(x) * 0x9e3779b97f4a7c15ull) >> (i % 64);
+    }
+
+    char buffer[24];
+    char *end = std::end(buffer);
+    measure("dec 32 bit scalar", 10000, [&values32, end] {
+        int length = 0;
+        for (auto value : values32)
+            length += end - scalarDec(end, value);
+        keep(length);
+    });
+    measure("dec 32 bit", 10000, [&values32, end] {
+        int length = 0;
+        for (auto value : values32)
+            length += end - detail::dec(end, value, 1);
+        keep(length);
+    });
+    measure("dec 64 bit scalar", 10000, [&values64, end] {
+        int length = 0;
+        for (auto value : values64)
+            length += end - scalarDec(end, value);
+        keep(length);
+    });
+    measure("dec 64 bit", 10000, [&values64, end] {
+        int length = 0;
+        for (auto value : values64)
+            length += end - detail::dec(end, value, 1);
+        keep(length);
+    });
+
+    double doubles[256];
+    float floats[256];
+    for (int i = 0; i < 256; ++i) {
+        doubles[i] = double(values32[i]) / double(values64[i] % 100000 + 1);
+        floats[i] = float(doubles[i]);
+    }
+    measure("dec(double, 3) snprintf", 1000, [&doubles] {
+        char buffer[64];
+        int length = 0;
+        for (auto value : doubles)
+            length += std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+        keep(length);
+    });
+    measure("dec(double, 3)", 1000, [&doubles] {
+        int length = 0;
+        for (auto value : doubles)
+            length += dec(value, 3).length;
+        keep(length);
+    });
+    measure("dec(float, 3)", 1000, [&floats] {
+        int length = 0;
+        for (auto value : floats)
+            length += dec(value, 3).length;
+        keep(length);
+    });
+    measure("decShortest(double) snprintf %.17g", 1000, [&doubles] {
+        char buffer[64];
+        int length = 0;
+        for (auto value : doubles)
+            length += std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        keep(length);
+    });
+    measure("decShortest(double) std::to_chars", 1000, [&doubles] {
+        char buffer[64];
+        int length = 0;
+        for (auto value : doubles)
+            length += std::to_chars(buffer, buffer + 64, value).ptr - buffer;
+        keep(length);
+    });
+    measure("decShortest(double)", 1000, [&doubles] {
+        int length = 0;
+        for (auto value : doubles)
+            length += decShortest(value).length;
+        keep(length);
+    });
+    measure("decShortest(float) std::to_chars", 1000, [&floats] {
+        char buffer[64];
+        int length = 0;
+        for (auto value : floats)
+            length += std::to_chars(buffer, buffer + 64, value).ptr - buffer;
+        keep(length);
+    });
+    measure("decShortest(float)", 1000, [&floats] {
+        int length = 0;
+        for (auto value : floats)
+            length += decShortest(value).length;
+        keep(length);
+    });
+
+    // parse
+    std::string csv;
+    for (auto value : doubles) {
+        auto str = decShortest(value);
+        csv.append(str.begin, str.length);
+        csv += ',';
+    }
+    measure("parse double strtod", 1000, [&csv] {
+        double sum = 0;
+        const char *it = csv.data();
+        const char *end = it + csv.size();
+        while (it < end) {
+            char *next;
+            sum += std::strtod(it, &next);
+            it = next + 1;
+        }
+        keep(sum);
+    });
+    measure("parse double std::from_chars", 1000, [&csv] {
+        double sum = 0;
+        const char *it = csv.data();
+        const char *end = it + csv.size();
+        while (it < end) {
+            double value;
+            it = std::from_chars(it, end, value).ptr + 1;
+            sum += value;
+        }
+        keep(sum);
+    });
+    measure("parseMany(double)", 1000, [&csv] {
+        double values[256];
+        auto result = parseMany(String(csv), std::span(values));
+        keep(result.value);
+    });
+
+    // hex
+    static uint8_t bytes[4096];
+    static char hexString[8192];
+    for (int i = 0; i < 4096; ++i)
+        bytes[i] = uint8_t(values32[i & 255] >> (i >> 8));
+    measure("hex 4096 bytes one at a time", 100, [] {
+        char *it = hexString;
+        for (auto byte : bytes) {
+            auto str = hex(byte);
+            std::copy(str.begin, str.begin + str.length, it);
+            it += str.length;
+        }
+        keep(it[-1]);
+    });
+    measure("hexEncode 4096 bytes", 100, [] {
+        keep(hexEncode(bytes, hexString)[-1]);
+    });
+    measure("hexDecode 4096 bytes", 100, [] {
+        keep(hexDecode(String(hexString, 8192), bytes).value);
+    });
+
+    // UTF-8, mostly ASCII with some umlauts
+    std::string text;
+    while (text.size() < 64 * 1024)
+        text += "Temperatur 21.5 °C, Luftfeuchtigkeit 45 %, Lüfter läuft, status=ok\n";
+    static char32_t codes[64 * 1024 + 128];
+    measure("utf8 validate one code point at a time", 20, [&text] {
+        String str(text);
+        int count = 0;
+        while (!str.empty()) {
+            auto result = utf8(str);
+            if (!result)
+                break;
+            str = str.substring(result.length);
+            ++count;
+        }
+        keep(count);
+    });
+    measure("isValidUtf8 64K", 20, [&text] {keep(isValidUtf8(text));});
+    measure("countUtf8 64K", 20, [&text] {keep(countUtf8(text));});
+    measure("utf8ToUtf32 64K", 20, [&text] {keep(utf8ToUtf32(text, codes).value);});
+}
+
+
+// format
+// ------
+
+void benchmarkFormat() {
+    int values[256];
+    float floats[256];
+    uint32_t x = 12345;
+    for (int i = 0; i < 256; ++i) {
+        x = x * 1103515245 + 12345;
+        values[i] = int(x) >> (i % 32);
+        floats[i] = float(values[i]) * 0.001f;
+    }
+    static StringBuffer<128> buffer;
+    measure("telemetry line with stream operators", 1000, [&values, &floats] {
+        int length = 0;
+        for (int i = 0; i < 256; ++i) {
+            buffer.clear();
+            buffer << "id=" << dec(i) << " value=" << dec(values[i]) << " flags=" << hex(uint16_t(values[i]))
+                << " t=" << dec(floats[i], 2) << '\n';
+            length += buffer.size();
+        }
+        keep(length);
+    });
+    measure("telemetry line with format", 1000, [&values, &floats] {
+        int length = 0;
+        for (int i = 0; i < 256; ++i) {
+            buffer.clear();
+            format<"id={} value={} flags={:04x} t={:.2}\n">(buffer, i, values[i], uint16_t(values[i]), floats[i]);
+            length += buffer.size();
+        }
+        keep(length);
+    });
+}
+
+
+// binlog
+// ------
+
+// record data of the binary log
+static uint8_t binlogData[256 * 32];
+static int binlogLength;
+
+void binlogWrite(const char *data, int length) {
+    std::memcpy(binlogData + binlogLength, data, length);
+    binlogLength += length;
+}
+
+void benchmarkBinlog() {
+    int values[256];
+    float floats[256];
+    uint32_t x = 12345;
+    for (int i = 0; i < 256; ++i) {
+        x = x * 1103515245 + 12345;
+        values[i] = int(x) >> (i % 32);
+        floats[i] = float(values[i]) * 0.001f;
+    }
+    static StringBuffer<128> buffer;
+    int textLength = 0;
+    measure("telemetry line with format", 1000, [&values, &floats, &textLength] {
+        textLength = 0;
+        for (int i = 0; i < 256; ++i) {
+            buffer.clear();
+            format<"id={} value={} flags={:04x} t={:.2}\n">(buffer, i, values[i], uint16_t(values[i]), floats[i]);
+            textLength += buffer.size();
+        }
+    });
+    measure("telemetry line with binlog", 1000, [&values, &floats] {
+        binlogLength = 0;
+        for (int i = 0; i < 256; ++i) {
+            COCO_BINLOG_TO(binlogWrite, "id={} value={} flags={:04x} t={:.2}\n", i, values[i], uint16_t(values[i]),
+                floats[i]);
+        }
+        keep(binlogLength);
+    });
+    std::cout << "text: " << textLength << " bytes, binlog: " << binlogLength << " bytes" << std::endl;
+}
+
+
+// LogBuffer
+// ---------
+
+void benchmarkLogBuffer() {
+    static LogBuffer<65536> buffer;
+    static char destination[65536];
+    const char *message = "2025-01-01 12:00:00 INFO device 42 sent frame id=0x123\n";
+    int length = std::strlen(message);
+    measure("memcpy 1000 messages", 1000, [message, length] {
+        char *it = destination;
+        for (int i = 0; i < 1000; ++i) {
+            std::memcpy(it, message, length);
+            it += length;
+        }
+        keep(it[-1]);
+    });
+    measure("LogBuffer::write 1000 messages", 1000, [message, length] {
+        for (int i = 0; i < 1000; ++i)
+            buffer.write(message, length);
+        buffer.consume(buffer.size());
+    });
+}
+
+
+// Bitset
+// ------
+
+// bit-at-a-time reference implementations
+template <int N>
+int scalarFindFirstClear(const Bitset<N> &bitset) {
+    for (int i = 0; i < N; ++i) {
+        if (!bitset[i])
+            return i;
+    }
+    return -1;
+}
+
+template <typename T, typename T2>
+int scalarPopcountBefore(T value, T2 bit) {
+    int count = 0;
+    for (unsigned i = 1; i < unsigned(bit); i <<= 1) {
+        if (unsigned(value) & i)
+            ++count;
+    }
+    return count;
+}
+
+void benchmarkBitset() {
+    // allocate and free a page in a map of 4096 flash pages where the lower pages are in use
+    Bitset<4096> pages;
+    pages.setRange(0, 3000);
+    const int count = 100000;
+    measure("Bitset::findFirstClear() in 4096 pages", count, [&pages] {
+        int page = pages.findFirstClear();
+        pages.set(page);
+        keep(page);
+        pages.clear(page);
+    });
+    measure("bit-by-bit search in 4096 pages", count, [&pages] {
+        int page = scalarFindFirstClear(pages);
+        pages.set(page);
+        keep(page);
+        pages.clear(page);
+    });
+
+    // popcountBefore() for varying bits
+    volatile unsigned value = 0x5555aaaa;
+    measure("popcountBefore() x 1000", 1000, [&value] {
+        int sum = 0;
+        for (int i = 0; i < 1000; ++i)
+            sum += popcountBefore(unsigned(value), 1u << (i & 31));
+        keep(sum);
+    });
+    measure("bit-by-bit popcountBefore() x 1000", 1000, [&value] {
+        int sum = 0;
+        for (int i = 0; i < 1000; ++i)
+            sum += scalarPopcountBefore(unsigned(value), 1u << (i & 31));
+        keep(sum);
+    });
+}
+
+
+// MonotonicArena
+// --------------
+
+CoroutineTaskList<> arenaList;
+
+// the frame gets allocated from the arena parameter
+Coroutine requestStep(MonotonicArena &, int &counter) {
+    ++counter;
+    co_await Awaitable<>(arenaList);
+    ++counter;
+}
+
+Coroutine requestStep(int &counter) {
+    ++counter;
+    co_await Awaitable<>(arenaList);
+    ++counter;
+}
+
+void benchmarkMonotonicArena() {
+    // per request 8 coroutines and 8 small objects that all die when the request is complete
+    const int count = 100000;
+    alignas(std::max_align_t) static uint8_t buffer[4096];
+    MonotonicArena arena(buffer);
+    int counter = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            requestStep(arena, counter);
+            keep(arena.create<std::pair<int, int>>(i, j));
+        }
+        arenaList.doAll();
+        arena.reset();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "MonotonicArena request: " << ns / count << " ns, high-water mark " << arena.highWaterMark()
+        << " bytes" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::pair<int, int> *objects[8];
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            requestStep(counter);
+            objects[j] = new std::pair<int, int>(i, j);
+            keep(objects[j]);
+        }
+        arenaList.doAll();
+        for (auto object : objects)
+            delete object;
+    }
+    ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Heap request: " << ns / count << " ns" << std::endl;
+    keep(counter);
+}
+
+
+// ObjectPool
+// ----------
+
+struct PoolTransfer {
+    uint8_t *data;
+    int length;
+    int state;
+};
+
+void benchmarkObjectPool() {
+    // allocate and free in one thread compared to new/delete
+    const int count = 1000000;
+    static ObjectPool<PoolTransfer, 64> pool;
+    PoolTransfer *transfers[4];
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        auto &transfer = transfers[i & 3];
+        if (i >= 4)
+            pool.destroy(transfer);
+        transfer = pool.create(nullptr, i, 0);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    for (auto transfer : transfers)
+        pool.destroy(transfer);
+    std::cout << "ObjectPool create/destroy: " << ns / count << " ns" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        auto &transfer = transfers[i & 3];
+        if (i >= 4)
+            delete transfer;
+        transfer = new PoolTransfer{nullptr, i, 0};
+        keep(transfer);
+    }
+    ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    for (auto transfer : transfers)
+        delete transfer;
+    std::cout << "new/delete: " << ns / count << " ns" << std::endl;
+
+    // contended by 4 threads
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            PoolTransfer *transfers[4] = {};
+            for (int i = 0; i < count / 4; ++i) {
+                auto &transfer = transfers[i & 3];
+                pool.destroy(transfer);
+                transfer = pool.create(nullptr, i, 0);
+            }
+            for (auto transfer : transfers)
+                pool.destroy(transfer);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "ObjectPool create/destroy, 4 threads: " << ns / count << " ns, high-water mark "
+        << pool.highWaterMark() << std::endl;
+}
+
+
+// SeqLock
+// -------
+
+struct Pose {
+    float position[3];
+    float orientation[4];
+};
+
+// emulation of a lock that disables interrupts: the writer can not run while the reader holds it
+struct SpinLock {
+    void lock() {while (this->flag.test_and_set(std::memory_order_acquire));}
+    void unlock() {this->flag.clear(std::memory_order_release);}
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+};
+
+template <typename L>
+struct LockedPose {
+    void write(const Pose &pose) {
+        std::lock_guard guard(this->lock);
+        this->pose = pose;
+    }
+    Pose read() {
+        std::lock_guard guard(this->lock);
+        return this->pose;
+    }
+    L lock;
+    Pose pose = {};
+};
+
+// read the pose while a thread updates it every 100 us
+template <typename S>
+void benchmarkPose(const char *name, S &state) {
+    const int count = 2000000;
+    std::atomic<bool> done = false;
+    std::thread writer([&state, &done] {
+        Pose pose = {};
+        while (!done) {
+            pose.position[0] += 1.0f;
+            state.write(pose);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    float sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+        sum += state.read().position[0];
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    done = true;
+    writer.join();
+    keep(sum);
+    std::cout << name << " read: " << ns / count << " ns" << std::endl;
+}
+
+void benchmarkSeqLock() {
+    SeqLock<Pose> seqLock;
+    benchmarkPose("SeqLock", seqLock);
+    LockedPose<SpinLock> spinLock;
+    benchmarkPose("Spin lock (interrupt lock emulation)", spinLock);
+    LockedPose<std::mutex> mutex;
+    benchmarkPose("std::mutex", mutex);
+}
+
+
+// File
+// ----
+
+void benchmarkFile() {
+    // setup of a 1 MiB emulated flash image
+    const int size = 1024 * 1024;
+    auto path = fs::temp_directory_path() / "cocoBenchmark.bin";
+    measure("flash image, 16 byte writes", 10, [&path, size] {
+        File f(path, File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+        uint8_t buffer[16];
+        std::memset(buffer, 0xff, 16);
+        for (int i = 0; i < size; i += 16)
+            f.write(i, buffer, 16);
+    });
+    measure("flash image, File::resize(0xff)", 10, [&path, size] {
+        File f(path, File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+        f.resize(size, 0xff);
+    });
+    measure("flash image, File::resize(0)", 10, [&path, size] {
+        File f(path, File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+        f.resize(size);
+    });
+    fs::remove(path);
+}
+
+
+#ifdef __linux__
+
+// EventLoop
+// ---------
+
+struct TimedMessage : EventLoop::Message {
+    void handle() {
+        auto latency = std::chrono::steady_clock::now() - this->start;
+        *this->total += std::chrono::duration<double, std::micro>(latency).count();
+        if (--*this->remaining == 0)
+            this->loop->exit();
+    }
+
+    std::chrono::steady_clock::time_point start;
+    EventLoop *loop;
+    double *total;
+    int *remaining;
+};
+
+// ping-pong between two coroutines through pipes
+Coroutine pingPong(EventLoop &loop, int in, int out, int count, bool first) {
+    char ch = 0;
+    if (first)
+        ::write(out, &ch, 1);
+    for (int i = 0; i < count; ++i) {
+        while (::read(in, &ch, 1) != 1)
+            co_await loop.readable(in);
+        if (!first || i < count - 1)
+            ::write(out, &ch, 1);
+    }
+    if (first)
+        loop.exit();
+}
+
+void benchmarkEventLoop() {
+    EventLoop loop;
+
+    // latency from post() in another thread to the callback while the loop sleeps
+    const int count = 1000;
+    std::vector<TimedMessage> messages(count);
+    double total = 0;
+    int remaining = count;
+    for (auto &message : messages) {
+        message.callback = makeCallback<TimedMessage, &TimedMessage::handle>(&message);
+        message.loop = &loop;
+        message.total = &total;
+        message.remaining = &remaining;
+    }
+    std::thread thread([&loop, &messages] {
+        for (auto &message : messages) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            message.start = std::chrono::steady_clock::now();
+            loop.post(message);
+        }
+    });
+    loop.run();
+    thread.join();
+    std::cout << "EventLoop post wakeup latency: " << total / count << " us" << std::endl;
+
+    // throughput of post() from another thread
+    const int count2 = 100000;
+    std::vector<TimedMessage> messages2(count2);
+    remaining = count2;
+    for (auto &message : messages2) {
+        message.callback = makeCallback<TimedMessage, &TimedMessage::handle>(&message);
+        message.loop = &loop;
+        message.total = &total;
+        message.remaining = &remaining;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::thread thread2([&loop, &messages2] {
+        for (auto &message : messages2)
+            loop.post(message);
+    });
+    loop.run();
+    thread2.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "EventLoop post throughput: " << count2 / s / 1e6 << " M messages/s" << std::endl;
+
+    // file descriptor readiness: round trip between two coroutines through two pipes
+    int a[2], b[2];
+    if (pipe2(a, O_NONBLOCK) != 0 || pipe2(b, O_NONBLOCK) != 0)
+        return;
+    const int count3 = 10000;
+    start = std::chrono::steady_clock::now();
+    pingPong(loop, b[0], a[1], count3, true);
+    pingPong(loop, a[0], b[1], count3, false);
+    loop.run();
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "EventLoop pipe round trip: " << us / count3 << " us" << std::endl;
+    for (int fd : {a[0], a[1], b[0], b[1]}) {
+        loop.remove(fd);
+        close(fd);
+    }
+}
+
+
+// Socket
+// ------
+
+Coroutine echoServer(Socket &server) {
+    Socket client(server.getLoop());
+    if (co_await server.accept(client) != 0)
+        co_return;
+    static uint8_t buffer[65536];
+    int n;
+    while ((n = co_await client.recv(buffer, sizeof(buffer))) > 0)
+        co_await client.send(buffer, n);
+}
+
+Coroutine echoClient(Socket &socket, const Socket::Address &address, int size, int count, double &us) {
+    co_await socket.connect(address);
+    std::vector<uint8_t> data(size);
+    std::vector<uint8_t> buffer(size);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        co_await socket.send(data.data(), size);
+        int received = 0;
+        while (received < size) {
+            int n = co_await socket.recv(buffer.data() + received, size - received);
+            if (n <= 0)
+                co_return;
+            received += n;
+        }
+    }
+    us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    socket.getLoop().exit();
+}
+
+void benchmarkSocket() {
+    EventLoop loop;
+    for (int size : {64, 65536}) {
+        Socket server(loop, AF_INET, SOCK_STREAM);
+        server.bind(Socket::Address::inet("127.0.0.1", 0));
+        server.listen();
+        auto address = server.getAddress();
+        Socket client(loop, AF_INET, SOCK_STREAM);
+        int count = size == 64 ? 20000 : 2000;
+        double us = 0;
+        echoServer(server);
+        echoClient(client, address, size, count, us);
+        loop.run();
+        client.close();
+        loop.runOnce(false);
+        std::cout << "TCP loopback echo " << size << " bytes: " << us / count << " us, "
+            << 2.0 * size * count / us << " MB/s" << std::endl;
+    }
+}
+
+
+// WaitableMpscQueue
+// -----------------
+
+struct WaitableBenchmarkMessage : public IntrusiveMpscQueueNode {
+    std::chrono::steady_clock::time_point start;
+};
+
+enum class ConsumerMode {SPIN, SLEEP, FUTEX};
+
+// latency from push() in another thread to the consumer and CPU time of the consumer per message
+void benchmarkConsumer(const char *name, ConsumerMode mode) {
+    const int count = 2000;
+    WaitableMpscQueue<WaitableBenchmarkMessage> queue;
+    std::vector<WaitableBenchmarkMessage> messages(count);
+    std::thread thread([&queue, &messages] {
+        for (auto &message : messages) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            message.start = std::chrono::steady_clock::now();
+            queue.push(message);
+        }
+    });
+
+    timespec cpuStart, cpuEnd;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuStart);
+    double total = 0;
+    for (int i = 0; i < count; ++i) {
+        WaitableBenchmarkMessage *message;
+        switch (mode) {
+        case ConsumerMode::SPIN:
+            while ((message = queue.pop()) == nullptr)
+                std::this_thread::yield();
+            break;
+        case ConsumerMode::SLEEP:
+            while ((message = queue.pop()) == nullptr)
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            break;
+        default:
+            message = queue.wait();
+        }
+        total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - message->start).count();
+    }
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+    thread.join();
+    double cpu = (cpuEnd.tv_sec - cpuStart.tv_sec) * 1e6 + (cpuEnd.tv_nsec - cpuStart.tv_nsec) * 1e-3;
+    std::cout << "MpscQueue consumer " << name << ": latency " << total / count << " us, CPU " << cpu / count
+        << " us/message" << std::endl;
+}
+
+void benchmarkWaitableMpscQueue() {
+    benchmarkConsumer("spin", ConsumerMode::SPIN);
+    benchmarkConsumer("sleep", ConsumerMode::SLEEP);
+    benchmarkConsumer("futex", ConsumerMode::FUTEX);
+}
+
+
+// SharedMpscQueue
+// ---------------
+
+struct SharedBenchmarkMessage : public SharedMpscQueueNode {
+    uint8_t data[4096];
+};
+
+struct SharedBenchmarkLayout {
+    SharedMpscQueue<SharedBenchmarkMessage> requests;
+    SharedMpscQueue<SharedBenchmarkMessage> responses;
+    SharedBenchmarkMessage message;
+};
+
+void benchmarkSharedMpscQueue() {
+    // round trip of a 4 KiB message between two processes, e.g. application and peripheral emulator
+    const int count = 20000;
+
+    // pipes: the message gets copied into and out of the kernel in each direction
+    int a[2], b[2];
+    if (pipe(a) != 0 || pipe(b) != 0)
+        return;
+    pid_t pid = fork();
+    if (pid == 0) {
+        uint8_t data[4096];
+        for (int i = 0; i < count; ++i) {
+            if (::read(a[0], data, sizeof(data)) != sizeof(data))
+                break;
+            ::write(b[1], data, sizeof(data));
+        }
+        _exit(0);
+    }
+    uint8_t data[4096] = {};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        ::write(a[1], data, sizeof(data));
+        ::read(b[0], data, sizeof(data));
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    waitpid(pid, nullptr, 0);
+    for (int fd : {a[0], a[1], b[0], b[1]})
+        close(fd);
+    std::cout << "Process pipe round trip: " << us / count << " us" << std::endl;
+
+    // shared memory: the message stays in place, only its offset gets passed
+    SharedMemory memory("benchmark", sizeof(SharedBenchmarkLayout));
+    auto &layout = memory.construct<SharedBenchmarkLayout>(0);
+    pid = fork();
+    if (pid == 0) {
+        for (int i = 0; i < count; ++i) {
+            auto message = layout.requests.wait();
+            ++message->data[0];
+            layout.responses.push(*message);
+        }
+        _exit(0);
+    }
+    start = std::chrono::steady_clock::now();
+    auto *message = &layout.message;
+    for (int i = 0; i < count; ++i) {
+        layout.requests.push(*message);
+        message = layout.responses.wait();
+    }
+    us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    waitpid(pid, nullptr, 0);
+    std::cout << "Process SharedMpscQueue round trip: " << us / count << " us" << std::endl;
+}
+
+#endif
+
+
+// hash
+// ----
+
+void benchmarkHash() {
+    std::string keys[64];
+    for (int i = 0; i < 64; ++i)
+        keys[i] = "sensor/" + std::to_string(i * 7919) + "/temperature" + std::string(i % 16, 'x');
+
+    for (int length : {8, 16, 32}) {
+        std::cout << length << " byte keys" << std::endl;
+        measure("  djb2", 100000, [&keys, length] {
+            uint32_t h = 0;
+            for (auto &key : keys)
+                h += djb2(key.data(), length);
+            keep(h);
+        });
+        measure("  hash", 100000, [&keys, length] {
+            uint32_t h = 0;
+            for (auto &key : keys)
+                h += hash(key.data(), length);
+            keep(h);
+        });
+    }
+
+    std::string buffer(1024 * 1024, 'x');
+    measure("djb2 1 MB", 100, [&buffer] {keep(djb2(buffer.data(), int(buffer.size())));});
+    measure("hash 1 MB", 100, [&buffer] {keep(hash(buffer.data(), int(buffer.size())));});
+}
+
+
+// PerfectHash
+// -----------
+
+#define COMMANDS "help", "version", "reset", "reboot", "status", "start", "stop", "pause", "resume", "get", "set", \
+    "list", "info", "log", "level", "clear", "read", "write", "erase", "flash", "verify", "dump", "load", "save", \
+    "config", "network", "address", "gateway", "netmask", "dns", "ping", "time", "date", "uptime", "sensor", \
+    "temperature", "humidity", "pressure", "voltage", "current", "power", "led", "button", "motor", "speed", \
+    "position", "calibrate", "debug", "trace", "echo"
+
+constexpr String commandList[] = {COMMANDS};
+constexpr PerfectHash commandHash(COMMANDS);
+
+int linearFind(String str) {
+    for (int i = 0; i < int(std::size(commandList)); ++i) {
+        if (commandList[i] == str)
+            return i;
+    }
+    return -1;
+}
+
+void benchmarkPerfectHash() {
+    // look up each command and some unknown strings
+    std::string strings[64];
+    for (int i = 0; i < 64; ++i) {
+        strings[i] = i < int(std::size(commandList))
+            ? std::string(commandList[i].data(), commandList[i].size()) : "unknown" + std::to_string(i);
+    }
+
+    std::cout << std::size(commandList) << " commands" << std::endl;
+    measure("  linear ==", 100000, [&strings] {
+        int sum = 0;
+        for (auto &str : strings)
+            sum += linearFind(str);
+        keep(sum);
+    });
+    measure("  PerfectHash", 100000, [&strings] {
+        int sum = 0;
+        for (auto &str : strings)
+            sum += commandHash.find(str);
+        keep(sum);
+    });
+}
+
+
+int main() {
+    benchmarkString();
+    benchmarkConvert();
+    benchmarkFormat();
+    benchmarkBinlog();
+    benchmarkLogBuffer();
+    benchmarkBitset();
+    benchmarkMonotonicArena();
+    benchmarkObjectPool();
+    benchmarkSeqLock();
+    benchmarkFile();
+#ifdef __linux__
+    benchmarkEventLoop();
+    benchmarkSocket();
+    benchmarkWaitableMpscQueue();
+    benchmarkSharedMpscQueue();
+#endif
+    benchmarkHash();
+    benchmarkPerfectHash();
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <coco/Coroutine.hpp>
+#include <coco/MonotonicArena.hpp>
 #include <coco/Semaphore.hpp>
 #include <coco/String.hpp>
 
@@ -339,6 +340,189 @@ TEST(cocoTest, ResumeBarrierAfterReturn) {
 }
 
 
+// Barrier with keys
+// -----------------
+
+Barrier<CoroutineKeyedTask<int>> keyedBarrier;
+int keyedResumeCount[3];
+
+Coroutine waitForKey(int key) {
+	co_await keyedBarrier.untilResumed(key);
+	++keyedResumeCount[key];
+}
+
+TEST(cocoTest, KeyedBarrier) {
+	waitForKey(0);
+	waitForKey(1);
+	waitForKey(1);
+	auto c = waitForKey(2);
+	waitForKey(1);
+	EXPECT_TRUE(keyedBarrier.contains(1));
+
+	// resume only the waiters for key 1
+	keyedBarrier.doAll(1);
+	EXPECT_EQ(keyedResumeCount[0], 0);
+	EXPECT_EQ(keyedResumeCount[1], 3);
+	EXPECT_FALSE(keyedBarrier.contains(1));
+
+	// destroying a waiting coroutine removes it from the barrier
+	c.destroy();
+	EXPECT_FALSE(keyedBarrier.contains(2));
+
+	EXPECT_TRUE(keyedBarrier.doFirst(0));
+	EXPECT_FALSE(keyedBarrier.doFirst(0));
+	EXPECT_EQ(keyedResumeCount[0], 1);
+	EXPECT_TRUE(keyedBarrier.empty());
+}
+
+struct KeyedParameters {
+	int value;
+};
+Barrier<CoroutineKeyedTaskWithParameters<int, KeyedParameters>> keyedBarrierWithParameters;
+int keyedValueSum = 0;
+
+Coroutine waitForKeyWithParameters(int key, int value) {
+	co_await keyedBarrierWithParameters.untilResumed(key, value);
+	keyedValueSum += value;
+}
+
+TEST(cocoTest, KeyedBarrierWithParameters) {
+	waitForKeyWithParameters(5, 1);
+	waitForKeyWithParameters(5, 2);
+	waitForKeyWithParameters(5, 4);
+	waitForKeyWithParameters(6, 8);
+
+	// resume first waiter of key 5 by predicate on parameters, the next waiter takes its place
+	keyedBarrierWithParameters.doAll(5, [](KeyedParameters &p) {return p.value != 2;});
+	EXPECT_EQ(keyedValueSum, 5);
+	EXPECT_TRUE(keyedBarrierWithParameters.contains(5));
+
+	keyedBarrierWithParameters.doAll();
+	EXPECT_EQ(keyedValueSum, 15);
+	EXPECT_TRUE(keyedBarrierWithParameters.empty());
+}
+
+
+// MonotonicArena
+// --------------
+
+TEST(cocoTest, MonotonicArena) {
+	uint8_t buffer[64];
+	MonotonicArena arena(buffer);
+	EXPECT_EQ(arena.capacity(), 64);
+
+	// aligned allocation
+	auto c = arena.create<char>('a');
+	auto i = arena.create<int>(5);
+	EXPECT_EQ(*c, 'a');
+	EXPECT_EQ(*i, 5);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(i) % alignof(int), 0u);
+	EXPECT_EQ(arena.size(), 8);
+
+	// the last allocation can be returned
+	arena.deallocate(i, sizeof(int));
+	EXPECT_EQ(arena.size(), 4);
+
+	// overflow to the heap
+	void *large = arena.allocate(100);
+	EXPECT_NE(large, nullptr);
+	EXPECT_EQ(arena.overflowCount(), 1);
+	EXPECT_EQ(arena.heapSize(), 100);
+
+	// release everything at once
+	arena.reset();
+	EXPECT_EQ(arena.size(), 0);
+	EXPECT_EQ(arena.heapSize(), 0);
+	EXPECT_EQ(arena.highWaterMark(), 8);
+	EXPECT_EQ(arena.allocationCount(), 3);
+
+	// allocation from an ArrayBuffer
+	ArrayBuffer<uint8_t, 32> buffer2;
+	MonotonicArena arena2(buffer2);
+	EXPECT_EQ(arena2.capacity(), 32);
+	EXPECT_EQ(arena2.allocate(16, 1), buffer2.data());
+}
+
+int arenaFailedSize = 0;
+
+TEST(cocoTest, MonotonicArenaFail) {
+	uint8_t buffer[16];
+	MonotonicArena arena(buffer, MonotonicArena::Overflow::FAIL, [](MonotonicArena &, int size) {
+		arenaFailedSize = size;
+	});
+	EXPECT_NE(arena.allocate(16, 1), nullptr);
+	EXPECT_EQ(arena.allocate(1, 1), nullptr);
+	EXPECT_EQ(arenaFailedSize, 1);
+	EXPECT_EQ(arena.overflowCount(), 1);
+}
+
+// the frame gets allocated from the arena parameter
+Coroutine arenaCoroutine(MonotonicArena &, int &state) {
+	state = 1;
+	co_await wait1();
+	state = 2;
+}
+
+AwaitableCoroutine arenaInner(MonotonicArena &, int &state) {
+	co_await wait1();
+	state = 2;
+}
+
+Coroutine heapCoroutine(int &state) {
+	co_await wait1();
+	state = 4;
+}
+
+AwaitableCoroutine arenaAwaitableCoroutine(int &state, MonotonicArena &arena) {
+	// nested coroutine also allocates from the arena
+	co_await arenaInner(arena, state);
+	state = 3;
+}
+
+TEST(cocoTest, MonotonicArenaCoroutine) {
+	alignas(std::max_align_t) uint8_t buffer[1024];
+	MonotonicArena arena(buffer);
+
+	// coroutine frame gets allocated from the arena
+	int state = 0;
+	arenaCoroutine(arena, state);
+	EXPECT_EQ(state, 1);
+	EXPECT_GT(arena.size(), 0);
+	EXPECT_EQ(arena.allocationCount(), 1);
+	taskList1.doAll();
+	EXPECT_EQ(state, 2);
+
+	// the frame was the last allocation, therefore its memory is available again
+	EXPECT_EQ(arena.size(), 0);
+
+	// awaitable coroutine waits for a nested coroutine
+	{
+		auto a = arenaAwaitableCoroutine(state, arena);
+		EXPECT_EQ(arena.allocationCount(), 3);
+		taskList1.doAll();
+		EXPECT_EQ(state, 3);
+	}
+	arena.reset();
+
+	// coroutine without arena still gets allocated from the heap
+	heapCoroutine(state);
+	taskList1.doAll();
+	EXPECT_EQ(state, 4);
+	EXPECT_EQ(arena.allocationCount(), 3);
+
+	// allocation failure: the coroutine does not run
+	uint8_t small[8];
+	MonotonicArena arena2(small, MonotonicArena::Overflow::FAIL);
+	state = 0;
+	auto e = arenaCoroutine(arena2, state);
+	EXPECT_FALSE(e);
+	EXPECT_EQ(state, 0);
+	auto f = arenaAwaitableCoroutine(state, arena2);
+	EXPECT_FALSE(f.isAlive());
+	EXPECT_EQ(state, 0);
+}
+
+
 // Semaphore
 // ---------
 
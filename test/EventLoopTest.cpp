@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <coco/platform/EventLoop.hpp>
+#include <coco/platform/File.hpp>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+
+using namespace coco;
+using namespace coco::literals;
+
+// test for EventLoop
+
+Coroutine loopSleeper(EventLoop &loop, Milliseconds<> duration, std::string &log, char id) {
+    co_await loop.sleep(duration);
+    log += id;
+}
+
+Coroutine loopYielder(EventLoop &loop, std::string &log, char id) {
+    for (int i = 0; i < 3; ++i) {
+        log += id;
+        co_await loop.yield();
+    }
+}
+
+TEST(cocoTest, EventLoopSleep) {
+    EventLoop loop;
+    ASSERT_TRUE(loop.isValid());
+    std::string log;
+
+    auto start = EventLoop::now();
+    loopSleeper(loop, 30ms, log, 'c');
+    loopSleeper(loop, 10ms, log, 'a');
+    loopSleeper(loop, 20ms, log, 'b');
+    while (log.size() < 3)
+        loop.runOnce();
+    EXPECT_EQ(log, "abc");
+    EXPECT_GE(EventLoop::now() - start, 30ms);
+
+    // yield alternates between the coroutines
+    log.clear();
+    loopYielder(loop, log, 'a');
+    loopYielder(loop, log, 'b');
+    loop.runOnce();
+    loop.runOnce();
+    EXPECT_EQ(log, "ababab");
+
+    // let the coroutines finish
+    loop.runOnce();
+}
+
+Coroutine loopReader(EventLoop &loop, int fd, std::string &log) {
+    while (true) {
+        uint32_t events = co_await loop.readable(fd);
+        if (events == 0) {
+            log += "removed";
+            break;
+        }
+        char buffer[16];
+        int n;
+        while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+            log.append(buffer, n);
+        if (n == 0) {
+            log += "eof";
+            break;
+        }
+    }
+}
+
+TEST(cocoTest, EventLoopReadable) {
+    EventLoop loop;
+    std::string log;
+
+    int fds[2];
+    ASSERT_EQ(pipe2(fds, O_NONBLOCK), 0);
+    loopReader(loop, fds[0], log);
+    loop.runOnce(false);
+    EXPECT_EQ(log, "");
+
+    EXPECT_EQ(write(fds[1], "foo", 3), 3);
+    loop.runOnce();
+    EXPECT_EQ(log, "foo");
+    EXPECT_EQ(write(fds[1], "bar", 3), 3);
+    loop.runOnce();
+    EXPECT_EQ(log, "foobar");
+
+    // end of file
+    close(fds[1]);
+    loop.runOnce();
+    EXPECT_EQ(log, "foobareof");
+    loop.remove(fds[0]);
+    close(fds[0]);
+
+    // remove while waiting, the file descriptor number gets reused
+    log.clear();
+    ASSERT_EQ(pipe2(fds, O_NONBLOCK), 0);
+    loopReader(loop, fds[0], log);
+    loop.runOnce(false);
+    loop.remove(fds[0]);
+    EXPECT_EQ(log, "removed");
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(cocoTest, EventLoopPost) {
+    EventLoop loop;
+
+    // post from other threads, the loop exits after all messages were handled
+    struct Counter {
+        void increment() {
+            if (++this->count == 1000)
+                this->loop->exit();
+        }
+        EventLoop *loop;
+        int count = 0;
+    };
+    Counter counter{&loop};
+    std::vector<EventLoop::Message> messages(1000);
+    for (auto &message : messages)
+        message.callback = makeCallback<Counter, &Counter::increment>(&counter);
+    std::thread thread1([&loop, &messages] {
+        for (int i = 0; i < 500; ++i)
+            loop.post(messages[i]);
+    });
+    std::thread thread2([&loop, &messages] {
+        for (int i = 500; i < 1000; ++i)
+            loop.post(messages[i]);
+    });
+    loop.run();
+    thread1.join();
+    thread2.join();
+    EXPECT_EQ(counter.count, 1000);
+}
+
+Coroutine loopFile(IoUring &ring, File &file, int &result) {
+    result = co_await file.writeAsync(ring, 0, "foo", 3);
+}
+
+TEST(cocoTest, EventLoopIoUring) {
+    EventLoop loop;
+    IoUring ring;
+    loop.attach(ring);
+    File file(fs::temp_directory_path() / "cocoEventLoopTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+
+    int result = 0;
+    loopFile(ring, file, result);
+    while (result == 0)
+        loop.runOnce();
+    EXPECT_EQ(result, 3);
+}
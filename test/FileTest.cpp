@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <coco/platform/File.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+using namespace coco;
+
+
+// File
+// ----
+
+TEST(cocoTest, File) {
+    File f(fs::temp_directory_path() / "cocoFileTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+    char str[4];
+
+    EXPECT_EQ(f.write(0, "foo", 3), 3);
+    EXPECT_EQ(f.read(0, str, 3), 3);
+    str[3] = 0;
+    EXPECT_STREQ(str, "foo");
+
+    EXPECT_EQ(f.write(3, "bar", 3), 3);
+    EXPECT_EQ(f.read(3, str, 3), 3);
+    str[3] = 0;
+    EXPECT_STREQ(str, "bar");
+}
+
+TEST(cocoTest, FileMapped) {
+    File f(fs::temp_directory_path() / "cocoFileMappedTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+
+    // an empty file has an empty view, but stays in mapped mode
+    EXPECT_TRUE(f.map().empty());
+    EXPECT_TRUE(f.isMapped());
+
+    // growing the file grows the mapping
+    f.resize(4096, 0xff);
+    auto view = f.getView();
+    ASSERT_EQ(view.size(), 4096);
+    EXPECT_EQ(view[0], 0xff);
+    EXPECT_EQ(view[4095], 0xff);
+
+    // write() and fill() go to the mapping, changes of the mapping are visible to read()
+    EXPECT_EQ(f.write(100, "foo", 3), 3);
+    EXPECT_EQ(std::memcmp(view.data() + 100, "foo", 3), 0);
+    f.fill(200, 0x55, 10);
+    EXPECT_EQ(view[209], 0x55);
+    std::memcpy(view.data() + 300, "bar", 3);
+    char str[4] = {};
+    EXPECT_EQ(f.read(300, str, 3), 3);
+    EXPECT_STREQ(str, "bar");
+    f.flush();
+
+    // shrink the file
+    f.resize(1000);
+    view = f.getView();
+    ASSERT_EQ(view.size(), 1000);
+    EXPECT_EQ(std::memcmp(view.data() + 100, "foo", 3), 0);
+
+    // contents are in the file after unmapping
+    f.unmap();
+    EXPECT_FALSE(f.isMapped());
+    EXPECT_TRUE(f.getView().empty());
+    EXPECT_EQ(f.getSize(), 1000);
+    EXPECT_EQ(f.read(100, str, 3), 3);
+    EXPECT_STREQ(str, "foo");
+}
+
+TEST(cocoTest, FileFill) {
+    File f(fs::temp_directory_path() / "cocoFileFillTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+    std::vector<uint8_t> data;
+    auto readAll = [&f, &data]() {
+        data.resize(f.getSize());
+        return f.read(0, data.data(), int(data.size())) == int(data.size());
+    };
+
+    // grow with a value, more than one pwritev() call
+    const int size = 1024 * 1024 + 1000;
+    f.resize(size, 0xff);
+    EXPECT_EQ(f.getSize(), size);
+    ASSERT_TRUE(readAll());
+    EXPECT_TRUE(std::all_of(data.begin(), data.end(), [](uint8_t b) {return b == 0xff;}));
+
+    // fill zeros inside the file (hole) and across the end of the file
+    f.fill(5000, 0, 10000);
+    f.fill(size - 100, 0, 200);
+    EXPECT_EQ(f.getSize(), size + 100);
+    ASSERT_TRUE(readAll());
+    EXPECT_EQ(data[4999], 0xff);
+    EXPECT_TRUE(std::all_of(data.begin() + 5000, data.begin() + 15000, [](uint8_t b) {return b == 0;}));
+    EXPECT_EQ(data[15000], 0xff);
+    EXPECT_EQ(data[size - 101], 0xff);
+    EXPECT_TRUE(std::all_of(data.end() - 200, data.end(), [](uint8_t b) {return b == 0;}));
+
+    // fill a value in the middle
+    f.fill(100, 0x55, 17);
+    ASSERT_TRUE(readAll());
+    EXPECT_EQ(data[99], 0xff);
+    EXPECT_EQ(data[100], 0x55);
+    EXPECT_EQ(data[116], 0x55);
+    EXPECT_EQ(data[117], 0xff);
+
+    // grow with zeros, shrink
+    f.resize(size * 2);
+    EXPECT_EQ(f.getSize(), size * 2);
+    uint8_t b = 1;
+    EXPECT_EQ(f.read(size * 2 - 1, &b, 1), 1);
+    EXPECT_EQ(b, 0);
+    f.resize(10);
+    EXPECT_EQ(f.getSize(), 10);
+}
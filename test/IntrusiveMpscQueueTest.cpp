@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include <coco/InterruptQueue.hpp>
 #include <coco/IntrusiveMpscQueue.hpp>
+#include <coco/platform/WaitableMpscQueue.hpp>
 #include <semaphore>
 #include <thread>
+#include <type_traits>
 
 
 // test for InterruptQueue and IntrusiveMpscQueue
@@ -113,6 +115,60 @@ TEST(cocoTest, IntrusiveMpscQueue_MultiThreaded) {
 }
 
 
+TEST(cocoTest, WaitableMpscQueue) {
+    WaitableMpscQueue<Element> queue;
+    Element e1, e2;
+
+    // timeout when empty
+    EXPECT_EQ(queue.wait(10ms), nullptr);
+
+    queue.push(e1);
+    queue.push(e2);
+    EXPECT_EQ(queue.wait(), &e1);
+    EXPECT_EQ(queue.wait(10ms), &e2);
+    EXPECT_EQ(queue.pop(), nullptr);
+
+    // pushing via the base class would not wake up the consumer
+    static_assert(!std::is_convertible_v<WaitableMpscQueue<Element> &, IntrusiveMpscQueue<Element> &>);
+}
+
+TEST(cocoTest, WaitableMpscQueue_MultiThreaded) {
+    WaitableMpscQueue<Element> queue;
+    Element e1, e2;
+    std::atomic<int> finishCount = 0;
+
+    // producers wait for the consumer so that the consumer often finds the queue empty and has to park
+    auto producer = [&queue, &finishCount](Element &e) {
+        for (int i = 0; i < COUNT; ++i) {
+            queue.push(e);
+            e.s.acquire();
+        }
+        ++finishCount;
+    };
+    std::thread t1(producer, std::ref(e1));
+    std::thread t2(producer, std::ref(e2));
+
+    // single consumer that blocks while the queue is empty
+    int c1 = 0, c2 = 0;
+    for (int i = 0; i < 2 * COUNT; ++i) {
+        auto e = queue.wait(5000ms);
+        ASSERT_NE(e, nullptr);
+        if (e == &e1)
+            ++c1;
+        else if (e == &e2)
+            ++c2;
+        e->s.release();
+    }
+
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(finishCount, 2);
+    EXPECT_EQ(c1, COUNT);
+    EXPECT_EQ(c2, COUNT);
+    EXPECT_EQ(queue.pop(), nullptr);
+}
+
 
 // InterruptQueue
 
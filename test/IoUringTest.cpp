@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <coco/platform/File.hpp>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+
+using namespace coco;
+
+// test for IoUring and File::readAsync()/writeAsync() with both backends
+
+class IoUringTest : public testing::TestWithParam<IoUring::Backend> {
+};
+
+// write a block, then read it back
+Coroutine ioWriteRead(IoUring &ring, File &file, int64_t offset, int length, int &result) {
+    std::vector<uint8_t> data(length);
+    for (int i = 0; i < length; ++i)
+        data[i] = uint8_t(offset + i);
+    int written = co_await file.writeAsync(ring, offset, data.data(), length);
+    std::vector<uint8_t> check(length);
+    int read = co_await file.readAsync(ring, offset, check.data(), length);
+    result = written == length && read == length && check == data ? length : -1;
+}
+
+Coroutine ioRead(IoUring &ring, int file, void *data, int length, int &result) {
+    result = co_await ring.read(file, 0, data, length);
+}
+
+TEST_P(IoUringTest, WriteRead) {
+    // small ring so that operations have to wait in the queue
+    IoUring ring(8, GetParam());
+    ASSERT_TRUE(ring.isValid());
+    File file(fs::temp_directory_path() / "cocoIoUringTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+
+    const int count = 100;
+    std::vector<int> results(count, 0);
+    for (int i = 0; i < count; ++i)
+        ioWriteRead(ring, file, i * 1000, 1000, results[i]);
+    EXPECT_TRUE(ring.busy());
+    while (ring.busy())
+        ring.wait();
+    for (int i = 0; i < count; ++i)
+        EXPECT_EQ(results[i], 1000);
+    EXPECT_EQ(file.getSize(), count * 1000);
+
+    // error code
+    int result = 0;
+    char buffer[10];
+    ioRead(ring, -1, buffer, sizeof(buffer), result);
+    while (ring.busy())
+        ring.wait();
+    EXPECT_EQ(result, -EBADF);
+}
+
+TEST_P(IoUringTest, Fixed) {
+    IoUring ring(8, GetParam());
+    File file(fs::temp_directory_path() / "cocoIoUringFixedTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+    file.resize(65536, 0x55);
+
+    // fixed file and buffer are only available with io_uring
+    static uint8_t buffer[65536];
+    Array<uint8_t> buffers[] = {buffer};
+    bool uring = GetParam() == IoUring::Backend::URING;
+    EXPECT_EQ(file.registerFile(ring), uring);
+    EXPECT_EQ(ring.registerBuffers(buffers), uring);
+
+    int result = 0;
+    ioWriteRead(ring, file, 1000, 1000, result);
+    auto a = file.readAsync(ring, 0, buffer, sizeof(buffer));
+    while (ring.busy())
+        ring.wait();
+    EXPECT_TRUE(a.hasFinished());
+    EXPECT_EQ(a.result(), 65536);
+    EXPECT_EQ(buffer[0], 0x55);
+    EXPECT_EQ(buffer[1000], uint8_t(1000));
+    EXPECT_EQ(result, 1000);
+
+    file.unregisterFile(ring);
+    ring.registerBuffers({});
+}
+
+TEST_P(IoUringTest, Destroy) {
+    IoUring ring(8, GetParam());
+    File file(fs::temp_directory_path() / "cocoIoUringDestroyTest.bin", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
+    file.resize(4096, 0xff);
+
+    // destroy the waiting awaitables after submission, the completions get ignored
+    static uint8_t buffer[4][4096];
+    {
+        auto a = file.readAsync(ring, 0, buffer[0], 4096);
+        auto b = file.readAsync(ring, 0, buffer[1], 4096);
+        ring.submit();
+        auto c = file.readAsync(ring, 0, buffer[2], 4096);
+    }
+    auto d = file.readAsync(ring, 0, buffer[3], 4096);
+    while (ring.busy())
+        ring.wait();
+    EXPECT_EQ(d.result(), 4096);
+    EXPECT_EQ(buffer[3][4095], 0xff);
+}
+
+INSTANTIATE_TEST_SUITE_P(cocoTest, IoUringTest, testing::Values(IoUring::Backend::URING, IoUring::Backend::THREADS));
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <coco/convert.hpp>
+#include <coco/debug.hpp>
+#include <coco/LogBuffer.hpp>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#define fileno _fileno
+#else
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+// test for LogBuffer and the asynchronous debug output
+
+using namespace coco;
+
+
+TEST(cocoTest, LogBuffer_SingleThreaded) {
+    LogBuffer<16> buffer;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(buffer.read().empty());
+
+    EXPECT_TRUE(buffer.write("0123456789"));
+    EXPECT_EQ(buffer.size(), 10);
+    EXPECT_EQ(buffer.read(), "0123456789");
+    buffer.consume(8);
+    EXPECT_EQ(buffer.read(), "89");
+
+    // message wraps around
+    EXPECT_TRUE(buffer.write("abcdefghij"));
+    EXPECT_EQ(buffer.size(), 12);
+    EXPECT_EQ(buffer.read(), "89abcdef");
+    buffer.consume(8);
+    EXPECT_EQ(buffer.read(), "ghij");
+
+    // message that does not fit gets dropped as a whole
+    EXPECT_FALSE(buffer.write("0123456789abcd"));
+    EXPECT_EQ(buffer.droppedCount(), 1);
+    EXPECT_TRUE(buffer.write("0123456789ab"));
+    EXPECT_EQ(buffer.size(), 16);
+    EXPECT_FALSE(buffer.write("x"));
+    EXPECT_EQ(buffer.droppedCount(), 2);
+    buffer.consume(4);
+    EXPECT_EQ(buffer.read(), "0123456789ab");
+}
+
+TEST(cocoTest, LogBuffer_MultiThreaded) {
+    LogBuffer<256> buffer;
+    const int count = 100000;
+
+    // producer writes numbered messages
+    std::thread producer([&buffer] {
+        for (int i = 0; i < count; ++i) {
+            auto message = dec(i, 8);
+            while (!buffer.write(message))
+                std::this_thread::yield();
+        }
+    });
+
+    // consumer checks that all messages arrive in order and are not torn
+    std::string received;
+    int next = 0;
+    while (next < count) {
+        String data = buffer.read();
+        if (data.empty())
+            std::this_thread::yield();
+        received.append(data.data(), data.size());
+        buffer.consume(data.size());
+        while (received.size() >= 8) {
+            ASSERT_EQ(received.substr(0, 8), std::string(String(dec(next, 8))));
+            received.erase(0, 8);
+            ++next;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(cocoTest, debug_write) {
+    // redirect stdout to a temporary file
+    debug::flush();
+    std::fflush(stdout);
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    int savedStdout = dup(1);
+    dup2(fileno(file), 1);
+
+    // write from multiple threads
+    const int threadCount = 4;
+    const int lineCount = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < lineCount; ++i)
+                debug::out << "thread " << dec(t) << " line " << dec(i) << '\n';
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    debug::flush();
+    std::fflush(stdout);
+    dup2(savedStdout, 1);
+    close(savedStdout);
+
+    // lines must not get mixed up and the lines of each thread must be in order
+    std::rewind(file);
+    char line[64];
+    int next[threadCount] = {};
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        int t = -1;
+        int i = -1;
+        char end = 0;
+        ASSERT_EQ(std::sscanf(line, "thread %d line %d%c", &t, &i, &end), 3) << line;
+        ASSERT_EQ(end, '\n') << line;
+        ASSERT_TRUE(t >= 0 && t < threadCount) << line;
+        EXPECT_EQ(i, next[t]) << line;
+        next[t] = i + 1;
+    }
+    std::fclose(file);
+    for (int t = 0; t < threadCount; ++t)
+        EXPECT_EQ(next[t], lineCount);
+}
+
+#ifndef _WIN32
+TEST(cocoTest, debug_fork) {
+    // start the background thread in the parent
+    debug::out << "parent\n";
+    debug::flush();
+    std::fflush(stdout);
+
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    int savedStdout = dup(1);
+    dup2(fileno(file), 1);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // child: kill it if it hangs
+        alarm(10);
+
+        // the output must get written while the child runs
+        debug::out << "child\n";
+        int result = 1;
+        for (int i = 0; i < 1000 && result != 0; ++i) {
+            struct stat st;
+            if (fstat(1, &st) == 0 && st.st_size > 0)
+                result = 0;
+            else
+                debug::sleep(1ms);
+        }
+
+        // exit normally, the destructor of the logger must not wait for the background thread of the parent
+        std::exit(result);
+    }
+    dup2(savedStdout, 1);
+    close(savedStdout);
+    ASSERT_GT(pid, 0);
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status)) << status;
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    std::rewind(file);
+    char line[64] = {};
+    EXPECT_NE(std::fgets(line, sizeof(line), file), nullptr);
+    EXPECT_STREQ(line, "child\n");
+    std::fclose(file);
+
+    // the parent still writes
+    debug::out << "parent\n";
+    debug::flush();
+}
+#endif
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <coco/ObjectPool.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+using namespace coco;
+
+// test for ObjectPool
+
+struct PoolObject {
+    PoolObject(int value) : value(value) {++count;}
+    ~PoolObject() {--count;}
+
+    int value;
+    static inline int count = 0;
+};
+
+TEST(cocoTest, ObjectPool) {
+    ObjectPool<PoolObject, 3> pool;
+    EXPECT_EQ(pool.capacity(), 3);
+    EXPECT_EQ(pool.size(), 0);
+
+    // create until exhausted
+    auto a = pool.create(1);
+    auto b = pool.create(2);
+    auto c = pool.create(3);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    EXPECT_NE(a, b);
+    EXPECT_NE(b, c);
+    EXPECT_EQ(PoolObject::count, 3);
+    EXPECT_EQ(b->value, 2);
+    EXPECT_EQ(pool.create(4), nullptr);
+    EXPECT_EQ(pool.failedCount(), 1u);
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_TRUE(pool.contains(b));
+    int other;
+    EXPECT_FALSE(pool.contains(&other));
+
+    // destroy and reuse
+    pool.destroy(b);
+    EXPECT_EQ(PoolObject::count, 2);
+    EXPECT_EQ(pool.size(), 2);
+    auto d = pool.create(5);
+    EXPECT_EQ(d, b);
+    EXPECT_EQ(d->value, 5);
+
+    pool.destroy(a);
+    pool.destroy(c);
+    pool.destroy(d);
+    pool.destroy(nullptr);
+    EXPECT_EQ(PoolObject::count, 0);
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(pool.highWaterMark(), 3);
+
+    // raw storage
+    void *storage = pool.allocate();
+    EXPECT_TRUE(pool.contains(storage));
+    pool.release(storage);
+    EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(cocoTest, ObjectPool_MultiThreaded) {
+    // fewer objects than the threads want to hold so that the pool gets exhausted from time to time
+    ObjectPool<std::atomic<int>, 8> pool;
+    std::atomic<int> errors = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t <= 4; ++t) {
+        threads.emplace_back([&pool, &errors, t] {
+            std::atomic<int> *objects[3] = {};
+            for (int i = 0; i < 100000; ++i) {
+                auto &object = objects[i % 3];
+                if (object != nullptr) {
+                    // check that no other thread got the same object in the meantime
+                    if (object->load() != t)
+                        ++errors;
+                    pool.destroy(object);
+                }
+                object = pool.create(t);
+            }
+            for (auto object : objects)
+                pool.destroy(object);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_LE(pool.highWaterMark(), 8);
+
+    // all objects are available again
+    void *objects[8];
+    for (auto &object : objects) {
+        object = pool.allocate();
+        EXPECT_NE(object, nullptr);
+    }
+    EXPECT_EQ(pool.allocate(), nullptr);
+    for (auto object : objects)
+        pool.release(object);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <coco/SeqLock.hpp>
+#include <coco/Vector4.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+using namespace coco;
+
+// test for SeqLock
+
+TEST(cocoTest, SeqLock) {
+    SeqLock<Vector4<float>> pose({1.0f, 2.0f, 3.0f, 4.0f});
+    EXPECT_EQ(pose.read().z, 3.0f);
+    EXPECT_EQ(pose.getSequence(), 0u);
+
+    pose.write({5.0f, 6.0f, 7.0f, 8.0f});
+    EXPECT_EQ(pose.getSequence(), 2u);
+    Vector4<float> p;
+    EXPECT_TRUE(pose.tryRead(p));
+    EXPECT_EQ(p.w, 8.0f);
+
+    // size that is not a multiple of 4
+    struct Text {char s[7];};
+    SeqLock<Text> text;
+    text.write({{'a', 'b', 'c', 'd', 'e', 'f', 0}});
+    EXPECT_STREQ(text.read().s, "abcdef");
+}
+
+// state that is torn if not all words have the same value, large so that the writer often gets preempted while copying
+struct Table {
+    uint32_t values[1024];
+};
+
+TEST(cocoTest, SeqLock_MultiThreaded) {
+    SeqLock<Table> lock;
+    const uint32_t count = 5000;
+    std::atomic<bool> done = false;
+
+    // one writer
+    std::thread writer([&lock, &done] {
+        Table table;
+        for (uint32_t i = 1; i <= count; ++i) {
+            for (auto &value : table.values)
+                value = i;
+            lock.write(table);
+        }
+        done = true;
+    });
+
+    // multiple readers check for torn reads and that values never go back in time
+    std::atomic<int> torn = 0;
+    std::atomic<int> reads = 0;
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&lock, &done, &torn, &reads] {
+            uint32_t last = 0;
+            while (!done) {
+                Table table = lock.read();
+                uint32_t value = table.values[0];
+                for (auto v : table.values) {
+                    if (v != value)
+                        ++torn;
+                }
+                if (value < last)
+                    ++torn;
+                last = value;
+                ++reads;
+            }
+        });
+    }
+    writer.join();
+    for (auto &reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(lock.read().values[1023], count);
+    EXPECT_EQ(lock.getSequence(), 2 * count);
+}
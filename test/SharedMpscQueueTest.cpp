@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <coco/platform/SharedMemory.hpp>
+#include <coco/platform/SharedMpscQueue.hpp>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+
+using namespace coco;
+
+// test for SharedMpscQueue in SharedMemory across threads and processes
+
+struct SharedMessage : public SharedMpscQueueNode {
+    int producer;
+    int value;
+};
+
+// layout of the shared memory
+struct SharedLayout {
+    // messages from producers to the consumer
+    SharedMpscQueue<SharedMessage> queue;
+
+    // free messages of each producer, returned by the consumer
+    SharedMpscQueue<SharedMessage> free[3];
+
+    SharedMessage messages[3][4];
+};
+
+constexpr int SHARED_COUNT = 10000;
+
+// produce messages, uses only the shared memory so that it can run in a child process
+void produce(SharedLayout &layout, int producer) {
+    for (int i = 0; i < SHARED_COUNT; ++i) {
+        SharedMessage *message;
+        while ((message = layout.free[producer].pop()) == nullptr)
+            std::this_thread::yield();
+        message->producer = producer;
+        message->value = i;
+        layout.queue.push(*message);
+    }
+}
+
+TEST(cocoTest, SharedMpscQueue_SingleThreaded) {
+    SharedMemory memory("test", sizeof(SharedLayout));
+    ASSERT_TRUE(memory.isValid());
+    auto &layout = memory.construct<SharedLayout>(0);
+
+    // queue is initially empty
+    EXPECT_EQ(layout.queue.pop(), nullptr);
+    EXPECT_EQ(layout.queue.wait(10ms), nullptr);
+
+    // push some elements
+    auto &m1 = layout.messages[0][0];
+    auto &m2 = layout.messages[0][1];
+    layout.queue.push(m1);
+    layout.queue.push(m2);
+    EXPECT_EQ(layout.queue.pop(), &m1);
+    EXPECT_EQ(layout.queue.wait(), &m2);
+    EXPECT_EQ(layout.queue.pop(), nullptr);
+
+    // map a second time at a different address and push there
+    SharedMemory memory2(dup(memory.getFd()));
+    ASSERT_TRUE(memory2.isValid());
+    ASSERT_NE(memory2.data(), memory.data());
+    auto &layout2 = memory2.at<SharedLayout>(0);
+    layout2.queue.push(layout2.messages[1][2]);
+    EXPECT_EQ(layout.queue.pop(), &layout.messages[1][2]);
+}
+
+TEST(cocoTest, SharedMpscQueue_MultiProcess) {
+    SharedMemory memory("test", sizeof(SharedLayout));
+    ASSERT_TRUE(memory.isValid());
+    auto &layout = memory.construct<SharedLayout>(0);
+    for (int p = 0; p < 3; ++p) {
+        for (auto &message : layout.messages[p])
+            layout.free[p].push(message);
+    }
+
+    // two producer processes and one producer thread
+    pid_t pids[2];
+    for (int p = 0; p < 2; ++p) {
+        pids[p] = fork();
+        ASSERT_NE(pids[p], -1);
+        if (pids[p] == 0) {
+            produce(layout, p);
+            _exit(0);
+        }
+    }
+    std::thread thread([&layout] {produce(layout, 2);});
+
+    // consumer, blocks in wait() when the queue is empty
+    int next[3] = {};
+    for (int i = 0; i < 3 * SHARED_COUNT; ++i) {
+        auto message = layout.queue.wait(5000ms);
+        ASSERT_NE(message, nullptr);
+
+        // messages of each producer arrive in order
+        EXPECT_EQ(message->value, next[message->producer]);
+        ++next[message->producer];
+        layout.free[message->producer].push(*message);
+    }
+    EXPECT_EQ(layout.queue.pop(), nullptr);
+
+    thread.join();
+    for (auto pid : pids) {
+        int status;
+        waitpid(pid, &status, 0);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <coco/platform/Socket.hpp>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <string>
+#include <unistd.h>
+
+
+using namespace coco;
+
+// test for Socket on loopback and Unix domain sockets
+
+Coroutine socketEchoServer(Socket &server, int &result) {
+    Socket client(server.getLoop());
+    result = co_await server.accept(client);
+    uint8_t buffer[100];
+    int n;
+    while ((n = co_await client.recv(buffer, sizeof(buffer))) > 0)
+        co_await client.send(buffer, n);
+}
+
+Coroutine socketEchoClient(Socket &socket, const Socket::Address &address, std::string &log) {
+    int result = co_await socket.connect(address);
+    if (result != 0) {
+        log = "error " + std::to_string(result);
+        co_return;
+    }
+
+    // send with gather
+    const uint8_t foo[] = {'f', 'o', 'o'};
+    const uint8_t bar[] = {'b', 'a', 'r'};
+    Array<const uint8_t> buffers[] = {foo, bar};
+    co_await socket.send(buffers);
+
+    // receive with scatter until all data is there
+    uint8_t a[2];
+    uint8_t b[10];
+    Array<uint8_t> receiveBuffers[] = {a, b};
+    int n = co_await socket.recv(receiveBuffers);
+    log.append(reinterpret_cast<char *>(a), std::min(n, 2));
+    if (n > 2)
+        log.append(reinterpret_cast<char *>(b), n - 2);
+    while (log.size() < 6) {
+        n = co_await socket.recv(b, sizeof(b));
+        if (n <= 0)
+            break;
+        log.append(reinterpret_cast<char *>(b), n);
+    }
+    socket.close();
+}
+
+void testEcho(int domain, const Socket::Address &address) {
+    EventLoop loop;
+    Socket server(loop, domain, SOCK_STREAM);
+    ASSERT_EQ(server.bind(address), 0);
+    ASSERT_EQ(server.listen(), 0);
+
+    int serverResult = 1;
+    std::string log;
+    Socket client(loop, domain, SOCK_STREAM);
+    auto serverAddress = server.getAddress();
+    socketEchoServer(server, serverResult);
+    socketEchoClient(client, domain == AF_UNIX ? address : serverAddress, log);
+    for (int i = 0; i < 100 && log.size() < 6; ++i)
+        loop.runOnce();
+    EXPECT_EQ(serverResult, 0);
+    EXPECT_EQ(log, "foobar");
+
+    // the server sees the end of the stream
+    loop.runOnce(false);
+}
+
+TEST(cocoTest, SocketTcp) {
+    testEcho(AF_INET, Socket::Address::inet("127.0.0.1", 0));
+}
+
+TEST(cocoTest, SocketUnix) {
+    testEcho(AF_UNIX, Socket::Address::local("@cocoSocketTest" + std::to_string(getpid())));
+}
+
+TEST(cocoTest, SocketAddress) {
+    EXPECT_EQ(Socket::Address::inet("127.0.0.1", 80).getPort(), 80);
+    EXPECT_EQ(Socket::Address::inet("::1", 443).getFamily(), AF_INET6);
+    EXPECT_TRUE(Socket::Address::inet("foo", 80).empty());
+    EXPECT_EQ(Socket::Address::local("/tmp/foo").getFamily(), AF_UNIX);
+}
+
+TEST(cocoTest, SocketConnectRefused) {
+    EventLoop loop;
+
+    // get a free port
+    int port;
+    {
+        Socket socket(loop, AF_INET, SOCK_STREAM);
+        socket.bind(Socket::Address::inet("127.0.0.1", 0));
+        port = socket.getAddress().getPort();
+    }
+
+    Socket socket(loop, AF_INET, SOCK_STREAM);
+    std::string log;
+    auto address = Socket::Address::inet("127.0.0.1", port);
+    socketEchoClient(socket, address, log);
+    for (int i = 0; i < 100 && log.empty(); ++i)
+        loop.runOnce();
+    EXPECT_EQ(log, "error " + std::to_string(-ECONNREFUSED));
+}
+
+Coroutine socketVectorSender(Socket &socket, Array<const Array<const uint8_t>> buffers, int &result) {
+    result = co_await socket.send(buffers);
+}
+
+Coroutine socketVectorReceiver(Socket &socket, Array<const Array<uint8_t>> buffers, int &result) {
+    result = co_await socket.recv(buffers);
+}
+
+TEST(cocoTest, SocketVector) {
+    EventLoop loop;
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds), 0);
+    Socket a(loop, fds[0]);
+    Socket b(loop, fds[1]);
+
+    // more buffers than fit into one system call
+    const int count = Socket::MAX_VECTOR_COUNT * 2 + 5;
+    uint8_t data[count];
+    Array<const uint8_t> sendBuffers[count];
+    uint8_t received[count] = {};
+    Array<uint8_t> receiveBuffers[count];
+    for (int i = 0; i < count; ++i) {
+        data[i] = uint8_t(i + 1);
+        sendBuffers[i] = {&data[i], 1};
+        receiveBuffers[i] = {&received[i], 1};
+    }
+
+    int sent = 0;
+    socketVectorSender(a, sendBuffers, sent);
+    EXPECT_EQ(sent, count);
+    int receivedCount = 0;
+    socketVectorReceiver(b, receiveBuffers, receivedCount);
+    for (int i = 0; i < 100 && receivedCount == 0; ++i)
+        loop.runOnce(false);
+    EXPECT_EQ(receivedCount, count);
+    for (int i = 0; i < count; ++i)
+        EXPECT_EQ(received[i], uint8_t(i + 1));
+}
+
+Coroutine socketUdpReceiver(Socket &socket, Array<Socket::Datagram> datagrams, int &count) {
+    while (count < datagrams.size()) {
+        int n = co_await socket.recvBatch(datagrams.subarray(count));
+        if (n <= 0)
+            break;
+        count += n;
+    }
+}
+
+TEST(cocoTest, SocketUdpBatch) {
+    EventLoop loop;
+    Socket receiver(loop, AF_INET, SOCK_DGRAM);
+    ASSERT_EQ(receiver.bind(Socket::Address::inet("127.0.0.1", 0)), 0);
+    auto address = receiver.getAddress();
+
+    // receive
+    const int count = 100;
+    static uint8_t buffers[count][16];
+    Socket::Datagram received[count];
+    for (int i = 0; i < count; ++i)
+        received[i].buffer = buffers[i];
+    int receivedCount = 0;
+    socketUdpReceiver(receiver, received, receivedCount);
+
+    // send, the receiver waits
+    loop.runOnce(false);
+    static uint8_t data[count];
+    Socket::Datagram sent[count];
+    for (int i = 0; i < count; ++i) {
+        data[i] = uint8_t(i);
+        sent[i].buffer = {&data[i], 1};
+        sent[i].address = address;
+    }
+    Socket sender(loop, AF_INET, SOCK_DGRAM);
+    auto a = sender.sendBatch(sent);
+    EXPECT_TRUE(a.hasFinished());
+    EXPECT_EQ(a.result(), count);
+
+    for (int i = 0; i < 10 && receivedCount < count; ++i)
+        loop.runOnce();
+    ASSERT_EQ(receivedCount, count);
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(received[i].length, 1);
+        EXPECT_EQ(received[i].buffer[0], i);
+        EXPECT_EQ(received[i].address.getPort(), sender.getAddress().getPort());
+    }
+
+    // single datagram
+    uint8_t ch = 'x';
+    auto b = sender.sendTo(&ch, 1, address);
+    EXPECT_EQ(b.result(), 1);
+    Socket::Address from;
+    auto c = receiver.recvFrom(&ch, 1, from);
+    EXPECT_EQ(c.result(), 1);
+
+    // closing resumes waiting operations
+    auto d = receiver.recvFrom(&ch, 1, from);
+    EXPECT_FALSE(d.hasFinished());
+    receiver.close();
+    EXPECT_TRUE(d.hasFinished());
+    EXPECT_EQ(d.result(), -ECANCELED);
+}
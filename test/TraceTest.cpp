@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <coco/Coroutine.hpp>
+#include <coco/traceWrite.hpp>
+#include <string>
+#include <vector>
+
+
+using namespace coco;
+
+// recording needs the project configured with -DCOCO_TRACE=ON
+
+// stream that appends to a string
+struct TraceStream {
+    TraceStream &operator <<(const String &str) {
+        this->data.append(str.data(), str.size());
+        return *this;
+    }
+
+    std::string data;
+};
+
+CoroutineTaskList<> traceList1;
+CoroutineTaskList<> traceList2;
+
+Coroutine traceCoroutine() {
+    co_await Awaitable<>(traceList1);
+    trace::Span span("work");
+    co_await Awaitable<>(traceList2);
+}
+
+std::vector<trace::EventType> traceTypes() {
+    std::vector<trace::EventType> types;
+    trace::visitAll([&types](const trace::Event &event) {types.push_back(event.type);});
+    return types;
+}
+
+TEST(cocoTest, trace) {
+#ifndef COCO_TRACE
+    GTEST_SKIP() << "configure with -DCOCO_TRACE=ON";
+#endif
+    using Type = trace::EventType;
+    trace::clear();
+
+    // coroutine waits on the first list, gets resumed and waits on the second list
+    traceCoroutine();
+    trace::begin("loop \"1\"");
+    traceList1.doAll();
+    trace::end();
+    traceList2.doAll();
+    trace::instant("done");
+    EXPECT_EQ(traceTypes(), (std::vector<Type>{Type::ADD, Type::SUSPEND, Type::BEGIN, Type::RESUME, Type::BEGIN,
+        Type::ADD, Type::SUSPEND, Type::END, Type::END, Type::RESUME, Type::END, Type::END, Type::INSTANT}));
+
+    // timestamps are increasing and the coroutine has the same id in all events
+    uint32_t time = 0;
+    const void *id = nullptr;
+    trace::visitAll([&time, &id](const trace::Event &event) {
+        EXPECT_GE(event.time, time);
+        time = event.time;
+        if (event.type == Type::SUSPEND || event.type == Type::RESUME) {
+            if (id == nullptr)
+                id = event.data;
+            EXPECT_EQ(event.data, id);
+        }
+    });
+
+    // Chrome trace JSON
+    TraceStream json;
+    trace::writeJson(json);
+    EXPECT_EQ(json.data.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{\"ph\":\"i\""), 0);
+    EXPECT_NE(json.data.find("\"name\":\"loop \\\"1\\\"\""), std::string::npos);
+    EXPECT_NE(json.data.find(",\"name\":\"work\""), std::string::npos);
+    EXPECT_NE(json.data.find(",\"name\":\"resume 0x"), std::string::npos);
+    EXPECT_NE(json.data.find(",\"s\":\"t\",\"name\":\"done\"}\n]}\n"), std::string::npos);
+
+    // binary: header and events
+    TraceStream binary;
+    trace::writeBinary(binary);
+    EXPECT_EQ(binary.data.size(), sizeof(trace::detail::BinaryHeader) + 13 * trace::detail::BINARY_EVENT_SIZE);
+    EXPECT_EQ(binary.data.substr(0, 4), "CTRC");
+
+    // ring buffer keeps the newest events
+    trace::clear();
+    for (int i = 0; i < COCO_TRACE_SIZE + 10; ++i)
+        trace::instant(i < COCO_TRACE_SIZE ? "old" : "new");
+    EXPECT_EQ(trace::size(), COCO_TRACE_SIZE);
+    int count = 0;
+    trace::visitAll([&count](const trace::Event &event) {
+        bool isNew = String(static_cast<const char *>(event.data)) == "new";
+        EXPECT_EQ(isNew, count >= COCO_TRACE_SIZE - 10);
+        ++count;
+    });
+    EXPECT_EQ(count, COCO_TRACE_SIZE);
+    trace::clear();
+}
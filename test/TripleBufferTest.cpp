@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <coco/TripleBuffer.hpp>
+#include <coco/Vector3.hpp>
+#include <atomic>
+#include <thread>
+
+
+using namespace coco;
+
+// test for TripleBuffer
+
+Coroutine readSamples(TripleBuffer<Vector3<int16_t>> &buffer, int &count, int &sum) {
+    while (true) {
+        co_await buffer.untilUpdated();
+        auto &sample = buffer.read();
+        ++count;
+        sum += sample.x;
+    }
+}
+
+TEST(cocoTest, TripleBuffer) {
+    TripleBuffer<Vector3<int16_t>> buffer({1, 2, 3});
+    EXPECT_FALSE(buffer.updated());
+    EXPECT_EQ(buffer.read().y, 2);
+
+    // only the newest value gets read
+    buffer.write({4, 5, 6});
+    buffer.write({7, 8, 9});
+    EXPECT_TRUE(buffer.updated());
+    EXPECT_EQ(buffer.read().z, 9);
+    EXPECT_FALSE(buffer.updated());
+    EXPECT_EQ(buffer.read().z, 9);
+
+    // coroutine waits for new values
+    int count = 0;
+    int sum = 0;
+    auto c = readSamples(buffer, count, sum);
+    EXPECT_EQ(count, 0);
+    buffer.update({10, 0, 0});
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(sum, 10);
+
+    // write from an "interrupt", the coroutine gets resumed by check()
+    buffer.write({20, 0, 0});
+    buffer.write({30, 0, 0});
+    EXPECT_EQ(count, 1);
+    buffer.check();
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(sum, 40);
+    buffer.check();
+    EXPECT_EQ(count, 2);
+
+    c.destroy();
+}
+
+// value that is torn if not all words have the same value, large so that the writer often gets preempted while copying
+struct Sample {
+    uint32_t values[256];
+};
+
+TEST(cocoTest, TripleBuffer_MultiThreaded) {
+    TripleBuffer<Sample> buffer;
+    const uint32_t count = 100000;
+    std::atomic<bool> done = false;
+
+    std::thread writer([&buffer, &done] {
+        Sample sample;
+        for (uint32_t i = 1; i <= count; ++i) {
+            for (auto &value : sample.values)
+                value = i;
+            buffer.write(sample);
+        }
+        done = true;
+    });
+
+    // reader checks for torn reads and that values never go back in time
+    int torn = 0;
+    uint32_t last = 0;
+    while (true) {
+        bool finished = done;
+        auto &sample = buffer.read();
+        uint32_t value = sample.values[0];
+        for (auto v : sample.values) {
+            if (v != value)
+                ++torn;
+        }
+        EXPECT_GE(value, last);
+        last = value;
+        if (finished && !buffer.updated())
+            break;
+    }
+    writer.join();
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(last, count);
+}
@@ -4,15 +4,21 @@
 #include <coco/Array.hpp>
 #include <coco/ArrayBuffer.hpp>
 #include <coco/ArrayConcept.hpp>
+#include <coco/binlog.hpp>
 #include <coco/bits.hpp>
+#include <coco/Bitset.hpp>
 #include <coco/ContainerConcept.hpp>
 #include <coco/convert.hpp>
 #include <coco/CStringConcept.hpp>
 #include <coco/enum.hpp>
+#include <coco/format.hpp>
 #include <coco/Frequency.hpp>
+#include <coco/hash.hpp>
 #include <coco/IsSubclass.hpp>
 #include <coco/IntrusiveList.hpp>
 #include <coco/IntrusiveQueue.hpp>
+#include <coco/IntrusiveTree.hpp>
+#include <coco/PerfectHash.hpp>
 #include <coco/Queue.hpp>
 #include <coco/PointerConcept.hpp>
 #include <coco/PseudoRandom.hpp>
@@ -22,7 +28,10 @@
 #include <coco/StringConcept.hpp>
 #include <coco/Time.hpp>
 #include <coco/Vector2.hpp>
-//#include <coco/platform/File.hpp>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
 #include <vector>
 #include <string>
 #include <list>
@@ -458,6 +467,111 @@ TEST(cocoTest, ArrayConceptChar) {
 }
 
 
+// binlog
+// ------
+
+// decode all records of a binary log into text
+std::string decodeBinlog(const std::string &data) {
+    std::string text;
+    String rest(data);
+    char buffer[256];
+    while (auto result = binlog::decode(binlog::section(), rest, buffer, sizeof(buffer))) {
+        text.append(buffer, result.value);
+        rest = rest.substring(result.length);
+    }
+    EXPECT_TRUE(rest.empty());
+    return text;
+}
+
+enum class BinlogEnum : int16_t {
+    VALUE = 16
+};
+
+TEST(cocoTest, binlog) {
+    std::string data;
+    auto write = [&data](const char *d, int length) {data.append(d, length);};
+
+    // same output as format()
+    COCO_BINLOG_TO(write, "x={} y={:04x} z={:5}|\n", 42, 0xbeefu, -17);
+    COCO_BINLOG_TO(write, "{:05}|{:x}|{:08x}|{}|{}\n", -42, int8_t(-1), 0xabc, INT_MIN, UINT64_C(18446744073709551615));
+    COCO_BINLOG_TO(write, "{}{}{}{}\n", int8_t(-5), uint16_t(65535), int64_t(-1), BinlogEnum::VALUE);
+    COCO_BINLOG_TO(write, "{} {:.2} {:8.1f}|{:g} {:g}\n", 3.14159f, 2.5, -1.25f, 0.1, 1e21f);
+    std::string str = "bar";
+    COCO_BINLOG_TO(write, "{{{}}} {:5} {} {}{:c}\n", "foo", str, String("baz"), 'x', '!');
+    COCO_BINLOG_TO(write, "no arguments\n");
+    COCO_BINLOG_TIMED_TO(write, 123456, "timed {}\n", 1);
+    EXPECT_EQ(decodeBinlog(data),
+        "x=42 y=beef z=  -17|\n"
+        "-0042|ff|00000abc|-2147483648|18446744073709551615\n"
+        "-565535-116\n"
+        "3.142 2.50     -1.3|0.1 1e21\n"
+        "{foo}   bar baz x!\n"
+        "no arguments\n"
+        "[123456] timed 1\n");
+
+    // the record is much shorter than the text: length, id, 1 byte for 42
+    data.clear();
+    COCO_BINLOG_TO(write, "the value of the variable is {}\n", 42);
+    EXPECT_LE(data.size(), 5);
+    EXPECT_EQ(data[0], data.size() - 1);
+    EXPECT_EQ(decodeBinlog(data), "the value of the variable is 42\n");
+
+    // long strings are truncated
+    data.clear();
+    std::string longString(100, 'a');
+    COCO_BINLOG_TO(write, "{}", longString);
+    EXPECT_EQ(decodeBinlog(data), std::string(binlog::MAX_STRING_LENGTH, 'a'));
+
+    // incomplete record
+    char buffer[64];
+    auto result = binlog::decode(binlog::section(), String(data).substring(0, 10), buffer, sizeof(buffer));
+    EXPECT_FALSE(result);
+
+    // invalid id gets skipped, trailing garbage in a record
+    const char invalid[] = {2, char(0xfe), 0x7f, 2, 0, 0};
+    result = binlog::decode(binlog::section(), String(invalid, 3), buffer, sizeof(buffer));
+    EXPECT_EQ(result.value, 0);
+    EXPECT_EQ(result.length, 1);
+    data.clear();
+    COCO_BINLOG_TO(write, "{}", 'x');
+    data[0] += 1;
+    data += '\0';
+    result = binlog::decode(binlog::section(), data, buffer, sizeof(buffer));
+    EXPECT_EQ(String(buffer, result.value), "<invalid binlog record>\n");
+    EXPECT_EQ(result.length, data.size());
+
+    // corrupt lengths get skipped to resynchronize, also when the data arrives byte by byte as from a serial port
+    data.clear();
+    COCO_BINLOG_TO(write, "{}\n", 1);
+    std::string record = data;
+    data = std::string("\xff\xff\x7f") + record + "\x80" + record.substr(1) + record; // cut off length
+    std::string text;
+    auto append = [&text](const char *t, int length) {text.append(t, length);};
+    std::string received;
+    for (char ch : data) {
+        // same as the binlogDecode tool: each record gets decoded as soon as its last byte arrives
+        received += ch;
+        received.erase(0, binlog::decodeAll(binlog::section(), received, buffer, sizeof(buffer), append));
+    }
+    EXPECT_EQ(text, "1\n1\n");
+    EXPECT_TRUE(received.empty());
+
+    // at the end of a log file, records behind the start of an incomplete record get decoded (the garbage in between
+    // may decode as invalid record)
+    data.clear();
+    COCO_BINLOG_TO(write, "{}\n", longString);
+    std::string longRecord = data;
+    text.clear();
+    received = longRecord.substr(0, longRecord.size() / 2) + record;
+    int used = binlog::decodeAll(binlog::section(), received, buffer, sizeof(buffer), append);
+    EXPECT_TRUE(text.empty());
+    received.erase(0, used);
+    used = binlog::decodeAll(binlog::section(), received, buffer, sizeof(buffer), append, true);
+    EXPECT_TRUE(text.ends_with("1\n")) << text;
+    EXPECT_EQ(used, received.size());
+}
+
+
 // bits
 // ----
 
@@ -485,6 +599,12 @@ TEST(cocoTest, bits) {
 
     EXPECT_EQ(popcount(ExtractEnum::FOO_MASK), 4);
     EXPECT_EQ(popcountBefore(0x0a, 0x08), 1);
+    EXPECT_EQ(popcountBefore(0x0f, 0x01), 0);
+    EXPECT_EQ(popcountBefore(uint8_t(0xff), 0x80), 7);
+    EXPECT_EQ(popcountBefore(0xffffffffu, 0x80000000u), 31);
+    EXPECT_EQ(popcountBefore(UINT64_C(0xffffffffffffffff), UINT64_C(0x8000000000000000)), 63);
+    static_assert(popcountBefore(ExtractEnum::FOO_MASK, ExtractEnum::FOO_1) == 0);
+    static_assert(popcountBefore(0x0a, 0x08) == 1);
 }
 
 enum class PopcountBeforeEnum {
@@ -529,6 +649,100 @@ TEST(cocoTest, popcountBefore) {
 }
 
 
+// Bitset
+// ------
+
+constexpr Bitset<100> makeBitset() {
+    Bitset<100> b;
+    b.setRange(10, 70);
+    b.clear(20);
+    return b;
+}
+
+TEST(cocoTest, Bitset) {
+    // constexpr
+    constexpr auto c = makeBitset();
+    static_assert(c.count() == 59);
+    static_assert(c.findFirstSet() == 10);
+    static_assert(c.findNextClear(10) == 20);
+    static_assert(c.rank(30) == 19);
+    static_assert(c.select(19) == 30);
+
+    Bitset<100> b;
+    EXPECT_TRUE(b.none());
+    EXPECT_EQ(b.findFirstSet(), -1);
+    EXPECT_EQ(b.findFirstClear(), 0);
+
+    // single bits
+    b.set(3);
+    b.set(64);
+    b.set(99);
+    EXPECT_TRUE(b[3]);
+    EXPECT_FALSE(b[4]);
+    EXPECT_EQ(b.count(), 3);
+    EXPECT_EQ(b.findFirstSet(), 3);
+    EXPECT_EQ(b.findNextSet(4), 64);
+    EXPECT_EQ(b.findNextSet(65), 99);
+    EXPECT_EQ(b.findNextSet(100), -1);
+    b.flip(3);
+    EXPECT_EQ(b.findFirstSet(), 64);
+    b.set(64, false);
+    EXPECT_EQ(b.findFirstSet(), 99);
+
+    // ranges across word boundaries
+    b.clearAll();
+    b.setRange(30, 70);
+    EXPECT_EQ(b.count(), 40);
+    EXPECT_FALSE(b[29]);
+    EXPECT_TRUE(b[30]);
+    EXPECT_TRUE(b[69]);
+    EXPECT_FALSE(b[70]);
+    EXPECT_EQ(b.findNextClear(30), 70);
+    b.clearRange(31, 69);
+    EXPECT_EQ(b.count(), 2);
+    EXPECT_EQ(b.findNextSet(31), 69);
+    b.setRange(5, 5);
+    EXPECT_EQ(b.count(), 2);
+
+    // all, the bits after N must not be found
+    b.setAll();
+    EXPECT_TRUE(b.all());
+    EXPECT_EQ(b.count(), 100);
+    EXPECT_EQ(b.findFirstClear(), -1);
+    EXPECT_TRUE((~b).none());
+    b.clear(97);
+    EXPECT_FALSE(b.all());
+    EXPECT_EQ(b.findFirstClear(), 97);
+    EXPECT_EQ(b.findNextClear(98), -1);
+
+    // rank and select
+    Bitset<200> r;
+    for (int i = 0; i < 200; i += 3)
+        r.set(i);
+    for (int i = 0; i <= 200; ++i)
+        EXPECT_EQ(r.rank(i), (i + 2) / 3);
+    for (int k = 0; k < r.count(); ++k)
+        EXPECT_EQ(r.select(k), k * 3);
+    EXPECT_EQ(r.select(r.count()), -1);
+
+    // iterate over set bits
+    int count = 0;
+    for (int i = r.findFirstSet(); i != -1; i = r.findNextSet(i + 1)) {
+        EXPECT_EQ(i % 3, 0);
+        ++count;
+    }
+    EXPECT_EQ(count, r.count());
+
+    // operators
+    Bitset<200> a;
+    a.setRange(0, 100);
+    EXPECT_EQ((a & r).count(), r.rank(100));
+    EXPECT_EQ((a | r).count(), 100 + r.count() - r.rank(100));
+    EXPECT_EQ((a ^ a).count(), 0);
+    EXPECT_TRUE((a & r) == (r & a));
+}
+
+
 // ContainerConcept
 // ----------------
 
@@ -654,6 +868,302 @@ TEST(cocoTest, convert_dec) {
     EXPECT_EQ(dec<unsigned int>("1337"), ConvertedValue<unsigned int>(1337, 4));
 }
 
+TEST(cocoTest, convert_div10000) {
+    // the reciprocal is used on cores without hardware divider, check it against the division for all inputs
+    static_assert(detail::div10000Reciprocal(0xffffffff) == 0xffffffffu / 10000);
+    uint32_t value = 0;
+    int errors = 0;
+    do {
+        errors += detail::div10000Reciprocal(value) != value / 10000;
+    } while (++value != 0);
+    EXPECT_EQ(errors, 0);
+}
+
+// reference implementation that converts one digit at a time
+template <typename T>
+std::string decReference(T value, int digitCount) {
+    std::string str;
+    while (value > 0 || digitCount > 0) {
+        str.insert(str.begin(), char('0' + value % 10));
+        value /= 10;
+        --digitCount;
+    }
+    return str;
+}
+
+TEST(cocoTest, convert_dec_integer) {
+    char buffer[24];
+    char *end = std::end(buffer);
+    auto toString = [](const char *begin, const char *end) {return std::string(begin, end);};
+
+    // exhaustive for small values and all digit counts
+    for (uint32_t value = 0; value < 1000000; ++value) {
+        int digitCount = value % 13;
+        ASSERT_EQ(toString(detail::dec(end, value, digitCount), end), decReference(value, digitCount));
+    }
+
+    // powers of ten and their neighbours
+    uint64_t p = 1;
+    for (int i = 0; i <= 19; ++i, p *= 10) {
+        for (uint64_t value : {p - 1, p, p + 1}) {
+            if (value <= 0xffffffff) {
+                for (int digitCount = 0; digitCount <= 12; ++digitCount) {
+                    EXPECT_EQ(toString(detail::dec(end, uint32_t(value), digitCount), end),
+                        decReference(uint32_t(value), digitCount));
+                }
+            }
+            for (int digitCount = 0; digitCount <= 24; ++digitCount)
+                EXPECT_EQ(toString(detail::dec(end, value, digitCount), end), decReference(value, digitCount));
+        }
+    }
+    EXPECT_EQ(dec(UINT32_MAX), "4294967295");
+    EXPECT_EQ(dec(INT32_MIN + 1), "-2147483647");
+    EXPECT_EQ(dec(UINT64_MAX), "18446744073709551615");
+    EXPECT_EQ(dec(INT64_MIN + 1), "-9223372036854775807");
+    EXPECT_EQ(dec(0, 0), "");
+    EXPECT_EQ(dec(0), "0");
+    EXPECT_EQ(dec(UINT64_C(0), 0), "");
+    EXPECT_EQ(dec(UINT64_C(100000000), 12), "000100000000");
+
+    // random values of random bit length
+    XorShiftRandom random;
+    for (int i = 0; i < 50000; ++i) {
+        uint64_t value = (uint64_t(random.draw()) << 32 | random.draw()) >> (random.draw() % 64);
+        int digitCount = random.draw() % 25;
+        ASSERT_EQ(toString(detail::dec(end, value, digitCount), end), decReference(value, digitCount));
+        ASSERT_EQ(toString(detail::dec(end, uint32_t(value), digitCount % 13), end),
+            decReference(uint32_t(value), digitCount % 13));
+        ASSERT_EQ(dec(int64_t(value)), std::to_string(int64_t(value)));
+        ASSERT_EQ(dec(int32_t(value)), std::to_string(int32_t(value)));
+    }
+}
+
+// check that the shortest conversion converts back and has as many digits as std::to_chars
+template <typename T>
+void checkShortest(T value) {
+    std::string str(String(decShortest(value)));
+    T parsed;
+    if constexpr (sizeof(T) == 4)
+        parsed = std::strtof(str.c_str(), nullptr);
+    else
+        parsed = std::strtod(str.c_str(), nullptr);
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    ASSERT_EQ(std::bit_cast<Bits>(parsed), std::bit_cast<Bits>(value)) << str;
+
+    char reference[32];
+    auto end = std::to_chars(reference, reference + 32, value, std::chars_format::scientific).ptr;
+    auto digitCount = [](const char *it, const char *end) {
+        // count significant digits of the mantissa
+        int count = 0;
+        int zeros = 0;
+        bool leading = true;
+        for (; it < end && *it != 'e'; ++it) {
+            if (*it >= '0' && *it <= '9') {
+                if (leading && *it == '0')
+                    continue;
+                leading = false;
+                zeros = *it == '0' ? zeros + 1 : 0;
+                ++count;
+            }
+        }
+        return count - zeros;
+    };
+    ASSERT_EQ(digitCount(str.data(), str.data() + str.size()), digitCount(reference, end)) << str;
+}
+
+TEST(cocoTest, convert_dec_float) {
+    // fixed precision
+    EXPECT_EQ(dec(2.5f, 0), "3");
+    EXPECT_EQ(dec(0.125f, -2), "0.13");
+    EXPECT_EQ(dec(0.5, 0, 3), ".5");
+    EXPECT_EQ(dec(0.0, 0, 3), "0");
+    EXPECT_EQ(dec(-0.0001, 3), "-0");
+    EXPECT_EQ(dec(16777216.0f, 0), "16777216");
+    EXPECT_EQ(dec(0.1f, -11), "0.10000000149");
+    EXPECT_EQ(dec(0.1, -11), "0.10000000000");
+    EXPECT_EQ(dec(123456789.0, 1, -2), "123456789.00");
+    EXPECT_EQ(dec(1e17, 1, -3), "100000000000000000");
+    EXPECT_EQ(dec(-1e30, 3), "-1e30");
+    EXPECT_EQ(dec(NAN), "nan");
+    EXPECT_EQ(dec(-INFINITY), "-inf");
+    EXPECT_EQ(dec(1.5e-7f, 1, -11), "0.00000015000");
+    EXPECT_EQ(dec(1.5f, 1, -2, 6), "  1.50");
+
+    // shortest
+    EXPECT_EQ(decShortest(0.1f), "0.1");
+    EXPECT_EQ(decShortest(0.1), "0.1");
+    EXPECT_EQ(decShortest(1.0 / 3.0), "0.3333333333333333");
+    EXPECT_EQ(decShortest(-50.1234f), "-50.1234");
+    EXPECT_EQ(decShortest(100.0f), "100");
+    EXPECT_EQ(decShortest(0.001), "0.001");
+    EXPECT_EQ(decShortest(1.5e-5), "1.5e-5");
+    EXPECT_EQ(decShortest(1e21), "1e21");
+    EXPECT_EQ(decShortest(1e22), "1e22");
+    EXPECT_EQ(decShortest(123456789012345680000.0), "123456789012345680000");
+    EXPECT_EQ(decShortest(0.0), "0");
+    EXPECT_EQ(decShortest(-0.0f), "-0");
+    EXPECT_EQ(decShortest(NAN), "nan");
+    EXPECT_EQ(decShortest(INFINITY), "inf");
+    EXPECT_EQ(decShortest(-INFINITY), "-inf");
+    EXPECT_EQ(decShortest(std::numeric_limits<float>::max()), "3.4028235e38");
+    EXPECT_EQ(decShortest(std::numeric_limits<float>::denorm_min()), "1e-45");
+    EXPECT_EQ(decShortest(-std::numeric_limits<double>::max()), "-1.7976931348623157e308");
+    EXPECT_EQ(decShortest(std::numeric_limits<double>::denorm_min()), "5e-324");
+    EXPECT_EQ(decShortest(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+
+    // round trip of every 8209th float
+    for (uint32_t bits = 0; bits < 0x7f800000; bits += 8209) {
+        checkShortest(std::bit_cast<float>(bits));
+        checkShortest(-std::bit_cast<float>(bits));
+    }
+
+    // round trip of random doubles
+    XorShiftRandom random;
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t bits = (uint64_t(random.draw()) << 32 | random.draw()) & 0x7fffffffffffffff;
+        if (i % 4 == 0)
+            bits &= ~((uint64_t(1) << (random.draw() % 53)) - 1);
+        if (bits < 0x7ff0000000000000)
+            checkShortest(std::bit_cast<double>(bits));
+    }
+}
+
+// round trip of all floats, takes a few minutes, run with --gtest_also_run_disabled_tests
+TEST(cocoTest, DISABLED_convert_dec_float_exhaustive) {
+    for (uint32_t bits = 0; bits < 0x7f800000; ++bits)
+        checkShortest(std::bit_cast<float>(bits));
+}
+
+TEST(cocoTest, convert_parse) {
+    // integers
+    EXPECT_EQ(*dec<int>("2147483647"), 2147483647);
+    EXPECT_FALSE(dec<int>("2147483648"));
+    EXPECT_EQ(*dec<int>("-2147483648"), INT32_MIN);
+    EXPECT_FALSE(dec<int>("-2147483649"));
+    EXPECT_EQ(*dec<uint8_t>("255"), 255);
+    EXPECT_FALSE(dec<uint8_t>("256"));
+    EXPECT_FALSE(dec<unsigned>("-1"));
+    EXPECT_EQ(*dec<uint64_t>("18446744073709551615"), UINT64_MAX);
+    EXPECT_FALSE(dec<uint64_t>("18446744073709551616"));
+    EXPECT_FALSE(dec<uint64_t>("99999999999999999999"));
+    EXPECT_EQ(*dec<int64_t>("-9223372036854775808"), INT64_MIN);
+    EXPECT_EQ(*dec<int>("0000000000000000000000000012"), 12);
+    EXPECT_EQ(dec<int>("+12345678").length, 9);
+    EXPECT_FALSE(dec<int>(""));
+    EXPECT_FALSE(dec<int>("-"));
+    EXPECT_FALSE(dec<int>("12a"));
+    EXPECT_FALSE(dec<int>("1234567a"));
+    EXPECT_FALSE(dec<int>("12345678a"));
+    EXPECT_FALSE(dec<int>(" 1"));
+    EXPECT_EQ(parseInt("-50"), -50);
+    EXPECT_EQ(parseInt("99999999999"), std::nullopt);
+
+    // floating point numbers
+    auto doubleBits = [](const char *str) {
+        auto result = dec<double>(str);
+        EXPECT_EQ(result.length, int(strlen(str))) << str;
+        return std::bit_cast<uint64_t>(*result);
+    };
+    auto floatBits = [](const char *str) {
+        auto result = dec<float>(str);
+        EXPECT_EQ(result.length, int(strlen(str))) << str;
+        return std::bit_cast<uint32_t>(*result);
+    };
+    for (const char *str : {"0", "-0", "0.1", ".5", "5.", "1e10", "1E-10", "+1.5e+3", "123456789012345678",
+        "9007199254740993", "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "2.4703282292062328e-324", "2.4703282292062327e-324", "1.7976931348623157e308", "1.7976931348623159e308",
+        "1e-400", "1e400", "0.000000000000000000000000000000000000000000001", "7.2057594037927933e16",
+        "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497791",
+        "0.1000000000000000055511151231257827021181583404541015625",
+        "0.10000000000000000555111512312578270211815834045410156250000000000000001"})
+    {
+        EXPECT_EQ(doubleBits(str), std::bit_cast<uint64_t>(std::strtod(str, nullptr))) << str;
+    }
+    for (const char *str : {"16777217", "3.4028235e38", "3.4028236e38", "1.17549435e-38", "1e-45", "7e-46",
+        "0.1", "1.00000017881393432617187499", "1.000000178813934326171875"})
+    {
+        EXPECT_EQ(floatBits(str), std::bit_cast<uint32_t>(std::strtof(str, nullptr))) << str;
+    }
+    EXPECT_TRUE(std::isnan(*dec<double>("nan")));
+    EXPECT_EQ(*dec<float>("-inf"), -INFINITY);
+    EXPECT_FALSE(dec<double>(""));
+    EXPECT_FALSE(dec<double>("."));
+    EXPECT_FALSE(dec<double>("-"));
+    EXPECT_FALSE(dec<double>("1e"));
+    EXPECT_FALSE(dec<double>("1e+"));
+    EXPECT_FALSE(dec<double>("1.2.3"));
+    EXPECT_EQ(*parseFloat("50.99"), 50.99f);
+    EXPECT_EQ(*parseFloat("1.5e3"), 1500.0f);
+
+    // random numbers compared to strtod() and strtof()
+    XorShiftRandom random;
+    char str[64];
+    for (int i = 0; i < 100000; ++i) {
+        int length = 0;
+        int digitCount = 1 + random.draw() % 25;
+        int point = random.draw() % (digitCount + 1);
+        for (int j = 0; j < digitCount; ++j) {
+            if (j == point)
+                str[length++] = '.';
+            str[length++] = '0' + random.draw() % 10;
+        }
+        if (random.draw() % 2 == 0)
+            length += std::snprintf(str + length, 16, "e%d", int(random.draw() % 700) - 350);
+        str[length] = 0;
+        ASSERT_EQ(doubleBits(str), std::bit_cast<uint64_t>(std::strtod(str, nullptr))) << str;
+        ASSERT_EQ(floatBits(str), std::bit_cast<uint32_t>(std::strtof(str, nullptr))) << str;
+    }
+
+    // long numbers exactly halfway between two doubles (ties to even) and slightly above, where the deciding digit
+    // comes after many digits. A long double can represent the halfway points exactly on x86
+    if constexpr (std::numeric_limits<long double>::digits >= 64) {
+        std::string halfway(900, 0);
+        for (int i = 0; i < 1000; ++i) {
+            double d = std::bit_cast<double>((uint64_t(random.draw()) << 32 | random.draw()) & 0x7fefffffffffffff);
+            if (i % 4 == 0)
+                d = std::bit_cast<double>(uint64_t(random.draw()) & 0xfffffffffffff); // subnormal
+            long double h = ((long double)d + (long double)std::nextafter(d, INFINITY)) / 2;
+            halfway.resize(std::snprintf(halfway.data(), halfway.size(), "%.800Le", h));
+            for (std::string s : {halfway, halfway.substr(0, 790) + "1" + halfway.substr(790)}) {
+                ASSERT_EQ(doubleBits(s.c_str()), std::bit_cast<uint64_t>(std::strtod(s.c_str(), nullptr))) << s;
+            }
+            halfway.resize(900);
+        }
+    }
+    // halfway between 0 and the smallest subnormal, and between 0.1 and the next double, then slightly above
+    for (auto [mantissa, exponent] : {std::pair<const char *, const char *>{"2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125", "e-324"},
+        {"0.1000000000000000055511151231257827021181583404541015625", ""}})
+    {
+        for (std::string str : {std::string(mantissa) + exponent, mantissa + std::string(200, '0') + "1" + exponent})
+            EXPECT_EQ(doubleBits(str.c_str()), std::bit_cast<uint64_t>(std::strtod(str.c_str(), nullptr))) << str;
+    }
+    // halfway between 1 and the next float, then slightly above
+    for (std::string str : {std::string("1.000000059604644775390625"),
+        "1.000000059604644775390625" + std::string(150, '0') + "1"})
+    {
+        EXPECT_EQ(floatBits(str.c_str()), std::bit_cast<uint32_t>(std::strtof(str.c_str(), nullptr))) << str;
+    }
+
+    // parse many
+    int ints[4];
+    auto result = parseMany("1,2, 3\n4", std::span(ints));
+    EXPECT_EQ(result.value, 4);
+    EXPECT_EQ(result.length, 8);
+    EXPECT_EQ(ints[3], 4);
+    result = parseMany("1,2,3,4,5", std::span(ints));
+    EXPECT_EQ(result.value, 4);
+    EXPECT_EQ(result.length, 7);
+    double doubles[4];
+    result = parseMany("1.5;-2e3;x", std::span(doubles), ';');
+    EXPECT_EQ(result.value, 2);
+    EXPECT_EQ(result.length, 8);
+    EXPECT_EQ(doubles[1], -2000.0);
+    result = parseMany("1.5,", std::span(doubles));
+    EXPECT_EQ(result.value, 1);
+    result = parseMany("", std::span(doubles));
+    EXPECT_FALSE(result);
+}
+
 TEST(cocoTest, convert_hex) {
     EXPECT_EQ(hex(0x10), "00000010");
     EXPECT_EQ(hex(UINT64_C(0x1234567812345678)), "1234567812345678");
@@ -668,6 +1178,63 @@ TEST(cocoTest, convert_hex) {
 
 }
 
+TEST(cocoTest, convert_hexEncode) {
+    // compare with hex() for all lengths around the block sizes
+    uint8_t data[100];
+    for (int i = 0; i < 100; ++i)
+        data[i] = uint8_t(i * 37 + 11);
+    for (int length = 0; length <= 100; ++length) {
+        char str[200];
+        char *end = hexEncode(Array<const uint8_t>(data, length), str);
+        ASSERT_EQ(end - str, length * 2);
+        for (int i = 0; i < length; ++i)
+            ASSERT_EQ(String(str + i * 2, 2), hex(data[i])) << length;
+
+        // decode
+        uint8_t decoded[100];
+        auto result = hexDecode(String(str, length * 2), decoded);
+        ASSERT_EQ(result.value, length);
+        ASSERT_EQ(result.length, length * 2);
+        for (int i = 0; i < length; ++i)
+            ASSERT_EQ(decoded[i], data[i]);
+    }
+
+    // all characters
+    for (int ch = 0; ch < 256; ++ch) {
+        char str[40];
+        std::fill(std::begin(str), std::end(str), 'A');
+        str[35] = char(ch);
+        uint8_t decoded[20];
+        auto result = hexDecode(String(str, 40), decoded);
+        bool valid = (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F');
+        EXPECT_EQ(result.length, valid ? 40 : 34) << ch;
+        EXPECT_EQ(result.value, valid ? 20 : 17) << ch;
+        EXPECT_EQ(decoded[0], 0xaa);
+        if (valid) {
+            EXPECT_EQ(decoded[17], 0xa0 | (ch <= '9' ? ch - '0' : (ch | 0x20) - 'a' + 10));
+        }
+    }
+
+    // upper case, odd length
+    uint8_t decoded[4];
+    auto result = hexDecode("12aBcD5", decoded);
+    EXPECT_EQ(result.value, 3);
+    EXPECT_EQ(result.length, 6);
+    EXPECT_EQ(decoded[2], 0xcd);
+    EXPECT_FALSE(hexDecode("", decoded));
+}
+
+TEST(cocoTest, convert_hexDump) {
+    uint8_t data[20];
+    for (int i = 0; i < 20; ++i)
+        data[i] = uint8_t('A' + i * 4);
+    StringBuffer<200> b;
+    hexDump(b, data, 0x1000);
+    EXPECT_EQ(b.string(),
+        "00001000  41 45 49 4d 51 55 59 5d  61 65 69 6d 71 75 79 7d  |AEIMQUY]aeimquy}|\n"
+        "00001010  81 85 89 8d                                       |....|\n");
+}
+
 TEST(cocoTest, convert_utf8) {
     EXPECT_EQ(*utf8("a"), 'a');
     EXPECT_EQ(utf8("a").length, 1);
@@ -685,6 +1252,76 @@ TEST(cocoTest, convert_utf8) {
     EXPECT_EQ(converted.length, 7);
 }
 
+TEST(cocoTest, convert_utf8Bulk) {
+    // text longer than the blocks of 16 and 32 bytes with ASCII and non-ASCII parts
+    std::string text;
+    for (int i = 0; i < 10; ++i)
+        text += "The quick brown fox jumps over the lazy dog. Grüße, 😊 €\xef\xbf\xbf\xf4\x8f\xbf\xbf\xed\x9f\xbf";
+    EXPECT_TRUE(isValidUtf8(text));
+    EXPECT_EQ(countUtf8(text), 10 * 58);
+
+    // all prefixes with truncated sequences at the end, and errors at all positions
+    for (int length = 0; length <= int(text.size()); ++length) {
+        String prefix(text.data(), length);
+        bool truncated = length < int(text.size()) && (uint8_t(text[length]) & 0xc0) == 0x80;
+        ASSERT_EQ(isValidUtf8(prefix), !truncated) << length;
+    }
+    for (int i = 0; i < int(text.size()); ++i) {
+        std::string str = text;
+        str[i] = char(0xff);
+        ASSERT_FALSE(isValidUtf8(str)) << i;
+    }
+
+    // invalid sequences
+    const char *invalid[] = {
+        "\x80", // continuation without lead
+        "\xc0\x80", "\xc1\xbf", "\xe0\x9f\xbf", "\xf0\x8f\xbf\xbf", // overlong
+        "\xed\xa0\x80", "\xed\xbf\xbf", // surrogates
+        "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", // above 0x10ffff
+        "\xe2\x82", "\xe2\x82" "a", "\xc3\xa4\xa4"}; // truncated, too long
+    for (auto str : invalid) {
+        std::string s = text + str + text;
+        EXPECT_FALSE(isValidUtf8(str)) << str;
+        EXPECT_FALSE(isValidUtf8(s)) << str;
+    }
+
+    // UTF-16 and UTF-32 round trip
+    std::vector<char16_t> utf16(text.size());
+    auto r16 = utf8ToUtf16(text, utf16.data());
+    EXPECT_EQ(r16.length, int(text.size()));
+    EXPECT_EQ(r16.value, 10 * 60); // the smiley and U+10FFFF need surrogate pairs
+    EXPECT_EQ(utf16[47], 0xfc);
+    EXPECT_EQ(utf16[52], 0xd83d);
+    EXPECT_EQ(utf16[53], 0xde0a);
+
+    std::vector<char32_t> utf32(text.size());
+    auto r32 = utf8ToUtf32(text, utf32.data());
+    EXPECT_EQ(r32.length, int(text.size()));
+    EXPECT_EQ(r32.value, 10 * 58);
+    EXPECT_EQ(utf32[52], 0x1f60a);
+    EXPECT_EQ(utf32[57], 0xd7ff);
+
+    std::string back(text.size(), 0);
+    auto b16 = utf16ToUtf8(Array<const char16_t>(utf16.data(), r16.value), back.data());
+    EXPECT_EQ(b16.length, r16.value);
+    EXPECT_EQ(back, text);
+    std::fill(back.begin(), back.end(), 0);
+    auto b32 = utf32ToUtf8(Array<const char32_t>(utf32.data(), r32.value), back.data());
+    EXPECT_EQ(b32.length, r32.value);
+    EXPECT_EQ(back, text);
+
+    // conversion stops at errors
+    char32_t codes[8];
+    auto r = utf8ToUtf32("ab\xed\xa0\x80" "c", codes);
+    EXPECT_EQ(r.value, 2);
+    EXPECT_EQ(r.length, 2);
+    char16_t unpaired[] = {'a', 0xd83d, 'b'};
+    char out[16];
+    EXPECT_EQ(utf16ToUtf8(unpaired, out).length, 1);
+    char32_t large[] = {'a', 'b', 0x110000};
+    EXPECT_EQ(utf32ToUtf8(large, out).length, 2);
+}
+
 
 // CStringConcept
 // --------------
@@ -738,6 +1375,141 @@ TEST(cocoTest, cocoEnum) {
 }
 
 
+// format
+// ------
+
+// stream that records each write
+struct RecordingStream {
+    RecordingStream &operator <<(const String &str) {
+        this->writes.emplace_back(str.data(), str.size());
+        return *this;
+    }
+
+    std::vector<std::string> writes;
+};
+
+TEST(cocoTest, format) {
+    StringBuffer<128> b;
+
+    // integers
+    format<"x={} y={:04x} z={:5}|">(b, 42, 0xbeefu, -17);
+    EXPECT_EQ(b.string(), "x=42 y=beef z=  -17|");
+    b.clear();
+    format<"{:05}|{:x}|{:08x}|{:3x}|{}|{}">(b, -42, 0, 0xabc, 0xf, INT_MIN, UINT64_C(18446744073709551615));
+    EXPECT_EQ(b.string(), "-0042|0|00000abc|  f|-2147483648|18446744073709551615");
+    b.clear();
+    format<"{}{}{}{}">(b, int8_t(-5), uint16_t(65535), int64_t(-1), ExtractEnum::FOO_1);
+    EXPECT_EQ(b.string(), "-565535-116");
+    b.clear();
+
+    // all decimal digit counts
+    for (uint64_t value = 1; value < UINT64_C(10000000000000000000); value *= 10) {
+        for (uint64_t v : {value - 1, value}) {
+            b.clear();
+            format<"{}">(b, v);
+            EXPECT_EQ(b.string(), String(dec(v))) << v;
+        }
+    }
+    b.clear();
+
+    // floating point
+    format<"{} {:.2} {:8.1f}|{:g} {:g}">(b, 3.14159f, 2.5, -1.25f, 0.1, 1e21f);
+    EXPECT_EQ(b.string(), "3.142 2.50     -1.3|0.1 1e21");
+    b.clear();
+
+    // strings and characters, escaped braces
+    std::string str = "bar";
+    format<"{{{}}} {:5} {} {}{:c}">(b, "foo", str, String("baz"), 'x', '!');
+    EXPECT_EQ(b.string(), "{foo}   bar baz x!");
+    b.clear();
+
+    // output gets clipped if the buffer is too small
+    StringBuffer<8> small;
+    format<"value={}">(small, 12345);
+    EXPECT_EQ(small.string(), "value=12");
+
+    // maximum length
+    static_assert(formatMaxLength<"x={}", int> == 13);
+    static_assert(formatMaxLength<"{:x}{:20}", uint32_t, uint8_t> == 28);
+
+    // type and precision of a field must match the argument, otherwise format() does not compile
+    static_assert(detail::formatFieldValid<int>({.type = 'x'}));
+    static_assert(detail::formatFieldValid<ExtractEnum>({.type = 'd'}));
+    static_assert(detail::formatFieldValid<double>({.precision = 11, .type = 'f'}));
+    static_assert(detail::formatFieldValid<char>({.type = 'c'}));
+    static_assert(detail::formatFieldValid<String>({.type = 's'}));
+    static_assert(!detail::formatFieldValid<float>({.type = 'x'}));
+    static_assert(!detail::formatFieldValid<int>({.type = 's'}));
+    static_assert(!detail::formatFieldValid<int>({.precision = 2}));
+    static_assert(!detail::formatFieldValid<const char *>({.type = 'd'}));
+    static_assert(!detail::formatFieldValid<char>({.type = 'x'}));
+
+    // stream: strings are written separately, everything else in one call
+    RecordingStream s;
+    format<"a={} b={} c={:4}\n">(s, 1, "two", 3.5f);
+    ASSERT_EQ(s.writes.size(), 3);
+    EXPECT_EQ(s.writes[0], "a=1 b=");
+    EXPECT_EQ(s.writes[1], "two");
+    EXPECT_EQ(s.writes[2], " c= 3.5\n");
+}
+
+
+// hash
+// ----
+
+constexpr char hashTestData[] = "The quick brown fox jumps over the lazy dog. 0123456789abcdef";
+
+// hashes of all prefixes of the test data, calculated at compile time
+constexpr auto hashTestPrefixes = [] {
+    std::array<uint32_t, std::size(hashTestData)> hashes;
+    for (int i = 0; i < int(std::size(hashTestData)); ++i)
+        hashes[i] = hash(hashTestData, i);
+    return hashes;
+}();
+
+int hashSwitch(String command) {
+    switch (command.hash()) {
+    case "start"_hash:
+        return 1;
+    case "stop"_hash:
+        return 2;
+    case "status"_hash:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+TEST(cocoTest, hash) {
+    // compile time and run time hash must be equal, also for unaligned data
+    for (int i = 0; i < int(std::size(hashTestData)); ++i) {
+        EXPECT_EQ(hash(hashTestData, i), hashTestPrefixes[i]);
+        char unaligned[sizeof(hashTestData) + 1];
+        std::copy(hashTestData, hashTestData + i, unaligned + 1);
+        EXPECT_EQ(hash(unaligned + 1, i), hashTestPrefixes[i]);
+    }
+
+    // different lengths and seeds give different hashes
+    for (int i = 1; i < int(std::size(hashTestData)); ++i)
+        EXPECT_NE(hashTestPrefixes[i], hashTestPrefixes[i - 1]);
+    EXPECT_NE(hash("foo", 3, 1), hash("foo", 3, 2));
+
+    // switch on hash
+    static_assert(hashesUnique<String>({"start", "stop", "status"}));
+    static_assert(hashesUnique({"start", "stop", "status"}));
+    static_assert(String("foo").hash() == "foo"_hash);
+    EXPECT_EQ(hashSwitch("start"), 1);
+    EXPECT_EQ(hashSwitch("stop"), 2);
+    EXPECT_EQ(hashSwitch("status"), 3);
+    EXPECT_EQ(hashSwitch("foo"), 0);
+
+    // djb2 for compatibility
+    EXPECT_EQ(String().djb2(), 5381);
+    EXPECT_EQ(String("a").djb2(), 5381 * 33 + 'a');
+    static_assert(String("foo").djb2() == djb2("foo", 3));
+}
+
+
 // IsSubclass
 // ----------
 
@@ -902,6 +1674,129 @@ TEST(cocoTest, IntrusiveQueue) {
 }
 
 
+// IntrusiveTree
+// -------------
+
+struct TestTreeElement : public ElementBaseClass, public IntrusiveTreeNode {
+    int key;
+};
+
+// check links, order and balance of a subtree and return its height
+int checkTree(IntrusiveTreeNode *node, IntrusiveTreeNode *parent) {
+    if (node == nullptr)
+        return 0;
+    EXPECT_EQ(node->parent, parent);
+    if (node->left != nullptr) {
+        EXPECT_LE(static_cast<TestTreeElement *>(node->left)->key, static_cast<TestTreeElement *>(node)->key);
+    }
+    if (node->right != nullptr) {
+        EXPECT_GE(static_cast<TestTreeElement *>(node->right)->key, static_cast<TestTreeElement *>(node)->key);
+    }
+    int l = checkTree(node->left, node);
+    int r = checkTree(node->right, node);
+    EXPECT_EQ(node->balance, r - l);
+    return std::max(l, r) + 1;
+}
+
+TEST(cocoTest, IntrusiveTree) {
+    constexpr int COUNT = 200;
+    IntrusiveTree<TestTreeElement> tree;
+    TestTreeElement elements[COUNT];
+    EXPECT_TRUE(tree.empty());
+
+    // add elements with pseudo random keys, some of them equal
+    for (int i = 0; i < COUNT; ++i) {
+        elements[i].key = (i * 37) % 101;
+        tree.add(elements[i]);
+        checkTree(tree.left, &tree);
+    }
+    EXPECT_EQ(tree.count(), COUNT);
+
+    // height of AVL tree is at most 1.44 * log2(n)
+    EXPECT_LE(checkTree(tree.left, &tree), 11);
+
+    // iterate in order
+    int last = -1;
+    for (auto &e : tree) {
+        EXPECT_GE(e.key, last);
+        EXPECT_EQ(e.value, 10);
+        last = e.key;
+    }
+
+    // find
+    EXPECT_EQ(tree.find(37)->key, 37);
+    EXPECT_EQ(tree.find(200), nullptr);
+
+    // move an element
+    TestTreeElement moved(std::move(elements[0]));
+    EXPECT_FALSE(elements[0].inTree());
+    EXPECT_TRUE(moved.inTree());
+    checkTree(tree.left, &tree);
+
+    // remove elements in a different order
+    for (int i = 1; i < COUNT; ++i) {
+        elements[(i * 73) % COUNT].removeFromTree();
+        checkTree(tree.left, &tree);
+    }
+    EXPECT_EQ(tree.count(), 1);
+    moved.removeFromTree();
+    EXPECT_TRUE(tree.empty());
+}
+
+
+// PerfectHash
+// -----------
+
+#define KEYWORDS "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", \
+    "concept", "const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return", \
+    "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", \
+    "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", \
+    "namespace", "new", "noexcept", "not", "nullptr", "operator", "or", "private", "protected", "public", \
+    "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static", "static_assert", \
+    "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", \
+    "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor"
+
+constexpr String keywords[] = {KEYWORDS};
+constexpr PerfectHash keywordHash(KEYWORDS);
+constexpr PerfectHash keywordHash2(keywords);
+
+enum class Command {START, STOP, STATUS};
+constexpr PerfectHash commands("start", "stop", "status");
+
+TEST(cocoTest, PerfectHash) {
+    static_assert(keywordHash.size() == int(std::size(keywords)));
+    static_assert(keywordHash[2].size() == 3);
+    EXPECT_EQ(keywordHash[2], "and");
+
+    // all keywords are found at their index
+    for (int i = 0; i < keywordHash.size(); ++i) {
+        EXPECT_EQ(keywordHash.find(keywords[i]), i);
+        EXPECT_EQ(keywordHash2.find(keywords[i]), i);
+
+        // find in a non-terminated buffer
+        std::string str(keywords[i].data(), keywords[i].size());
+        EXPECT_EQ(keywordHash.find(String(str)), i);
+    }
+
+    // strings that are not keywords
+    for (String str : {"", "a", "an", "andd", "Auto", "co_awai", "whilex", "static_assert_", "xor "}) {
+        EXPECT_EQ(keywordHash.find(str), -1);
+        EXPECT_EQ(keywordHash.find(str, 1000), 1000);
+    }
+
+    // single string
+    constexpr PerfectHash single("foo");
+    EXPECT_EQ(single.find("foo"), 0);
+    EXPECT_EQ(single.find("bar"), -1);
+
+    // enum
+    EXPECT_EQ(commands.find("start", Command(-1)), Command::START);
+    EXPECT_EQ(commands.find("stop", Command(-1)), Command::STOP);
+    EXPECT_EQ(commands.find("status", Command(-1)), Command::STATUS);
+    EXPECT_EQ(commands.find("restart", Command(-1)), Command(-1));
+}
+
+
 // PointerConcept
 // --------------
 
@@ -1186,6 +2081,11 @@ TEST(cocoTest, String) {
         EXPECT_EQ(String("foo").indexOf("bar"), -1);
         EXPECT_EQ(String("aaabc").indexOf("aabc"), 1);
         EXPECT_EQ(String("ababc").indexOf("abc"), 2);
+        EXPECT_EQ(String("abc").indexOf("abcd"), -1);
+        EXPECT_EQ(String("abc").indexOf("", 1), 1);
+
+        EXPECT_EQ(String("abcabc").lastIndexOf('b'), 4);
+        EXPECT_EQ(String("abcabc").lastIndexOf('b', 4), 1);
     }
 
     // convert to string_view
@@ -1196,6 +2096,46 @@ TEST(cocoTest, String) {
     }
 }
 
+// compare vectorized search and compare kernels against std::string_view on random strings of a small alphabet
+TEST(cocoTest, String_fuzz) {
+    XorShiftRandom random;
+    char a[300];
+    char b[300];
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        int aLength = random.draw() % 300;
+        int bLength = iteration % 4 == 0 ? random.draw() % 300 : random.draw() % 8;
+        for (int i = 0; i < aLength; ++i)
+            a[i] = "abc\x80"[random.draw() % 4];
+        for (int i = 0; i < bLength; ++i)
+            b[i] = "abc\x80"[random.draw() % 4];
+
+        // append a part of a to b to get more equal strings and matches
+        if (iteration % 3 == 0 && aLength > 0) {
+            int start = random.draw() % aLength;
+            int count = std::min(int(random.draw() % 40), std::min(aLength - start, 300 - bLength));
+            std::copy(a + start, a + start + count, b + bLength);
+            bLength += count;
+        }
+
+        String s(a, aLength);
+        String t(b, bLength);
+        std::string_view sv(a, aLength);
+        std::string_view tv(b, bLength);
+        char ch = bLength > 0 ? b[0] : 'a';
+        int startIndex = aLength > 0 ? random.draw() % aLength : 0;
+
+        EXPECT_EQ(s.indexOf(ch, startIndex), int(sv.find(ch, startIndex)));
+        EXPECT_EQ(s.lastIndexOf(ch, startIndex), int(sv.substr(0, startIndex).rfind(ch)));
+        EXPECT_EQ(s.lastIndexOf(ch), int(sv.rfind(ch)));
+        EXPECT_EQ(s.indexOf(t, startIndex), int(sv.find(tv, startIndex)));
+        EXPECT_EQ(s == t, sv == tv);
+        EXPECT_EQ(s <=> t, sv.compare(tv) <=> 0);
+        EXPECT_EQ(s.startsWith(t), sv.starts_with(tv));
+        EXPECT_EQ(s.endsWith(t), sv.ends_with(tv));
+    }
+}
+
+
 // StringBuffer, StreamOperators
 // -----------------------------
 
@@ -1819,25 +2759,6 @@ TEST(cocoTest, Vector4) {
 
 
 
-// File
-// ----
-/*
-TEST(cocoTest, File) {
-    File f("foo.txt", File::Mode::READ_WRITE | File::Mode::TRUNCATE);
-    char str[4];
-
-    EXPECT_EQ(f.write(0, "foo", 3), 3);
-    EXPECT_EQ(f.read(0, str, 3), 3);
-    str[3] = 0;
-    EXPECT_STREQ(str, "foo");
-
-    EXPECT_EQ(f.write(3, "bar", 3), 3);
-    EXPECT_EQ(f.read(3, str, 3), 3);
-    str[3] = 0;
-    EXPECT_STREQ(str, "bar");
-}*/
-
-
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     int success = RUN_ALL_TESTS();
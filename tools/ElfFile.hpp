@@ -0,0 +1,108 @@
+#pragma once
+
+#include <coco/String.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+/// @brief Minimal reader for little endian 32 and 64 bit ELF files, gives access to the section contents
+///
+class ElfFile {
+public:
+    /// @brief Load an ELF file
+    /// @param path Path of the file
+    /// @return true if successful
+    bool load(const char *path) {
+        std::ifstream file(path, std::ios::binary);
+        this->elf.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        this->sections.clear();
+        if (this->elf.size() < 64 || std::memcmp(this->elf.data(), "\x7f" "ELF", 4) != 0 || this->elf[5] != 1)
+            return false;
+        bool is64 = this->elf[4] == 2;
+
+        // section headers, the fields have different positions in 32 and 64 bit ELF files
+        uint64_t shoff = is64 ? read<uint64_t>(0x28) : read<uint32_t>(0x20);
+        int shentsize = read<uint16_t>(is64 ? 0x3a : 0x2e);
+        int shnum = read<uint16_t>(is64 ? 0x3c : 0x30);
+        int shstrndx = read<uint16_t>(is64 ? 0x3e : 0x32);
+        for (int i = 0; i < shnum; ++i) {
+            size_t header = shoff + i * shentsize;
+            Section section;
+            section.name = read<uint32_t>(header);
+            section.type = read<uint32_t>(header + 4);
+            section.flags = is64 ? read<uint64_t>(header + 0x08) : read<uint32_t>(header + 0x08);
+            section.address = is64 ? read<uint64_t>(header + 0x10) : read<uint32_t>(header + 0x0c);
+            section.offset = is64 ? read<uint64_t>(header + 0x18) : read<uint32_t>(header + 0x10);
+            section.size = is64 ? read<uint64_t>(header + 0x20) : read<uint32_t>(header + 0x14);
+
+            // sections without data in the file (NOBITS) are treated as empty
+            if (section.type == NOBITS || section.offset + section.size > this->elf.size())
+                section.size = 0;
+            this->sections.push_back(section);
+        }
+        if (shstrndx >= int(this->sections.size()))
+            return false;
+        this->names = this->sections[shstrndx].offset;
+        return true;
+    }
+
+    /// @brief Get the contents of a section
+    /// @param name Name of the section
+    /// @param data Contents of the section
+    /// @return true if the section was found
+    bool section(const char *name, coco::String &data) const {
+        for (auto &section : this->sections) {
+            uint64_t offset = this->names + section.name;
+            if (offset < this->elf.size() && std::strncmp(this->elf.data() + offset, name, this->elf.size() - offset) == 0) {
+                data = coco::String(this->elf.data() + section.offset, int(section.size));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Get a null terminated string at an address in the memory image, e.g. a string literal
+    /// @param address Address of the string
+    /// @return String, empty if the address is not in a section that is part of the memory image
+    coco::String string(uint64_t address) const {
+        for (auto &section : this->sections) {
+            if ((section.flags & ALLOC) != 0 && address >= section.address && address < section.address + section.size) {
+                const char *begin = this->elf.data() + section.offset + (address - section.address);
+                const char *end = this->elf.data() + section.offset + section.size;
+                auto null = static_cast<const char *>(std::memchr(begin, 0, end - begin));
+                return coco::String(begin, int((null != nullptr ? null : end) - begin));
+            }
+        }
+        return {};
+    }
+
+protected:
+    static constexpr uint32_t NOBITS = 8;
+    static constexpr uint64_t ALLOC = 2;
+
+    struct Section {
+        // offset of the name in the section name table
+        uint32_t name;
+
+        uint32_t type;
+        uint64_t flags;
+        uint64_t address;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    template <typename T>
+    T read(size_t offset) const {
+        T value = 0;
+        if (offset + sizeof(T) <= this->elf.size())
+            std::memcpy(&value, this->elf.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::vector<char> elf;
+    std::vector<Section> sections;
+    uint64_t names = 0;
+};
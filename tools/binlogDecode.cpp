@@ -0,0 +1,57 @@
+#include "ElfFile.hpp"
+#include <coco/binlog.hpp>
+#include <cstdio>
+#include <vector>
+
+
+/*
+    Decoder for binary logs written by COCO_BINLOG() (see coco/binlog.hpp)
+    Usage: binlogDecode <ELF file> [<log file or serial device>]
+    Reads the format strings from the coco_binlog section of the ELF file, then decodes the binary log from the given
+    file or stdin and writes the text to stdout. Example for a development board on a serial port:
+        stty -F /dev/ttyACM0 raw 115200 && binlogDecode firmware.elf /dev/ttyACM0
+*/
+
+using namespace coco;
+
+
+int main(int argc, const char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <ELF file> [<log file or serial device>]\n", argv[0]);
+        return 1;
+    }
+
+    // read format strings from the ELF file
+    ElfFile elf;
+    String section;
+    if (!elf.load(argv[1]) || !elf.section("coco_binlog", section)) {
+        fprintf(stderr, "error: %s has no coco_binlog section\n", argv[1]);
+        return 1;
+    }
+
+    // open the log
+    FILE *input = argc >= 3 ? fopen(argv[2], "rb") : stdin;
+    if (input == nullptr) {
+        fprintf(stderr, "error: can't open %s\n", argv[2]);
+        return 1;
+    }
+
+    // decode the records as soon as they are complete
+    std::vector<char> data;
+    char text[4096];
+    auto write = [](const char *text, int length) {fwrite(text, 1, length, stdout);};
+    int ch;
+    while ((ch = getc(input)) != EOF) {
+        data.push_back(char(ch));
+        int used = binlog::decodeAll(section, String(data.data(), int(data.size())), text, sizeof(text), write);
+        if (used > 0) {
+            fflush(stdout);
+            data.erase(data.begin(), data.begin() + used);
+        }
+    }
+
+    // end of the log: decode the records that follow an incomplete one
+    binlog::decodeAll(section, String(data.data(), int(data.size())), text, sizeof(text), write, true);
+    fflush(stdout);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "ElfFile.hpp"
+#include <coco/traceWrite.hpp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+/*
+    Converter for binary traces written by trace::writeBinary() (see coco/trace.hpp) to Chrome trace JSON
+    Usage: traceConvert <ELF file> [<binary trace file>] > trace.json
+    Reads the binary trace from the given file or stdin, looks up the names of the spans in the ELF file and writes
+    the JSON to stdout. Open the result in ui.perfetto.dev or chrome://tracing. Names can only be looked up if the
+    program is not relocated at runtime, i.e. firmware for microcontrollers or native programs linked with -no-pie
+*/
+
+using namespace coco;
+
+
+// stream that writes to stdout
+struct Output {
+    Output &operator <<(const String &str) {
+        fwrite(str.data(), 1, str.size(), stdout);
+        return *this;
+    }
+};
+
+int main(int argc, const char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <ELF file> [<binary trace file>]\n", argv[0]);
+        return 1;
+    }
+
+    // load the ELF file to look up the names
+    ElfFile elf;
+    if (!elf.load(argv[1])) {
+        fprintf(stderr, "error: can't load %s\n", argv[1]);
+        return 1;
+    }
+
+    // read the binary trace
+    FILE *input = argc >= 3 ? fopen(argv[2], "rb") : stdin;
+    if (input == nullptr) {
+        fprintf(stderr, "error: can't open %s\n", argv[2]);
+        return 1;
+    }
+    trace::detail::BinaryHeader header;
+    if (fread(&header, sizeof(header), 1, input) != 1 || std::memcmp(header.magic, "CTRC", 4) != 0
+        || header.version != 1 || header.pointerSize > 8)
+    {
+        fprintf(stderr, "error: invalid trace\n");
+        return 1;
+    }
+
+    // convert the events
+    Output s;
+    s << String("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    int eventSize = 4 + 1 + header.pointerSize;
+    std::vector<uint8_t> event(eventSize);
+    for (uint32_t i = 0; i < header.count && fread(event.data(), eventSize, 1, input) == 1; ++i) {
+        uint32_t time;
+        std::memcpy(&time, event.data(), 4);
+        auto type = trace::EventType(event[4]);
+        uint64_t data = 0;
+        std::memcpy(&data, event.data() + 5, header.pointerSize);
+        bool named = type == trace::EventType::BEGIN || type == trace::EventType::INSTANT;
+        trace::detail::writeJsonEvent(s, i == 0, time, type, data, named ? elf.string(data) : String());
+    }
+    s << String("\n]}\n");
+    return 0;
+}